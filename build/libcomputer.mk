@@ -37,6 +37,8 @@ LIBCOMPUTER_SOURCES = \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
 	$(SRC)/Computer/WaveComputer.cpp \
 	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/ThermalMapComputer.cpp \
+	$(SRC)/Computer/ThermalMap/ThermalMap.cpp \
 	$(SRC)/Computer/RouteComputer.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
 	$(SRC)/Computer/GlideComputerInterface.cpp \
@@ -1,6 +1,7 @@
 XML_SOURCES = \
 	$(SRC)/XML/Node.cpp \
-	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/Document.cpp \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp
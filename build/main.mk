@@ -183,6 +183,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/TaskStore.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
 	$(SRC)/Task/TypeStrings.cpp \
 	$(SRC)/Task/ValidationErrorStrings.cpp \
 	\
@@ -354,6 +355,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/TrackLineRenderer.cpp \
 	$(SRC)/Renderer/TrafficRenderer.cpp \
 	$(SRC)/Renderer/TrailRenderer.cpp \
+	$(SRC)/Renderer/TrailCache.cpp \
 	$(SRC)/Renderer/UnitSymbolRenderer.cpp \
 	$(SRC)/Renderer/WaypointListRenderer.cpp \
 	$(SRC)/Renderer/WaypointIconRenderer.cpp \
@@ -401,6 +403,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Markers/Markers.cpp \
 	\
 	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/FlightHistory.cpp \
 	$(SRC)/FlightInfo.cpp \
 	$(SRC)/Renderer/FlightStatisticsRenderer.cpp \
 	$(SRC)/Renderer/BarographRenderer.cpp \
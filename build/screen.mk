@@ -96,6 +96,7 @@ endif
 ifeq ($(FREETYPE),y)
 SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/freetype/Font.cpp \
+	$(CANVAS_SRC_DIR)/freetype/GlyphCache.cpp \
 	$(CANVAS_SRC_DIR)/freetype/Init.cpp
 endif
 
@@ -258,7 +259,6 @@ endif
 
 ifeq ($(USE_MEMORY_CANVAS),y)
 SCREEN_SOURCES += \
-	$(CANVAS_SRC_DIR)/custom/Cache.cpp \
 	$(CANVAS_SRC_DIR)/memory/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/memory/RawBitmap.cpp \
 	$(CANVAS_SRC_DIR)/memory/VirtualCanvas.cpp \
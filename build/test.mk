@@ -88,7 +88,10 @@ TEST_NAMES = \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
+	TestSnapshotBuffer \
+	TestVarioSynthesiser \
 	TestRadixTree TestGeoBounds TestGeoClip \
+	TestWaypointNameIndex \
 	TestLogger TestGRecord TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet TestFlarmMessaging \
@@ -96,6 +99,13 @@ TEST_NAMES = \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint TestTaskSave \
+	TestFlatObservationZone \
+	TestThermalMap \
+	TestTaskIndex \
+	TestFlightHistory \
+	TestLabelBlock \
+	TestTrafficList \
+	TestTrailCache \
 	TestTaskFileSeeYouParsing \
 	TestPlanes \
 	TestTaskPoint \
@@ -104,9 +114,13 @@ TEST_NAMES = \
 	TestZeroFinder \
 	TestAirspaceParser \
 	TestMETARParser \
+	TestXMLParser \
 	TestIGCParser \
+	TestIGCFixTable \
 	TestStrings TestUTF8 TestWrapText \
 	TestInputConfig \
+	TestInfoBoxInputs \
+	TestSkyLinesRate \
 	TestCRC16 TestCRC8 \
 	TestUnitsFormatter \
 	TestGeoPointFormatter \
@@ -124,7 +138,8 @@ TEST_NAMES = \
 	TestWeglideScoring \
 	TestNetCoupeScoring \
 	TestDMStScoring \
-	TestHttpsVerify
+	TestHttpsVerify \
+	TestResumableDownload
 
 ifeq ($(TARGET_IS_ANDROID),n)
 # These programs are broken on Android because they require Java code
@@ -184,6 +199,34 @@ TEST_IGC_PARSER_SOURCES = \
 TEST_IGC_PARSER_DEPENDS = MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
+TEST_IGC_FIX_TABLE_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixTable.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIGCFixTable.cpp
+TEST_IGC_FIX_TABLE_DEPENDS = IO OS TIME MATH UTIL
+$(eval $(call link-program,TestIGCFixTable,TEST_IGC_FIX_TABLE))
+
+TEST_INFOBOX_INPUTS_SOURCES = \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/InfoBoxes/Inputs.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestInfoBoxInputs.cpp
+TEST_INFOBOX_INPUTS_DEPENDS = LIBNMEA GEO MATH UTIL TIME
+$(eval $(call link-program,TestInfoBoxInputs,TEST_INFOBOX_INPUTS))
+
+TEST_SKYLINES_RATE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkyLinesRate.cpp
+TEST_SKYLINES_RATE_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestSkyLinesRate,TEST_SKYLINES_RATE))
+
+TEST_XML_PARSER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestXMLParser.cpp
+TEST_XML_PARSER_DEPENDS = XML
+$(eval $(call link-program,TestXMLParser,TEST_XML_PARSER))
+
 TEST_METAR_PARSER_SOURCES = \
 	$(SRC)/Weather/METARParser.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
@@ -264,6 +307,13 @@ TEST_ORDERED_TASK_OBJS = $(call SRC_TO_OBJ,$(TEST_ORDERED_TASK_SOURCES))
 TEST_ORDERED_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestOrderedTask,TEST_ORDERED_TASK))
 
+TEST_FLAT_OBSERVATION_ZONE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlatObservationZone.cpp
+TEST_FLAT_OBSERVATION_ZONE_OBJS = $(call SRC_TO_OBJ,$(TEST_FLAT_OBSERVATION_ZONE_SOURCES))
+TEST_FLAT_OBSERVATION_ZONE_DEPENDS = TASK GEO MATH UTIL
+$(eval $(call link-program,TestFlatObservationZone,TEST_FLAT_OBSERVATION_ZONE))
+
 TEST_AAT_POINT_SOURCES = \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
@@ -438,7 +488,7 @@ TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlarmNet.cpp
-TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
+TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL FMT
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
 TEST_FLARM_MESSAGING_SOURCES = \
@@ -467,9 +517,10 @@ $(eval $(call link-program,TestClimbAvCalc,TEST_CLIMB_AV_CALC))
 
 TEST_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestProjection.cpp
-TEST_PROJECTION_DEPENDS = MATH
+TEST_PROJECTION_DEPENDS = GEO MATH
 TEST_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,TestProjection,TEST_PROJECTION))
 
@@ -611,6 +662,27 @@ TEST_GLIDE_POLAR_SOURCES = \
 TEST_GLIDE_POLAR_DEPENDS = GEO MATH IO UNITS
 $(eval $(call link-program,TestGlidePolar,TEST_GLIDE_POLAR))
 
+TEST_THERMAL_MAP_SOURCES = \
+	$(SRC)/Computer/ThermalMap/ThermalMap.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThermalMap.cpp
+TEST_THERMAL_MAP_DEPENDS = IO OS GEO MATH UTIL FMT
+$(eval $(call link-program,TestThermalMap,TEST_THERMAL_MAP))
+
+TEST_TASK_INDEX_SOURCES = \
+	$(SRC)/Task/TaskIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskIndex.cpp
+TEST_TASK_INDEX_DEPENDS = IO OS UTIL FMT
+$(eval $(call link-program,TestTaskIndex,TEST_TASK_INDEX))
+
+TEST_FLIGHT_HISTORY_SOURCES = \
+	$(SRC)/FlightHistory.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlightHistory.cpp
+TEST_FLIGHT_HISTORY_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestFlightHistory,TEST_FLIGHT_HISTORY))
+
 TEST_FILE_UTIL_SOURCES = \
 	$(SRC)/system/FileUtil.cpp \
 	$(SRC)/system/Path.cpp \
@@ -649,6 +721,20 @@ TEST_FLAT_LINE_SOURCES = \
 TEST_FLAT_LINE_DEPENDS = GEO MATH
 $(eval $(call link-program,TestFlatLine,TEST_FLAT_LINE))
 
+TEST_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLabelBlock.cpp
+$(eval $(call link-program,TestLabelBlock,TEST_LABEL_BLOCK))
+
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = FMT
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
 TEST_THERMALBASE_SOURCES = \
 	$(SRC)/Computer/ThermalBase.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -694,12 +780,33 @@ TEST_ALLOCATED_GRID_SOURCES = \
 TEST_ALLOCATED_GRID_DEPENDS = UTIL
 $(eval $(call link-program,TestAllocatedGrid,TEST_ALLOCATED_GRID))
 
+TEST_SNAPSHOT_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSnapshotBuffer.cpp
+TEST_SNAPSHOT_BUFFER_DEPENDS = UTIL
+$(eval $(call link-program,TestSnapshotBuffer,TEST_SNAPSHOT_BUFFER))
+
+TEST_VARIO_SYNTHESISER_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(SRC)/Audio/LatencyProbe.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestVarioSynthesiser.cpp
+TEST_VARIO_SYNTHESISER_DEPENDS = MATH THREAD UTIL
+$(eval $(call link-program,TestVarioSynthesiser,TEST_VARIO_SYNTHESISER))
+
 TEST_RADIX_TREE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestRadixTree.cpp
 TEST_RADIX_TREE_DEPENDS = UTIL
 $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 
+TEST_WAYPOINT_NAME_INDEX_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointNameIndex.cpp
+TEST_WAYPOINT_NAME_INDEX_DEPENDS = WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,TestWaypointNameIndex,TEST_WAYPOINT_NAME_INDEX))
+
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
@@ -788,6 +895,15 @@ TEST_TRACE_SOURCES = \
 TEST_TRACE_DEPENDS = IO OS GEO MATH UTIL
 $(eval $(call link-program,TestTrace,TEST_TRACE))
 
+TEST_TRAIL_CACHE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Renderer/TrailCache.cpp \
+	$(TEST_SRC_DIR)/TestTrailCache.cpp
+TEST_TRAIL_CACHE_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTrailCache,TEST_TRAIL_CACHE))
+
 FLIGHT_TABLE_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/FlightTable.cpp
@@ -813,6 +929,7 @@ DEBUG_PROGRAM_NAMES = \
 	TestTrace \
 	FlightTable \
 	BenchmarkProjection \
+	BenchmarkNearestWaypoints \
 	BenchmarkFAITriangleSector \
 	DumpTextInflate \
 	DumpHexColor \
@@ -885,6 +1002,7 @@ endif
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
+	RunBatchReplay \
 	FeedFlyNetData
 endif
 
@@ -938,6 +1056,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/RadioFrequency.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixTable.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Formatter/NMEAFormatter.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceWarningConfig.cpp \
@@ -1261,6 +1380,17 @@ NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
 NEAREST_WAYPOINTS_DEPENDS = WAYPOINTFILE OPERATION IO OS THREAD ZZIP GEO MATH UTIL
 $(eval $(call link-program,NearestWaypoints,NEAREST_WAYPOINTS))
 
+BENCHMARK_NEAREST_WAYPOINTS_SOURCES = \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNearestWaypoints.cpp
+BENCHMARK_NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
+BENCHMARK_NEAREST_WAYPOINTS_DEPENDS = WAYPOINTFILE OPERATION IO OS THREAD ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkNearestWaypoints,BENCHMARK_NEAREST_WAYPOINTS))
+
 RUN_FLIGHT_PARSER_SOURCES = \
 	$(SRC)/Logger/FlightParser.cpp \
 	$(TEST_SRC_DIR)/RunFlightParser.cpp
@@ -1697,6 +1827,36 @@ ANALYSE_FLIGHT_SOURCES = \
 ANALYSE_FLIGHT_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST JSON UTIL GEO MATH TIME
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
+RUN_BATCH_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/FlightHistory.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/RunBatchReplay.cpp
+RUN_BATCH_REPLAY_DEPENDS = $(DEBUG_REPLAY_DEPENDS) \
+	LIBCOMPUTER LIBNMEA CONTEST TASKFILE ROUTE GLIDE \
+	WAYPOINT AIRSPACE JSON ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,RunBatchReplay,RUN_BATCH_REPLAY))
+$(call SRC_TO_OBJ,$(TEST_SRC_DIR)/RunBatchReplay.cpp): $(OUT)/include/InputEvents_Text2GCE.cpp
+
 FLIGHT_PATH_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/TransponderCode.cpp \
@@ -1794,6 +1954,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/TrackLineRenderer.cpp \
 	$(SRC)/Renderer/TrafficRenderer.cpp \
 	$(SRC)/Renderer/TrailRenderer.cpp \
+	$(SRC)/Renderer/TrailCache.cpp \
 	$(SRC)/Renderer/WaypointIconRenderer.cpp \
 	$(SRC)/Renderer/WaypointRenderer.cpp \
 	$(SRC)/Renderer/WaypointRendererSettings.cpp \
@@ -2197,6 +2358,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Renderer/OZRenderer.cpp \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/TrailRenderer.cpp \
+	$(SRC)/Renderer/TrailCache.cpp \
 	$(SRC)/MapWindow/MapCanvas.cpp \
 	$(SRC)/MapWindow/StencilMapCanvas.cpp \
 	$(SRC)/Units/Units.cpp \
@@ -2219,6 +2381,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionWindow.cpp \
 	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/FlightHistory.cpp \
 	$(SRC)/Renderer/AirspacePreviewRenderer.cpp \
 	$(SRC)/Renderer/FlightStatisticsRenderer.cpp \
 	$(SRC)/Renderer/BarographRenderer.cpp \
@@ -2501,7 +2664,7 @@ DUMP_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/DumpFlarmNet.cpp
-DUMP_FLARM_NET_DEPENDS = IO OS MATH UTIL
+DUMP_FLARM_NET_DEPENDS = IO OS MATH UTIL FMT
 $(eval $(call link-program,DumpFlarmNet,DUMP_FLARM_NET))
 
 IGC2NMEA_SOURCES = \
@@ -2562,3 +2725,10 @@ TEST_HTTPS_VERIFY_SOURCES = \
 	$(TEST_SRC_DIR)/TestHttpsVerify.cpp
 TEST_HTTPS_VERIFY_DEPENDS = LIBHTTP ASYNC LIBNET IO OS THREAD UTIL
 $(eval $(call link-program,TestHttpsVerify,TEST_HTTPS_VERIFY))
+
+TEST_RESUMABLE_DOWNLOAD_SOURCES = \
+	$(SRC)/Version.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestResumableDownload.cpp
+TEST_RESUMABLE_DOWNLOAD_DEPENDS = LIBHTTP ASYNC LIBNET OPERATION IO OS THREAD UTIL
+$(eval $(call link-program,TestResumableDownload,TEST_RESUMABLE_DOWNLOAD))
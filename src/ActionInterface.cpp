@@ -29,17 +29,19 @@ SendGetComputerSettings() noexcept;
 void
 XCSoarInterface::ReceiveGPS() noexcept
 {
+  auto &device_blackboard = *backend_components->device_blackboard;
+
   {
-    auto &device_blackboard = *backend_components->device_blackboard;
     const std::lock_guard lock{device_blackboard.mutex};
 
-    ReadBlackboardBasic(device_blackboard.Basic());
-
     const NMEAInfo &real = device_blackboard.RealState();
     Private::movement_detected = real.alive && real.gps.real &&
       real.MovementDetected();
   }
 
+  if (const auto basic = device_blackboard.basic_snapshot.Get())
+    ReadBlackboardBasic(*basic);
+
   BroadcastGPSUpdate();
 
   if (!Basic().flarm.traffic.IsEmpty())
@@ -50,14 +52,15 @@ XCSoarInterface::ReceiveGPS() noexcept
 void
 XCSoarInterface::ReceiveCalculated() noexcept
 {
+  auto &device_blackboard = *backend_components->device_blackboard;
+
   {
-    auto &device_blackboard = *backend_components->device_blackboard;
     const std::lock_guard lock{device_blackboard.mutex};
-
-    ReadBlackboardCalculated(device_blackboard.Calculated());
     device_blackboard.ReadComputerSettings(GetComputerSettings());
   }
 
+  ReadBlackboardCalculated(*device_blackboard.calculated_snapshot.Get());
+
   BroadcastCalculatedUpdate();
 }
 
@@ -295,9 +298,10 @@ ActionInterface::UpdateDisplayMode() noexcept
 void
 ActionInterface::SendUIState() noexcept
 {
-  /* force-update all InfoBoxes just in case the display mode has
-     changed */
-  InfoBoxManager::SetDirty();
+  /* update the InfoBoxes whose inputs have changed; a display mode
+     change switches to other InfoBox types, which are always
+     updated */
+  InfoBoxManager::ScheduleUpdate();
   InfoBoxManager::ProcessTimer();
 
   main_window->SetUIState(GetUIState());
@@ -372,7 +372,7 @@ PlaneProfileProcessTimer() noexcept
                                SetComputerSettings().polar.glide_polar_task);
         if (backend_components)
           backend_components->SetTaskPolar(GetComputerSettings().polar);
-        Profile::Save();
+        Profile::ScheduleSave();
 
         const char *reg = settings.glider_registration.c_str();
         const auto msg = fmt::vformat(
@@ -403,7 +403,7 @@ PlaneProfileProcessTimer() noexcept
           if (backend_components)
             backend_components->SetTaskPolar(GetComputerSettings().polar);
           Profile::SetPath("PlanePath", path);
-          Profile::Save();
+          Profile::ScheduleSave();
 
           const char *reg = settings.glider_registration.c_str();
           const auto msg = fmt::vformat(
@@ -17,6 +17,7 @@ namespace ALSAEnv
 
 static constexpr char ALSA_DEVICE_ENV[] = "ALSA_DEVICE";
 static constexpr char ALSA_LATENCY_ENV[] = "ALSA_LATENCY";
+static constexpr char ALSA_LATENCY_PROBE_ENV[] = "ALSA_LATENCY_PROBE";
 
 static constexpr char DEFAULT_ALSA_DEVICE[] = "default";
 static constexpr unsigned DEFAULT_ALSA_LATENCY = 100000;
@@ -65,4 +66,13 @@ unsigned GetALSALatency()
   return alsa_latency;
 }
 
+bool IsLatencyProbeEnabled()
+{
+  static const bool enabled = [](){
+    const char *value = getenv(ALSA_LATENCY_PROBE_ENV);
+    return value != nullptr && *value != '\0';
+  }();
+  return enabled;
+}
+
 }
@@ -29,4 +29,11 @@ namespace ALSAEnv
    * unsigned, or 10000 if not set, or unparsable. The unit is μs.
    */
   unsigned GetALSALatency();
+
+  /**
+   * Shall the vario latency be measured and logged (see
+   * #AudioLatencyProbe)?  This is enabled by setting the environment
+   * variable "ALSA_LATENCY_PROBE" to a non-empty value.
+   */
+  bool IsLatencyProbeEnabled();
 }
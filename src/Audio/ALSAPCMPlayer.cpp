@@ -3,6 +3,7 @@
 
 #include "ALSAPCMPlayer.hpp"
 #include "ALSAEnv.hpp"
+#include "LatencyProbe.hpp"
 #include "PCMDataSource.hpp"
 #include "util/Macros.hpp"
 #include "event/Call.hxx"
@@ -10,6 +11,8 @@
 
 #include <alsa/asoundlib.h>
 
+#include <algorithm>
+
 static void alsa_error_handler_stub(const char *, int, const char *,
                                     int, const char *, ...) {}
 
@@ -98,15 +101,54 @@ ALSAPCMPlayer::StopEventHandling()
   poll_events.clear();
 }
 
+void
+ALSAPCMPlayer::GrowQueue()
+{
+  const snd_pcm_uframes_t buffer_frames = buffer_size / channels;
+  if (target_queue >= buffer_frames)
+    return;
+
+  target_queue = std::min(target_queue + period_size, buffer_frames);
+  LogFormat("ALSA PCM queue grown to %u frames",
+            static_cast<unsigned>(target_queue));
+
+  SetSoftwareParameters(*alsa_handle, buffer_frames, period_size,
+                        target_queue);
+}
+
+void
+ALSAPCMPlayer::ReportLatency()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now < last_probe_report + std::chrono::seconds{10})
+    return;
+
+  last_probe_report = now;
+
+  const auto statistics = AudioLatencyProbe::ReadStatistics();
+  if (statistics.n == 0)
+    return;
+
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  LogFormat("Vario latency: average %u ms, maximum %u ms (%u changes)",
+            static_cast<unsigned>(duration_cast<milliseconds>(statistics.GetAverage()).count()),
+            static_cast<unsigned>(duration_cast<milliseconds>(statistics.max).count()),
+            statistics.n);
+}
+
 bool
 ALSAPCMPlayer::OnEvent()
 {
+  const snd_pcm_uframes_t buffer_frames = buffer_size / channels;
+
   snd_pcm_sframes_t n_available = snd_pcm_avail_update(alsa_handle.get());
   if (n_available < 0) {
     if (!TryRecoverFromError(static_cast<int>(n_available)))
       return false;
 
-    n_available = static_cast<snd_pcm_sframes_t>(buffer_size / channels);
+    GrowQueue();
+    n_available = static_cast<snd_pcm_sframes_t>(buffer_frames);
   }
 
   if (n_available < 0)
@@ -114,12 +156,28 @@ ALSAPCMPlayer::OnEvent()
   else if (0 == n_available)
     return true;
 
-  size_t n_read = FillPCMBuffer(buffer.get(),
-                                static_cast<size_t>(n_available));
-  if (!WriteFrames(static_cast<size_t>(n_available)))
+  /* fill only up to #target_queue, not the whole buffer */
+  const snd_pcm_uframes_t queued =
+    buffer_frames - std::min(static_cast<snd_pcm_uframes_t>(n_available),
+                             buffer_frames);
+  if (queued >= target_queue)
+    return true;
+
+  const size_t n = std::min(static_cast<size_t>(n_available),
+                            static_cast<size_t>(target_queue - queued));
+
+  if (AudioLatencyProbe::IsEnabled()) {
+    /* the new samples will be played after the queued ones */
+    AudioLatencyProbe::SetOutputDelay(std::chrono::microseconds{
+        uint64_t(queued) * 1000000 / sample_rate});
+    ReportLatency();
+  }
+
+  size_t n_read = FillPCMBuffer(buffer.get(), n);
+  if (!WriteFrames(n))
     return false;
 
-  return (n_read == static_cast<size_t>(n_available));
+  return n_read == n;
 }
 
 void
@@ -132,7 +190,8 @@ ALSAPCMPlayer::OnSocketReady(unsigned) noexcept
 bool
 ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
                              bool big_endian_source, unsigned latency,
-                             unsigned &channels) {
+                             unsigned &channels,
+                             snd_pcm_uframes_t &period_size) {
   /* adoption of alsa-libs's snd_pcm_set_params() function, which is not
    * available on SALSA, with a few detail enhancements. */
 
@@ -214,14 +273,14 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
     return false;
   }
 
-  snd_pcm_uframes_t buffer_size, period_size;
+  snd_pcm_uframes_t buffer_size;
 
   alsa_error = snd_pcm_hw_params_set_buffer_time_near(&alsa_handle,
                                                       hw_params,
                                                       &latency,
                                                       nullptr);
   if (0 != alsa_error) {
-    unsigned period_time = latency / 4;
+    unsigned period_time = latency / N_PERIODS;
     alsa_error = snd_pcm_hw_params_set_period_time_near(&alsa_handle,
                                                         hw_params,
                                                         &period_time,
@@ -250,7 +309,7 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
       return false;
     }
 
-    buffer_size = period_size * 4;
+    buffer_size = period_size * N_PERIODS;
     alsa_error = snd_pcm_hw_params_set_buffer_size_near(&alsa_handle,
                                                         hw_params,
                                                         &buffer_size);
@@ -300,7 +359,7 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
       return false;
     }
 
-    unsigned period_time = latency / 4;
+    unsigned period_time = latency / N_PERIODS;
     alsa_error = snd_pcm_hw_params_set_period_time_near(&alsa_handle,
                                                         hw_params,
                                                         &period_time,
@@ -340,10 +399,21 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
     return false;
   }
 
+  return true;
+}
+
+bool
+ALSAPCMPlayer::SetSoftwareParameters(snd_pcm_t &alsa_handle,
+                                     snd_pcm_uframes_t buffer_frames,
+                                     snd_pcm_uframes_t period_size,
+                                     snd_pcm_uframes_t target_queue)
+{
+  assert(target_queue <= buffer_frames);
+
   snd_pcm_sw_params_t *sw_params;
   snd_pcm_sw_params_alloca(&sw_params);
 
-  alsa_error = snd_pcm_sw_params_current(&alsa_handle, sw_params);
+  int alsa_error = snd_pcm_sw_params_current(&alsa_handle, sw_params);
   if (0 != alsa_error) {
     LogFormat("snd_pcm_sw_params_current(0x%p, 0x%p) failed: %d - %s",
               &alsa_handle,
@@ -353,8 +423,8 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
     return false;
   }
 
-  snd_pcm_uframes_t  start_threshold =
-      (buffer_size / period_size) * period_size;
+  /* start playing as soon as the queue is filled */
+  const snd_pcm_uframes_t start_threshold = target_queue;
   alsa_error = snd_pcm_sw_params_set_start_threshold(&alsa_handle,
                                                      sw_params,
                                                      start_threshold);
@@ -369,14 +439,17 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
     return false;
   }
 
+  /* wake up when one period of #target_queue has been played */
+  const snd_pcm_uframes_t avail_min =
+    buffer_frames - target_queue + std::min(period_size, target_queue);
   alsa_error = snd_pcm_sw_params_set_avail_min(&alsa_handle,
                                                sw_params,
-                                               period_size);
+                                               avail_min);
   if (0 != alsa_error) {
     LogFormat("snd_pcm_sw_params_set_avail_min(0x%p, 0x%p, %u) failed: %d - %s",
               &alsa_handle,
               sw_params,
-              static_cast<unsigned>(period_size),
+              static_cast<unsigned>(avail_min),
               alsa_error,
               snd_strerror(alsa_error));
     return false;
@@ -430,7 +503,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
         source = &_source;
 
         if (recovered_from_underrun) {
-          const size_t n = buffer_size / channels;
+          const size_t n = target_queue;
           const size_t n_read = FillPCMBuffer(buffer.get(), n);
           if (!WriteFrames(n_read)) {
             success = false;
@@ -496,7 +569,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   channels = 1;
   bool big_endian_source = _source.IsBigEndian();
   if (!SetParameters(*new_alsa_handle, new_sample_rate, big_endian_source,
-                     latency, channels))
+                     latency, channels, period_size))
     return false;
 
   snd_pcm_sframes_t n_available = snd_pcm_avail(new_alsa_handle.get());
@@ -511,6 +584,18 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   buffer_size = static_cast<snd_pcm_uframes_t>(n_available * channels);
   buffer = std::unique_ptr<int16_t[]>(new int16_t[buffer_size]);
 
+  target_queue = std::min(INITIAL_QUEUE_PERIODS * period_size,
+                          static_cast<snd_pcm_uframes_t>(n_available));
+  if (!SetSoftwareParameters(*new_alsa_handle,
+                             static_cast<snd_pcm_uframes_t>(n_available),
+                             period_size, target_queue))
+    return false;
+
+  sample_rate = new_sample_rate;
+
+  if (ALSAEnv::IsLatencyProbeEnabled())
+    AudioLatencyProbe::Enable();
+
   int poll_fds_count = snd_pcm_poll_descriptors_count(new_alsa_handle.get());
   if (poll_fds_count < 1) {
     LogFormat("snd_pcm_poll_descriptors_count(0x%p) returned %d",
@@ -532,7 +617,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   const int n_poll_fds = (poll_ret < poll_fds_count) ? poll_ret : poll_fds_count;
 
   source = &_source;
-  size_t n_read = FillPCMBuffer(buffer.get(), static_cast<size_t>(n_available));
+  size_t n_read = FillPCMBuffer(buffer.get(), target_queue);
 
   if (0 == n_read) {
     LogFormat("ALSA PCMPlayer started with data source which "
@@ -540,8 +625,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
     return false;
   }
 
-  if (!WriteFrames(*new_alsa_handle, buffer.get(),
-                   static_cast<size_t>(n_available), false))
+  if (!WriteFrames(*new_alsa_handle, buffer.get(), target_queue, false))
     return false;
 
   alsa_handle = std::move(new_alsa_handle);
@@ -8,6 +8,7 @@
 #include "util/Compiler.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <forward_list>
@@ -33,11 +34,38 @@ class ALSAPCMPlayer : public PCMPlayer {
 
   AlsaHandleUniquePtr alsa_handle = MakeAlsaHandleUniquePtr();
 
+  /**
+   * The number of periods in the ALSA buffer.
+   */
+  static constexpr unsigned N_PERIODS = 8;
+
+  /**
+   * The initial value of #target_queue [periods].
+   */
+  static constexpr unsigned INITIAL_QUEUE_PERIODS = 2;
+
   EventLoop &event_loop;
 
   snd_pcm_uframes_t buffer_size;
   std::unique_ptr<int16_t[]> buffer;
 
+  snd_pcm_uframes_t period_size;
+
+  /**
+   * The number of frames which are kept queued in the ALSA buffer.
+   * This is smaller than the buffer, so changes of the source (e.g. a
+   * new vario tone) become audible sooner.  It grows by one period
+   * after each buffer underrun.
+   */
+  snd_pcm_uframes_t target_queue;
+
+  unsigned sample_rate;
+
+  /**
+   * When were the #AudioLatencyProbe statistics logged last?
+   */
+  std::chrono::steady_clock::time_point last_probe_report;
+
   std::forward_list<SocketEvent> poll_events;
 
   void StopEventHandling();
@@ -58,9 +86,28 @@ class ALSAPCMPlayer : public PCMPlayer {
 
   bool OnEvent();
 
+  /**
+   * Keep more frames queued after a buffer underrun.
+   */
+  void GrowQueue();
+
+  /**
+   * Log the #AudioLatencyProbe statistics every few seconds.
+   */
+  void ReportLatency();
+
   static bool SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
                             bool big_endian_source, unsigned latency,
-                            unsigned &channels);
+                            unsigned &channels,
+                            snd_pcm_uframes_t &period_size);
+
+  /**
+   * Configure the software parameters for the given #target_queue.
+   */
+  static bool SetSoftwareParameters(snd_pcm_t &alsa_handle,
+                                    snd_pcm_uframes_t buffer_frames,
+                                    snd_pcm_uframes_t period_size,
+                                    snd_pcm_uframes_t target_queue);
 
 public:
   explicit ALSAPCMPlayer(EventLoop &event_loop) noexcept;
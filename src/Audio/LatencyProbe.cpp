@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "LatencyProbe.hpp"
+#include "thread/Mutex.hxx"
+
+#include <atomic>
+#include <utility>
+
+namespace AudioLatencyProbe {
+
+static std::atomic_bool enabled{false};
+
+/**
+ * The #Duration::rep of the most recent sensor line.  Written by the
+ * device I/O thread (OnSensorLine()), read by the merge thread when it
+ * posts new vario parameters (GetSensorTime()).
+ */
+static std::atomic<Duration::rep> sensor_time{0};
+
+/**
+ * The #Duration::rep of the last SetOutputDelay() call.
+ */
+static std::atomic<Duration::rep> output_delay{0};
+
+/**
+ * Protects #statistics.  They are written by OnApplied() from the
+ * audio callback, which renders the vario tone.  They are read by
+ * ReadStatistics() from the PCM player's periodic report, which may run
+ * on a different thread.
+ */
+static Mutex statistics_mutex;
+static Statistics statistics;
+
+void
+Enable() noexcept
+{
+  enabled.store(true, std::memory_order_relaxed);
+}
+
+bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void
+OnSensorLine() noexcept
+{
+  if (IsEnabled())
+    sensor_time.store(Clock::now().time_since_epoch().count(),
+                      std::memory_order_relaxed);
+}
+
+Duration
+GetSensorTime() noexcept
+{
+  return Duration{sensor_time.load(std::memory_order_relaxed)};
+}
+
+void
+SetOutputDelay(Duration delay) noexcept
+{
+  output_delay.store(delay.count(), std::memory_order_relaxed);
+}
+
+void
+OnApplied(Duration _sensor_time) noexcept
+{
+  if (!IsEnabled() || _sensor_time == Duration{})
+    return;
+
+  const Duration latency = Clock::now().time_since_epoch() - _sensor_time +
+    Duration{output_delay.load(std::memory_order_relaxed)};
+
+  const std::lock_guard lock{statistics_mutex};
+  ++statistics.n;
+  statistics.sum += latency;
+  if (latency > statistics.max)
+    statistics.max = latency;
+}
+
+Statistics
+ReadStatistics() noexcept
+{
+  const std::lock_guard lock{statistics_mutex};
+  return std::exchange(statistics, Statistics{});
+}
+
+} // namespace AudioLatencyProbe
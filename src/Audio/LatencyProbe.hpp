@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <chrono>
+
+/**
+ * An instrumentation mode which measures the latency from the
+ * reception of a sensor line to the moment the vario tone derived
+ * from it leaves the speaker.  It is disabled by default; the ALSA
+ * player enables it if the environment variable "ALSA_LATENCY_PROBE"
+ * is set, and logs the statistics periodically.
+ *
+ * All time stamps are std::chrono::steady_clock durations since its
+ * epoch.
+ */
+namespace AudioLatencyProbe {
+
+using Clock = std::chrono::steady_clock;
+using Duration = Clock::duration;
+
+struct Statistics {
+  unsigned n = 0;
+  Duration sum{}, max{};
+
+  Duration GetAverage() const noexcept {
+    return n > 0 ? sum / n : Duration{};
+  }
+};
+
+void
+Enable() noexcept;
+
+bool
+IsEnabled() noexcept;
+
+/**
+ * Called by #DeviceDispatcher for each line received from a sensor.
+ */
+void
+OnSensorLine() noexcept;
+
+/**
+ * Returns the reception time of the most recent sensor line, or zero
+ * if the probe is disabled.
+ */
+Duration
+GetSensorTime() noexcept;
+
+/**
+ * Called by the audio output before it asks for more samples: the
+ * time until the first of them will be played.
+ */
+void
+SetOutputDelay(Duration delay) noexcept;
+
+/**
+ * Called by the synthesiser when it starts playing parameters derived
+ * from the sensor line received at the given time.
+ */
+void
+OnApplied(Duration sensor_time) noexcept;
+
+/**
+ * Return the statistics collected since the last call and reset them.
+ */
+Statistics
+ReadStatistics() noexcept;
+
+} // namespace AudioLatencyProbe
@@ -4,33 +4,57 @@
 #include "ToneSynthesiser.hpp"
 #include "Math/FastTrig.hpp"
 
-#include <cassert>
+#include <algorithm>
+#include <bit>
+
+/**
+ * Shift a phase right by this number of bits to get an index into
+ * #ISINETABLE.
+ */
+static constexpr unsigned PHASE_SHIFT =
+  32 - std::countr_zero(INT_ANGLE_RANGE);
+
+static_assert(std::has_single_bit(INT_ANGLE_RANGE));
 
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
-  increment = ISINETABLE.size() * tone_hz / sample_rate;
+  target_increment = (uint64_t(tone_hz) << 32) / sample_rate;
+
+  if (increment == 0) {
+    /* no tone yet: start immediately */
+    increment = target_increment;
+    glide_remaining = 0;
+    return;
+  }
+
+  glide_remaining = std::max(sample_rate * GLIDE_MS / 1000, 1u);
+  glide_step = (int64_t(target_increment) - int64_t(increment))
+    / int64_t(glide_remaining);
 }
 
 void
 ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  assert(angle < ISINETABLE.size());
-
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ISINETABLE.size() - 1);
+    if (glide_remaining > 0) {
+      if (--glide_remaining == 0)
+        increment = target_increment;
+      else
+        increment += glide_step;
+    }
+
+    *buffer = ISINETABLE[phase >> PHASE_SHIFT] * (32767 / 1024) * (int)volume / 100;
+    phase += increment;
   }
 }
 
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ISINETABLE.size());
-
-  if (angle < increment)
+  if (phase < increment || increment == 0)
     /* close enough */
     return 0;
 
-  return (ISINETABLE.size() - angle) / increment;
+  return ((uint64_t(1) << 32) - phase) / increment;
 }
@@ -5,11 +5,45 @@
 
 #include "PCMSynthesiser.hpp"
 
+#include <cstdint>
+
 /**
  * This class generates tones with a sine wave.
+ *
+ * The phase is a 32 bit fixed-point accumulator, which gives a
+ * frequency resolution far below 1 Hz.  Frequency changes glide
+ * linearly over #GLIDE_MS, sample by sample, instead of jumping at
+ * buffer boundaries.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume = 100, angle = 0, increment = 0;
+  /**
+   * The duration of a frequency change.
+   */
+  static constexpr unsigned GLIDE_MS = 10;
+
+  unsigned volume = 100;
+
+  /**
+   * The phase of the next sample; 2^32 is one full sine wave.
+   */
+  uint32_t phase = 0;
+
+  /**
+   * The phase increment per sample, i.e. the current frequency.
+   */
+  uint32_t increment = 0;
+
+  /**
+   * The phase increment requested by SetTone().
+   */
+  uint32_t target_increment = 0;
+
+  /**
+   * While gliding towards #target_increment: the change of
+   * #increment per sample and the number of remaining glide samples.
+   */
+  int32_t glide_step = 0;
+  unsigned glide_remaining = 0;
 
 public:
   explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
@@ -29,6 +63,10 @@ public:
     volume = _volume;
   }
 
+  /**
+   * Change the frequency.  If a tone is already playing, the
+   * frequency glides to the new value.
+   */
   void SetTone(unsigned tone_hz);
 
   /* methods from class PCMSynthesiser */
@@ -48,6 +86,6 @@ protected:
    * Start a new period.
    */
   void Restart() {
-    angle = 0;
+    phase = 0;
   }
 };
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "VarioSynthesiser.hpp"
+#include "LatencyProbe.hpp"
 #include "Math/FastMath.hpp"
 
 #include <algorithm>
@@ -22,20 +23,27 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 }
 
 void
-VarioSynthesiser::SetVario(double vario)
+VarioSynthesiser::Post(const Parameters &parameters) noexcept
 {
-  const std::lock_guard lock{mutex};
+  if (AudioLatencyProbe::IsEnabled())
+    mailbox_sensor_time.store(AudioLatencyProbe::GetSensorTime().count(),
+                              std::memory_order_relaxed);
+
+  mailbox.store(parameters.Pack(), std::memory_order_release);
+}
 
+void
+VarioSynthesiser::SetVario(double vario)
+{
   const int ivario = std::clamp((int)(vario * 100), min_vario, max_vario);
 
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    SetSilence();
     return;
   }
 
-  /* update the ToneSynthesiser base class */
-  SetTone(VarioToFrequency(ivario));
+  const unsigned frequency = VarioToFrequency(ivario);
 
   if (ivario > 0) {
     /* while climbing, the vario sound gets interrupted by silence
@@ -46,51 +54,69 @@ VarioSynthesiser::SetVario(double vario)
          * (max_period_ms - min_period_ms) / max_vario)
       / 1000;
 
-    silence_count = period_ms / 3;
-    audible_count = period_ms - silence_count;
-
-    /* preserve the old "_remaining" values as much as possible, to
-       avoid chopping off the previous tone */
-
-    if (audible_remaining > audible_count)
-      audible_remaining = audible_count;
-
-    if (silence_remaining > silence_count)
-      silence_remaining = silence_count;
+    const unsigned silence_count = period_ms / 3;
+    Post({frequency, period_ms - silence_count, silence_count});
   } else {
     /* continuous tone while sinking */
-    audible_count = 1;
-    silence_count = 0;
+    Post({frequency, 1, 0});
   }
 }
 
 void
 VarioSynthesiser::SetSilence()
 {
-  const std::lock_guard lock{mutex};
-  UnsafeSetSilence();
+  Post({0, 0, 1});
 }
 
 void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ReceiveParameters() noexcept
 {
-  audible_count = 0;
-  silence_count = 1;
+  const uint64_t packed = mailbox.load(std::memory_order_acquire);
+  if (packed == applied)
+    return;
 
-  if (audible_remaining > 0)
-    /* quit the current period as early as possible; the method
-       Synthesise() will take care for finishing the current sine
-       wave to avoid clicking noise */
-    audible_remaining = 1;
+  applied = packed;
 
-  silence_remaining = 0;
-}
+  if (AudioLatencyProbe::IsEnabled())
+    AudioLatencyProbe::OnApplied(AudioLatencyProbe::Duration{
+        mailbox_sensor_time.load(std::memory_order_relaxed)});
 
+  const auto parameters = Parameters::Unpack(packed);
+  audible_count = parameters.audible_count;
+  silence_count = parameters.silence_count;
+
+  if (audible_count == 0) {
+    /* silence */
+
+    if (audible_remaining > 0)
+      /* quit the current period as early as possible; the method
+         Synthesise() will take care for finishing the current sine
+         wave to avoid clicking noise */
+      audible_remaining = 1;
+
+    silence_remaining = 0;
+    return;
+  }
+
+  /* update the ToneSynthesiser base class */
+  SetTone(parameters.frequency);
+
+  if (silence_count > 0) {
+    /* preserve the old "_remaining" values as much as possible, to
+       avoid chopping off the previous tone */
+
+    if (audible_remaining > audible_count)
+      audible_remaining = audible_count;
+
+    if (silence_remaining > silence_count)
+      silence_remaining = silence_count;
+  }
+}
 
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard lock{mutex};
+  ReceiveParameters();
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -4,17 +4,72 @@
 #pragma once
 
 #include "ToneSynthesiser.hpp"
-#include "thread/Mutex.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
 /**
  * This class generates vario sound.
+ *
+ * SetVario() and SetSilence() calculate the tone parameters and post
+ * them to a lock-free mailbox; Synthesise() (running in the audio
+ * thread) picks them up at the beginning of the next buffer.  The two
+ * threads never block each other.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * The tone parameters posted by the producer.
    */
-  Mutex mutex;
+  struct Parameters {
+    unsigned frequency;
+
+    /**
+     * The number of audible samples in each period.  Zero means
+     * silence.
+     */
+    unsigned audible_count;
+
+    /**
+     * The number of silent samples in each period.  If this is zero,
+     * then no silence will be generated (continuous tone).
+     */
+    unsigned silence_count;
+
+    static constexpr Parameters Unpack(uint64_t packed) noexcept {
+      return {
+        unsigned(packed >> 48),
+        unsigned(packed >> 24) & 0xffffff,
+        unsigned(packed) & 0xffffff,
+      };
+    }
+
+    constexpr uint64_t Pack() const noexcept {
+      return (uint64_t(frequency & 0xffff) << 48) |
+        (uint64_t(audible_count & 0xffffff) << 24) |
+        uint64_t(silence_count & 0xffffff);
+    }
+  };
+
+  /**
+   * The latest Parameters::Pack() value.  Written by the producer,
+   * read by Synthesise().
+   */
+  std::atomic<uint64_t> mailbox{Parameters{0, 0, 1}.Pack()};
+
+  /**
+   * The AudioLatencyProbe::GetSensorTime() value belonging to
+   * #mailbox (only used by the latency probe).
+   */
+  std::atomic<std::chrono::steady_clock::rep> mailbox_sensor_time{0};
+
+  /**
+   * The #mailbox value currently being played.  Only accessed by
+   * Synthesise().
+   */
+  uint64_t applied = Parameters{0, 0, 1}.Pack();
+
+  /* the following attributes are only accessed by Synthesise() */
 
   /**
    * The number of audible samples in each period.
@@ -34,6 +89,8 @@ class VarioSynthesiser final : public ToneSynthesiser {
    */
   size_t audible_remaining, silence_remaining;
 
+  /* the following settings are only accessed by the producer */
+
   bool dead_band_enabled;
 
   /**
@@ -79,7 +136,8 @@ public:
 
   /**
    * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * a new "silence" rate (for positive vario values).  This method
+   * does not block.
    *
    * @param vario the current vario value [m/s]
    */
@@ -126,10 +184,12 @@ public:
   virtual void Synthesise(int16_t *buffer, size_t n);
 
 private:
+  void Post(const Parameters &parameters) noexcept;
+
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply new parameters from the #mailbox, if any.
    */
-  void UnsafeSetSilence();
+  void ReceiveParameters() noexcept;
 
   /**
    * Convert a vario value to a tone frequency.
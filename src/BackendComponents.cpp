@@ -6,6 +6,7 @@
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "Computer/ThermalMap/ThermalMap.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
 #include "Logger/GlueFlightLogger.hpp"
@@ -15,6 +15,7 @@ class MergeThread;
 class ProtectedTaskManager;
 class ProtectedAirspaceWarningManager;
 class GlideComputer;
+class ThermalMap;
 class CalculationThread;
 class Replay;
 
@@ -34,6 +35,13 @@ struct BackendComponents {
 
   std::unique_ptr<ProtectedTaskManager> protected_task_manager;
   std::unique_ptr<GlideComputer> glide_computer;
+
+  /**
+   * The climbs of all flights; owned by the #CalculationThread
+   * while it runs.
+   */
+  std::unique_ptr<ThermalMap> thermal_map;
+
   std::unique_ptr<CalculationThread> calculation_thread;
 
   std::unique_ptr<Replay> replay;
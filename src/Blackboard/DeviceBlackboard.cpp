@@ -15,7 +15,10 @@ DeviceBlackboard::DeviceBlackboard() noexcept
 {
   // Clear the gps_info and calculated_info
   gps_info.Reset();
+
+  DerivedInfo calculated_info;
   calculated_info.Reset();
+  calculated_snapshot.Publish(calculated_info);
 
   // Set GPS assumed time to system time
   gps_info.UpdateClock();
@@ -43,11 +46,11 @@ void
 DeviceBlackboard::SetStartupLocation(const GeoPoint &loc,
                                      const double alt) noexcept
 {
-  const std::lock_guard lock{mutex};
-
-  if (Calculated().flight.flying)
+  if (calculated_snapshot.Get()->flight.flying)
     return;
 
+  const std::lock_guard lock{mutex};
+
   for (auto &i : per_device_data)
     if (!i.location_available)
       i.SetFakeLocation(loc, alt);
@@ -3,11 +3,13 @@
 
 #pragma once
 
-#include "Blackboard/BaseBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
+#include "thread/SnapshotBuffer.hpp"
 #include "time/WrapClock.hpp"
 
 #include <array>
@@ -22,14 +24,22 @@ class RadioFrequency;
  * 
  * The DeviceBlackboard is used as the global ground truth-state
  * since it is accessed quickly with only one mutex
+ *
+ * Other threads should not copy Basic() while holding the mutex;
+ * they obtain the merged data from #basic_snapshot and the
+ * #GlideComputer results from #calculated_snapshot instead.
  */
-class DeviceBlackboard
-  : public BaseBlackboard, public ComputerSettingsBlackboard
+class DeviceBlackboard : public ComputerSettingsBlackboard
 {
   friend class MergeThread;
 
   Simulator simulator;
 
+  /**
+   * The merged data.  Protected by #mutex.
+   */
+  MoreData gps_info;
+
   /**
    * Data from each physical device.
    */
@@ -58,17 +68,26 @@ class DeviceBlackboard
 public:
   Mutex mutex;
 
+  /**
+   * A copy of Basic(), published by the #MergeThread after each
+   * merge.
+   */
+  SnapshotBuffer<MoreData> basic_snapshot;
+
+  /**
+   * The latest results of the #GlideComputer, published by the
+   * #CalculationThread.  Never empty.
+   */
+  SnapshotBuffer<DerivedInfo> calculated_snapshot;
+
 public:
   DeviceBlackboard() noexcept;
 
   /**
-   * Reads the given derived_info usually provided by the
-   * GlideComputerBlackboard and saves it to the own Blackboard
-   * @param derived_info Calculated information usually provided
-   * by the GlideComputerBlackboard
+   * Caller must lock the blackboard.
    */
-  void ReadBlackboard(const DerivedInfo &derived_info) noexcept {
-    calculated_info = derived_info;
+  constexpr const MoreData &Basic() const noexcept {
+    return gps_info;
   }
 
   /**
@@ -59,16 +59,15 @@ CalculationThread::Tick() noexcept
   const ScopeLockCPU cpu;
 #endif
 
-  bool gps_updated;
+  bool gps_updated = false;
 
   // update and transfer master info to glide computer
-  {
-    const std::lock_guard lock{device_blackboard.mutex};
-
-    gps_updated = device_blackboard.Basic().location_available.Modified(glide_computer.Basic().location_available);
+  if (const auto basic =
+      device_blackboard.basic_snapshot.GetModified(basic_serial)) {
+    gps_updated = basic->location_available.Modified(glide_computer.Basic().location_available);
 
     // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard.Basic());
+    glide_computer.ReadBlackboard(*basic);
   }
 
   bool force;
@@ -86,7 +85,7 @@ CalculationThread::Tick() noexcept
 
   glide_computer.Expire();
 
-  bool do_idle = false;
+  bool do_idle = idle_pending;
 
   if (gps_updated || force)
     // perform idle call if time advanced and slow calculations need to be updated
@@ -95,10 +94,7 @@ CalculationThread::Tick() noexcept
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
-  {
-    const std::lock_guard lock{device_blackboard.mutex};
-    device_blackboard.ReadBlackboard(glide_computer.Calculated());
-  }
+  device_blackboard.calculated_snapshot.Publish(glide_computer.Calculated());
 
   // if (new GPS data)
   if (gps_updated || force)
@@ -106,8 +102,16 @@ CalculationThread::Tick() noexcept
     TriggerCalculatedUpdate();
 
   if (do_idle) {
-    // do slow calculations last, to minimise latency
-    glide_computer.ProcessIdle();
+    if (!idle_pending && IsTriggered()) {
+      /* new data has arrived meanwhile: process it first and postpone
+         the slow calculations to the next Tick() (only once, to avoid
+         starving them) */
+      idle_pending = true;
+    } else {
+      // do slow calculations last, to minimise latency
+      idle_pending = false;
+      glide_computer.ProcessIdle();
+    }
   }
 }
 
@@ -6,6 +6,7 @@
 #include "thread/WorkerThread.hpp"
 #include "thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "util/Serial.hpp"
 
 class DeviceBlackboard;
 class GlideComputer;
@@ -29,6 +30,12 @@ class CalculationThread final : public WorkerThread {
    */
   bool force;
 
+  /**
+   * Have the slow calculations been postponed by the previous Tick()?
+   * Only accessed by the thread itself.
+   */
+  bool idle_pending = false;
+
   ComputerSettings settings_computer;
 
   double screen_distance_meters;
@@ -38,6 +45,12 @@ class CalculationThread final : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * The DeviceBlackboard::basic_snapshot version which was last
+   * copied to #glide_computer.
+   */
+  Serial basic_serial;
+
 public:
   CalculationThread(DeviceBlackboard &_device_blackboard,
                     GlideComputer &_glide_computer) noexcept;
@@ -7,7 +7,8 @@
 
 /**
  * A composite of "more" #ConditionMonitor implementations to be
- * called by GlideComputer::ProcessIdle().
+ * called by GlideComputer::ProcessGPS() after the airspace warnings
+ * have been updated.
  *
  * @see ConditionMonitors
  */
@@ -9,8 +9,6 @@
 
 using namespace std::chrono;
 
-static PeriodClock last_team_code_update;
-
 GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              const Waypoints &_way_points,
                              Airspaces &_airspace_database,
@@ -19,7 +17,7 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
   :air_data_computer(_way_points),
    warning_computer(_settings.airspace.warnings, _airspace_database),
    task_computer(task, _airspace_database, &warning_computer.GetManager()),
-   idle_condition_monitors(warning_computer.GetManager()),
+   airspace_condition_monitors(warning_computer.GetManager()),
    waypoints(_way_points),
    retrospective(_way_points),
    team_code_ref_id(-1)
@@ -41,6 +39,7 @@ GlideComputer::ResetFlight(const bool full)
 
   cu_computer.Reset();
   warning_computer.Reset();
+  thermal_map_computer.Reset();
 
   trace_history_time.Reset();
 }
@@ -113,6 +112,7 @@ GlideComputer::ProcessGPS(bool force)
                                     settings);
 
   stats_computer.ProcessClimbEvents(calculated);
+  thermal_map_computer.Compute(basic, calculated);
 
   cu_computer.Compute(basic, calculated, settings);
 
@@ -138,6 +138,14 @@ GlideComputer::ProcessGPS(bool force)
   // Update the ConditionMonitors
   condition_monitors.Update(Basic(), Calculated(), settings);
 
+  /* airspace warnings are safety-critical: update them with each fix
+     instead of waiting for the slow idle calculations (they are
+     rate-limited by WarningComputer) */
+  warning_computer.Update(settings, basic,
+                          calculated, calculated.airspace_warnings);
+
+  airspace_condition_monitors.Update(basic, calculated, settings);
+
   return idle_clock.CheckUpdate(milliseconds(500));
 }
 
@@ -152,17 +160,13 @@ GlideComputer::ProcessIdle(bool exhaustive)
   stats_computer.DoLogging(basic, calculated);
   log_computer.Run(basic, calculated, GetComputerSettings().logger);
 
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
-
-  idle_condition_monitors.Update(basic, calculated, GetComputerSettings());
-
   // Calculate summary of flight
   if (basic.location_available)
     retrospective.UpdateSample(basic.location);
+
+  // the most expensive part (contest optimisation) comes last
+  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
+                            exhaustive);
 }
 
 bool
@@ -193,7 +197,7 @@ GlideComputer::CalculateOwnTeamCode()
     return;
 
   // Only calculate every 10sec otherwise cancel calculation
-  if (!last_team_code_update.CheckUpdate(seconds(10)))
+  if (!team_code_clock.CheckUpdate(seconds(10)))
     return;
 
   // Get bearing and distance to the reference waypoint
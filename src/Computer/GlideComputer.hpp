@@ -12,6 +12,7 @@
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "ThermalMapComputer.hpp"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "ConditionMonitor/MoreConditionMonitors.hpp"
@@ -33,9 +34,10 @@ class GlideComputer : public GlideComputerBlackboard
   StatsComputer stats_computer;
   LogComputer log_computer;
   CuComputer cu_computer;
+  ThermalMapComputer thermal_map_computer;
 
   ConditionMonitors condition_monitors;
-  MoreConditionMonitors idle_condition_monitors;
+  MoreConditionMonitors airspace_condition_monitors;
 
   const Waypoints &waypoints;
 
@@ -44,6 +46,11 @@ class GlideComputer : public GlideComputerBlackboard
   bool team_code_ref_found;
   GeoPoint team_code_ref_location;
 
+  /**
+   * Throttles the calculation of the own team code.
+   */
+  PeriodClock team_code_clock;
+
   PeriodClock idle_clock;
 
   /**
@@ -65,6 +72,14 @@ public:
     log_computer.SetLogger(logger);
   }
 
+  /**
+   * Set the #ThermalMap which receives all completed climbs.  While
+   * it is set, it is owned by the calculation thread.
+   */
+  void SetThermalMap(ThermalMap *thermal_map) noexcept {
+    thermal_map_computer.SetThermalMap(thermal_map);
+  }
+
   /**
    * Resets the GlideComputer data
    * @param full Reset all data?
@@ -82,14 +97,17 @@ public:
 
   /**
    * Is called by the CalculationThread and processes the received GPS
-   * data in Basic().
+   * data in Basic().  This includes the airspace warnings, which must
+   * not wait for ProcessIdle().
    *
    * @param force forces calculation even if there was no new GPS fix
    */
   bool ProcessGPS(bool force=false); // returns true if idle needs processing
 
   /**
-   * Process slow calculations. Called by the CalculationThread.
+   * Process slow calculations (logging, contest optimisation). Called
+   * by the CalculationThread; it may be postponed when new GPS data is
+   * pending.
    */
   void ProcessIdle(bool exhaustive=false);
 
@@ -30,6 +30,11 @@ class GlideRatioCalculator {
    */
   unsigned short size;
 
+  /**
+   * Number of consecutive implausible distances passed to Add().
+   */
+  unsigned short errs;
+
   bool valid;
 
 public:
@@ -63,6 +63,14 @@ StatsComputer::DoLogging(const MoreData &basic,
                              calculated.turn_mode == CirclingMode::CLIMB);
   }
 
+  if (calculated.flight.flying && basic.NavAltitudeAvailable() &&
+      history_clock.CheckAdvance(basic.time, HISTORY_PERIOD))
+    flightstats.AddHistorySample(calculated.flight.flight_time,
+                                 basic.nav_altitude,
+                                 basic.brutto_vario,
+                                 basic.ground_speed,
+                                 basic.location);
+
   return true;
 }
 
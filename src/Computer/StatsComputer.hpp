@@ -14,6 +14,7 @@ struct DerivedInfo;
 
 class StatsComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::minutes(1);
+  static constexpr std::chrono::steady_clock::duration HISTORY_PERIOD = std::chrono::seconds(1);
 
   GeoPoint last_location;
 
@@ -22,6 +23,7 @@ class StatsComputer {
 
   FlightStatistics flightstats;
   GPSClock stats_clock;
+  GPSClock history_clock;
 
 public:
   /** Returns the FlightStatistics object */
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/PackedLittleEndian.hxx"
+
+#include <cstdint>
+
+/**
+ * One climb stored in the #ThermalMap.  This is the on-disk format
+ * of the thermal map file; all integers are little-endian and the
+ * struct has no padding, so a file can be mapped into memory and
+ * used directly.
+ */
+struct ThermalMapRecord {
+  /**
+   * Latitude plus 90 degrees, in micro degrees.
+   */
+  PackedLE32 latitude;
+
+  /**
+   * Longitude plus 180 degrees, in micro degrees.
+   */
+  PackedLE32 longitude;
+
+  /**
+   * UTC time of day when the climb started, in minutes.
+   */
+  PackedLE16 time_of_day;
+
+  /**
+   * Altitude at the top of the climb [m].
+   */
+  PackedLE16 top_altitude;
+
+  /**
+   * The wind during the climb; the direction in 1/256 of a full
+   * circle, the speed in 1/4 m/s.
+   */
+  uint8_t wind_direction, wind_speed;
+
+  /**
+   * Average climb rate [cm/s].
+   */
+  PackedLE16 lift;
+
+  static constexpr unsigned MICRO_DEGREES = 1000000;
+
+  /**
+   * The size of one cell of the spatial index, in micro degrees.
+   * The records in a file are sorted by cell.
+   */
+  static constexpr unsigned CELL_SIZE = MICRO_DEGREES / 64;
+
+  /**
+   * The number of cells in one row of the spatial index.
+   */
+  static constexpr unsigned CELL_COLUMNS = 360 * MICRO_DEGREES / CELL_SIZE;
+
+  static constexpr uint32_t MakeCellKey(uint32_t row,
+                                        uint32_t column) noexcept {
+    return row * CELL_COLUMNS + column;
+  }
+
+  constexpr uint32_t GetCellKey() const noexcept {
+    return MakeCellKey(uint32_t(latitude) / CELL_SIZE,
+                       uint32_t(longitude) / CELL_SIZE);
+  }
+};
+
+static_assert(sizeof(ThermalMapRecord) == 16, "Wrong size");
+static_assert(alignof(ThermalMapRecord) == 1, "Wrong alignment");
+
+/**
+ * The header of a thermal map file, followed by
+ * ThermalMapFileHeader::n_records instances of #ThermalMapRecord
+ * sorted by ThermalMapRecord::GetCellKey().
+ */
+struct ThermalMapFileHeader {
+  static constexpr uint32_t MAGIC = 0x50414d54; // "TMAP"
+  static constexpr uint32_t VERSION = 1;
+
+  PackedLE32 magic;
+  PackedLE32 version;
+  PackedLE32 n_records;
+  PackedLE32 reserved;
+};
+
+static_assert(sizeof(ThermalMapFileHeader) == 16, "Wrong size");
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ThermalMap.hpp"
+#include "Geo/FAISphere.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "lib/fmt/PathFormatter.hpp"
+#include "lib/fmt/RuntimeError.hxx"
+#include "system/Path.hpp"
+
+#include <cmath>
+#include <iterator>
+
+static constexpr std::chrono::minutes DAY = std::chrono::hours{24};
+
+[[gnu::pure]]
+static auto
+CompareCellKey(const ThermalMapRecord &a, const ThermalMapRecord &b) noexcept
+{
+  return a.GetCellKey() < b.GetCellKey();
+}
+
+bool
+ThermalMap::Filter::Match(const ThermalMapRecord &record) const noexcept
+{
+  if (time_window.count() >= 0) {
+    auto delta = GetTimeOfDay(record) - time_of_day;
+    if (delta < delta.zero())
+      delta = -delta;
+    if (delta > DAY / 2)
+      delta = DAY - delta;
+
+    if (delta > time_window)
+      return false;
+  }
+
+  if (max_wind_difference >= 0) {
+    const SpeedVector record_wind = GetWind(record);
+    const double dx = record_wind.norm * record_wind.bearing.sin() -
+      wind.norm * wind.bearing.sin();
+    const double dy = record_wind.norm * record_wind.bearing.cos() -
+      wind.norm * wind.bearing.cos();
+
+    if (dx * dx + dy * dy > max_wind_difference * max_wind_difference)
+      return false;
+  }
+
+  return true;
+}
+
+ThermalMap::ThermalMap() noexcept = default;
+ThermalMap::~ThermalMap() noexcept = default;
+
+void
+ThermalMap::Clear() noexcept
+{
+  stored = {};
+  mapping.reset();
+  added.clear();
+}
+
+ThermalMapRecord
+ThermalMap::MakeRecord(const GeoPoint &location,
+                       std::chrono::minutes time_of_day,
+                       double top_altitude,
+                       SpeedVector wind, double lift) noexcept
+{
+  constexpr double MICRO = ThermalMapRecord::MICRO_DEGREES;
+
+  time_of_day %= DAY;
+  if (time_of_day < time_of_day.zero())
+    time_of_day += DAY;
+
+  ThermalMapRecord record;
+  record.latitude = std::lround((location.latitude.Degrees() + 90) * MICRO);
+  record.longitude = std::lround((location.longitude.AsDelta().Degrees() + 180)
+                                 * MICRO) % (360 * ThermalMapRecord::MICRO_DEGREES);
+  record.time_of_day = time_of_day.count();
+  record.top_altitude = std::clamp(std::lround(top_altitude), 0l, 0xffffl);
+  record.wind_direction = std::lround(wind.bearing.AsBearing().Native()
+                                      * 256 / Angle::FullCircle().Native()) & 0xff;
+  record.wind_speed = std::clamp(std::lround(wind.norm * 4), 0l, 0xffl);
+  record.lift = std::clamp(std::lround(lift * 100), 0l, 0xffffl);
+  return record;
+}
+
+void
+ThermalMap::Add(const GeoPoint &location, std::chrono::minutes time_of_day,
+                double top_altitude, SpeedVector wind, double lift) noexcept
+{
+  const auto record = MakeRecord(location, time_of_day,
+                                 top_altitude, wind, lift);
+  added.insert(std::upper_bound(added.begin(), added.end(), record,
+                                CompareCellKey),
+               record);
+}
+
+GeoPoint
+ThermalMap::GetLocation(const ThermalMapRecord &record) noexcept
+{
+  constexpr double MICRO = ThermalMapRecord::MICRO_DEGREES;
+
+  return {
+    Angle::Degrees(uint32_t(record.longitude) / MICRO - 180),
+    Angle::Degrees(uint32_t(record.latitude) / MICRO - 90),
+  };
+}
+
+SpeedVector
+ThermalMap::GetWind(const ThermalMapRecord &record) noexcept
+{
+  return {
+    Angle::FullCircle() * (record.wind_direction / 256.),
+    record.wind_speed / 4.,
+  };
+}
+
+GeoPoint
+ThermalMap::GetRangeBox(const GeoPoint &location, double range) noexcept
+{
+  const Angle latitude = FAISphere::EarthDistanceToAngle(range);
+
+  const double cos_latitude = location.latitude.cos();
+  const Angle longitude = cos_latitude > latitude.sin()
+    ? Angle::asin(std::min(latitude.sin() / cos_latitude, 1.))
+    : Angle::HalfCircle();
+
+  /* add one cell of slack for rounding */
+  const Angle slack =
+    Angle::Degrees(double(ThermalMapRecord::CELL_SIZE) /
+                   ThermalMapRecord::MICRO_DEGREES);
+
+  return {longitude + slack, latitude + slack};
+}
+
+void
+ThermalMap::Load(Path path)
+{
+  auto new_mapping = std::make_unique<FileMapping>(path);
+  const std::span<const std::byte> raw = *new_mapping;
+
+  if (raw.size() < sizeof(ThermalMapFileHeader))
+    throw FmtRuntimeError("Malformed thermal map file: {}", path);
+
+  const auto &header =
+    *reinterpret_cast<const ThermalMapFileHeader *>(raw.data());
+  if (header.magic != ThermalMapFileHeader::MAGIC ||
+      header.version != ThermalMapFileHeader::VERSION)
+    throw FmtRuntimeError("Unsupported thermal map file: {}", path);
+
+  const std::size_t n_records = header.n_records;
+  if (n_records > (raw.size() - sizeof(header)) / sizeof(ThermalMapRecord) ||
+      raw.size() != sizeof(header) + n_records * sizeof(ThermalMapRecord))
+    throw FmtRuntimeError("Malformed thermal map file: {}", path);
+
+  const std::span<const ThermalMapRecord> records{
+    reinterpret_cast<const ThermalMapRecord *>(raw.data() + sizeof(header)),
+    n_records,
+  };
+
+  if (!std::is_sorted(records.begin(), records.end(), CompareCellKey))
+    throw FmtRuntimeError("Unsorted thermal map file: {}", path);
+
+  Clear();
+  mapping = std::move(new_mapping);
+  stored = records;
+}
+
+void
+ThermalMap::Save(Path path) const
+{
+  FileOutputStream file(path);
+  BufferedOutputStream out(file);
+
+  /* merge the two sorted lists; std::merge() is stable, so within a
+     cell, the older records come first */
+  std::vector<ThermalMapRecord> records;
+  records.reserve(size());
+  std::merge(stored.begin(), stored.end(), added.begin(), added.end(),
+             std::back_inserter(records), CompareCellKey);
+
+  /* keep only the newest records of each cell */
+  auto dest = records.begin();
+  for (auto i = records.begin(); i != records.end();) {
+    const uint32_t key = i->GetCellKey();
+    const auto end = std::find_if(i, records.end(),
+                                  [key](const ThermalMapRecord &r){
+                                    return r.GetCellKey() != key;
+                                  });
+    if (std::size_t(end - i) > MAX_RECORDS_PER_CELL)
+      i = end - MAX_RECORDS_PER_CELL;
+
+    dest = std::copy(i, end, dest);
+    i = end;
+  }
+
+  records.erase(dest, records.end());
+
+  ThermalMapFileHeader header;
+  header.magic = ThermalMapFileHeader::MAGIC;
+  header.version = ThermalMapFileHeader::VERSION;
+  header.n_records = records.size();
+  header.reserved = 0;
+  out.WriteT(header);
+
+  for (const auto &i : records)
+    out.WriteT(i);
+
+  out.Flush();
+  file.Commit();
+}
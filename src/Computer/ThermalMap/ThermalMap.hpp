@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Record.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/SpeedVector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <span>
+#include <vector>
+
+class Path;
+class FileMapping;
+
+/**
+ * A persistent store of climbs from all flights, which answers the
+ * question "where are thermals usually here?".
+ *
+ * The records are sorted by a grid cell key (see
+ * ThermalMapRecord::GetCellKey()), so a range query needs only one
+ * binary search per grid row covered by the range.  Records loaded
+ * from a file stay in the memory-mapped file; climbs added during
+ * this session are kept in a separate sorted vector until Save()
+ * merges them.
+ *
+ * This class is not thread-safe.
+ */
+class ThermalMap {
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * The records loaded from the file, sorted by cell key.
+   */
+  std::span<const ThermalMapRecord> stored;
+
+  /**
+   * The records added since the file was loaded, sorted by cell
+   * key.
+   */
+  std::vector<ThermalMapRecord> added;
+
+public:
+  /**
+   * Save() keeps at most this many records per grid cell, dropping
+   * the oldest ones.  This limits the file size, and old climbs
+   * give way to newer observations.
+   */
+  static constexpr std::size_t MAX_RECORDS_PER_CELL = 32;
+
+  /**
+   * Parameters for filtering query results.
+   */
+  struct Filter {
+    /**
+     * The UTC time of day to compare with.
+     */
+    std::chrono::minutes time_of_day{};
+
+    /**
+     * Accept only climbs within this many minutes of
+     * #time_of_day.  Negative means any time of day.
+     */
+    std::chrono::minutes time_window{-1};
+
+    /**
+     * The current wind to compare with.
+     */
+    SpeedVector wind = SpeedVector::Zero();
+
+    /**
+     * Accept only climbs where the magnitude of the difference
+     * between the recorded wind vector and #wind is at most this
+     * value [m/s].  Negative means any wind.
+     */
+    double max_wind_difference = -1;
+
+    [[gnu::pure]]
+    bool Match(const ThermalMapRecord &record) const noexcept;
+  };
+
+  ThermalMap() noexcept;
+  ~ThermalMap() noexcept;
+
+  ThermalMap(const ThermalMap &) = delete;
+  ThermalMap &operator=(const ThermalMap &) = delete;
+
+  bool empty() const noexcept {
+    return stored.empty() && added.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return stored.size() + added.size();
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Add a climb.
+   *
+   * @param location the location where the climb started
+   * @param time_of_day the UTC time of day when the climb started
+   * @param top_altitude the altitude at the top of the climb [m]
+   * @param wind the wind during the climb
+   * @param lift the average climb rate [m/s]
+   */
+  void Add(const GeoPoint &location, std::chrono::minutes time_of_day,
+           double top_altitude, SpeedVector wind, double lift) noexcept;
+
+  /**
+   * Invoke the visitor for each record within the given range which
+   * matches the filter.
+   *
+   * @param visitor a callable receiving a `const ThermalMapRecord &`
+   */
+  template<typename V>
+  void VisitWithinRange(const GeoPoint &location, double range,
+                        const Filter &filter, V &&visitor) const {
+    const GeoPoint range_box = GetRangeBox(location, range);
+
+    ForEachCellRange(location, range_box, [&](uint32_t first, uint32_t last){
+      for (const auto records : {stored, std::span<const ThermalMapRecord>{added}})
+        for (auto i = LowerBound(records, first);
+             i != records.end() && i->GetCellKey() <= last; ++i)
+          if (filter.Match(*i) &&
+              GetLocation(*i).DistanceS(location) <= range)
+            visitor(*i);
+    });
+  }
+
+  [[gnu::const]]
+  static GeoPoint GetLocation(const ThermalMapRecord &record) noexcept;
+
+  [[gnu::const]]
+  static SpeedVector GetWind(const ThermalMapRecord &record) noexcept;
+
+  static constexpr double GetLift(const ThermalMapRecord &record) noexcept {
+    return uint16_t(record.lift) / 100.;
+  }
+
+  static constexpr std::chrono::minutes
+  GetTimeOfDay(const ThermalMapRecord &record) noexcept {
+    return std::chrono::minutes{uint16_t(record.time_of_day)};
+  }
+
+  /**
+   * Replace the contents with the given file.  Throws on error.
+   */
+  void Load(Path path);
+
+  /**
+   * Write all records to the given file, subject to
+   * #MAX_RECORDS_PER_CELL.  Throws on error.
+   */
+  void Save(Path path) const;
+
+private:
+  [[gnu::const]]
+  static ThermalMapRecord MakeRecord(const GeoPoint &location,
+                                     std::chrono::minutes time_of_day,
+                                     double top_altitude,
+                                     SpeedVector wind, double lift) noexcept;
+
+  /**
+   * Returns the latitude/longitude half-extent of a range around
+   * the given location.
+   */
+  [[gnu::const]]
+  static GeoPoint GetRangeBox(const GeoPoint &location,
+                              double range) noexcept;
+
+  static auto LowerBound(std::span<const ThermalMapRecord> records,
+                         uint32_t key) noexcept {
+    return std::partition_point(records.begin(), records.end(),
+                                [key](const ThermalMapRecord &r){
+                                  return r.GetCellKey() < key;
+                                });
+  }
+
+  /**
+   * Invoke the function with the first and last cell key of each
+   * contiguous range of cells covering the given box.
+   */
+  template<typename F>
+  static void ForEachCellRange(const GeoPoint &center,
+                               const GeoPoint &half_extent, F &&f) {
+    constexpr int64_t MICRO = ThermalMapRecord::MICRO_DEGREES;
+    constexpr int64_t CELL = ThermalMapRecord::CELL_SIZE;
+    constexpr int64_t COLUMNS = ThermalMapRecord::CELL_COLUMNS;
+    constexpr int64_t ROWS = 180 * MICRO / CELL + 1;
+
+    const int64_t lat = (center.latitude.Degrees() + 90) * MICRO;
+    const int64_t lon = (center.longitude.Degrees() + 180) * MICRO;
+    const int64_t dlat = half_extent.latitude.Degrees() * MICRO;
+    const int64_t dlon = half_extent.longitude.Degrees() * MICRO;
+
+    const int64_t first_row = std::max<int64_t>((lat - dlat) / CELL, 0);
+    const int64_t last_row = std::min<int64_t>((lat + dlat) / CELL, ROWS - 1);
+
+    int64_t first_column = (lon - dlon) / CELL;
+    int64_t last_column = (lon + dlon) / CELL;
+    if (lon - dlon < 0)
+      --first_column;
+    if (last_column - first_column + 1 >= COLUMNS) {
+      first_column = 0;
+      last_column = COLUMNS - 1;
+    }
+
+    for (int64_t row = first_row; row <= last_row; ++row) {
+      if (first_column < 0) {
+        /* wrap around the antimeridian */
+        f(ThermalMapRecord::MakeCellKey(row, COLUMNS + first_column),
+          ThermalMapRecord::MakeCellKey(row, COLUMNS - 1));
+        f(ThermalMapRecord::MakeCellKey(row, 0),
+          ThermalMapRecord::MakeCellKey(row, last_column));
+      } else if (last_column >= COLUMNS) {
+        f(ThermalMapRecord::MakeCellKey(row, first_column),
+          ThermalMapRecord::MakeCellKey(row, COLUMNS - 1));
+        f(ThermalMapRecord::MakeCellKey(row, 0),
+          ThermalMapRecord::MakeCellKey(row, last_column - COLUMNS));
+      } else
+        f(ThermalMapRecord::MakeCellKey(row, first_column),
+          ThermalMapRecord::MakeCellKey(row, last_column));
+    }
+  }
+};
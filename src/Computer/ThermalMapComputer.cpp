@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ThermalMapComputer.hpp"
+#include "ThermalMap/ThermalMap.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono;
+
+/**
+ * Look up climbs within this range around the aircraft [m].
+ */
+static constexpr double HOTSPOT_RANGE = 20000;
+
+/**
+ * Repeat the lookup after this period, or when the aircraft has
+ * moved by this distance [m].
+ */
+static constexpr seconds HOTSPOT_QUERY_INTERVAL = minutes{1};
+static constexpr double HOTSPOT_QUERY_DISTANCE = 2000;
+
+void
+ThermalMapComputer::Compute(const MoreData &basic,
+                            DerivedInfo &calculated) noexcept
+{
+  if (thermal_map == nullptr)
+    return;
+
+  AddClimb(basic, calculated);
+  FindHotspots(basic, calculated, calculated.thermal_map);
+}
+
+inline void
+ThermalMapComputer::AddClimb(const MoreData &basic,
+                             const DerivedInfo &calculated) noexcept
+{
+  const OneClimbInfo &thermal = calculated.last_thermal;
+  if (!thermal.IsDefined()) {
+    last_thermal_end_time = TimeStamp::Undefined();
+    return;
+  }
+
+  if (last_thermal_end_time.IsDefined() &&
+      thermal.end_time <= last_thermal_end_time)
+    /* not a new climb */
+    return;
+
+  last_thermal_end_time = thermal.end_time;
+
+  /* climbs in the simulator are made up, and replayed ones have
+     been recorded already when the flight was live */
+  if (basic.gps.simulator || basic.gps.replay ||
+      !calculated.climb_start_location.IsValid())
+    return;
+
+  const auto time_of_day = duration_cast<minutes>
+    (thermal.start_time.ToDuration());
+
+  thermal_map->Add(calculated.climb_start_location, time_of_day,
+                   thermal.start_altitude + thermal.gain,
+                   calculated.GetWindOrZero(),
+                   thermal.lift_rate);
+
+  /* let the new climb show up */
+  query_clock.Reset();
+}
+
+inline void
+ThermalMapComputer::FindHotspots(const MoreData &basic,
+                                 const DerivedInfo &calculated,
+                                 ThermalMapInfo &info) noexcept
+{
+  if (!basic.location_available || !basic.time_available) {
+    info.Clear();
+    return;
+  }
+
+  if (query_location.IsValid() &&
+      query_location.DistanceS(basic.location) < HOTSPOT_QUERY_DISTANCE &&
+      !query_clock.CheckAdvance(basic.time, HOTSPOT_QUERY_INTERVAL))
+    return;
+
+  query_clock.Update(basic.time);
+  query_location = basic.location;
+
+  ThermalMap::Filter filter;
+  filter.time_of_day = duration_cast<minutes>(basic.time.ToDuration());
+  filter.time_window = hours{1};
+  if (calculated.wind_available) {
+    filter.wind = calculated.wind;
+    filter.max_wind_difference = 4;
+  }
+
+  /* keep the climbs with the best lift */
+  auto &hotspots = info.hotspots;
+  hotspots.clear();
+  thermal_map->VisitWithinRange(basic.location, HOTSPOT_RANGE, filter,
+                                [&hotspots](const ThermalMapRecord &r){
+    const double lift = ThermalMap::GetLift(r);
+
+    if (hotspots.full()) {
+      auto weakest = std::min_element(hotspots.begin(), hotspots.end(),
+                                      [](const auto &a, const auto &b){
+                                        return a.lift < b.lift;
+                                      });
+      if (weakest->lift >= lift)
+        return;
+
+      *weakest = {ThermalMap::GetLocation(r), lift};
+    } else
+      hotspots.push_back({ThermalMap::GetLocation(r), lift});
+  });
+}
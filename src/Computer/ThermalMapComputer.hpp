@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "time/GPSClock.hpp"
+#include "time/Stamp.hpp"
+
+struct MoreData;
+struct DerivedInfo;
+struct ThermalMapInfo;
+class ThermalMap;
+
+/**
+ * This computer adds each completed climb to the #ThermalMap, and
+ * looks up the best climbs from earlier flights around the aircraft
+ * (see DerivedInfo::thermal_map).
+ *
+ * Dependencies: #GlideComputerAirData.
+ */
+class ThermalMapComputer {
+  ThermalMap *thermal_map = nullptr;
+
+  TimeStamp last_thermal_end_time = TimeStamp::Undefined();
+
+  /**
+   * Limits the rate of #ThermalMap queries.
+   */
+  GPSClock query_clock;
+
+  /**
+   * The aircraft location at the last #ThermalMap query.
+   */
+  GeoPoint query_location = GeoPoint::Invalid();
+
+public:
+  /**
+   * Set the #ThermalMap which receives the climbs.  It must only be
+   * accessed from the calculation thread while it is set.
+   */
+  void SetThermalMap(ThermalMap *_thermal_map) noexcept {
+    thermal_map = _thermal_map;
+  }
+
+  void Reset() noexcept {
+    last_thermal_end_time = TimeStamp::Undefined();
+    query_clock.Reset();
+    query_location = GeoPoint::Invalid();
+  }
+
+  void Compute(const MoreData &basic, DerivedInfo &calculated) noexcept;
+
+private:
+  void AddClimb(const MoreData &basic,
+                const DerivedInfo &calculated) noexcept;
+
+  void FindHotspots(const MoreData &basic, const DerivedInfo &calculated,
+                    ThermalMapInfo &info) noexcept;
+};
@@ -217,6 +217,7 @@ CirclingWind::Result CirclingWind::CalcWind(double quality_metric,
                                             Angle circle,
                                             char angular_rate_source) noexcept {
   assert(n_samples > 1);
+  assert(n_samples <= MAX_SAMPLES);
   assert(!samples.empty());
 
   // reject if average time step greater than 2.0 seconds
@@ -269,6 +270,22 @@ CirclingWind::Result CirclingWind::CalcWind(double quality_metric,
     // limit to reasonable values (30 m/s), reject otherwise
     return Result(0);
 
+  /* prepare the samples for the iterative search; this doesn't
+     depend on the probed phase */
+  FitSample fit[MAX_SAMPLES];
+  for (size_t i = 0; i < n_samples; i++) {
+    double net_speed_diff = samples[i].ground_speed - samples[i].tas -
+      speed_offset;
+    /* to make the fit metric (somewhat) independent of the amplitude
+     * wind speeds less than 1 m/s are not interesting anyways
+     */
+    if (wind_speed > 1.0)
+      net_speed_diff /= wind_speed;
+
+    fit[i].track = samples[i].track.Radians();
+    fit[i].speed_diff = net_speed_diff;
+  }
+
   // determine bearing of the wind & prepare for the iterative search
   Angle wind_bearing = Angle::Zero();
   Angle search_midpoint = Angle::HalfCircle();
@@ -295,7 +312,7 @@ CirclingWind::Result CirclingWind::CalcWind(double quality_metric,
         search_midpoint - (search_step_width * ((double)search_steps / 2.0));
 
     for (int s = 0; s <= search_steps; s++) {
-      fit_metric = FitCosine(n_samples, wind_speed, speed_offset, probe_point);
+      fit_metric = FitCosine(fit, n_samples, probe_point);
       if (fit_metric < min_fit_metric) {
         min_fit_metric = fit_metric;
         search_midpoint = probe_point;
@@ -366,22 +383,17 @@ unsigned int CirclingWind::EstimateQuality(double circle_quality,
   return quality;
 }
 
-double CirclingWind::FitCosine(size_t n_samples, double amplitude,
-                               double offset, Angle phase) noexcept {
+double CirclingWind::FitCosine(const FitSample *fit, size_t n_samples,
+                               Angle phase) noexcept {
   /* fit the measured speed data to an inverse cosine
    * uses the "sum of squares" algorithm
    */
   double sum_of_squares_of_deltas = 0;
 
   for (size_t i = 0; i < n_samples; i++) {
-    const double a = (samples[i].track - phase).AsBearing().Radians();
-    double net_speed_diff = samples[i].ground_speed - samples[i].tas - offset;
-    /* to make the fit metric (somewhat) independent of the amplitude
-     * wind speeds less than 1 m/s are not interesting anyways
-     */
-    if (amplitude > 1.0)
-      net_speed_diff /= amplitude;
-    sum_of_squares_of_deltas += Square(-fastcosine(a) - net_speed_diff);
+    const double a =
+        (Angle::Radians(fit[i].track) - phase).AsBearing().Radians();
+    sum_of_squares_of_deltas += Square(-fastcosine(a) - fit[i].speed_diff);
   }
   /* tighter circles getting a smaller result, that is intended.
    * Because wider circles tend to be search circles, hence not so round
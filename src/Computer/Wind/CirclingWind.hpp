@@ -50,7 +50,9 @@ class CirclingWind {
 
   Angle last_track = Angle::Zero();
 
-  boost::circular_buffer<Sample> samples{80};
+  static constexpr std::size_t MAX_SAMPLES = 80;
+
+  boost::circular_buffer<Sample> samples{MAX_SAMPLES};
 
 public:
   struct Result {
@@ -91,9 +93,22 @@ private:
   Result CalcWind(double quality_metric, size_t n_samples,
                   Angle circle, char angular_rate_source) noexcept;
 
+  /**
+   * One sample of the circle being fitted, prepared once per
+   * CalcWind() call so the iterative search in FitCosine() only
+   * needs to walk a contiguous array.
+   */
+  struct FitSample {
+    /** the track in radians */
+    double track;
+
+    /** the normalised speed difference to be fitted */
+    double speed_diff;
+  };
+
   [[gnu::pure]]
-  double FitCosine(size_t n_samples, double amplitude,
-                   double offset, Angle phase) noexcept;
+  static double FitCosine(const FitSample *fit, size_t n_samples,
+                          Angle phase) noexcept;
 
   void ShowResources(const MoreData &info) noexcept;
 };
@@ -95,5 +95,5 @@ DataGlobals::UpdateHome(bool reset) noexcept
                          CommonInterface::GetComputerSettings().poi,
                          CommonInterface::GetComputerSettings().team_code);
 
-  Profile::Save();
+  Profile::ScheduleSave();
 }
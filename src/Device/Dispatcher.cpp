@@ -4,10 +4,19 @@
 #include "Dispatcher.hpp"
 #include "Descriptor.hpp"
 #include "MultipleDevices.hpp"
+#include "Audio/Features.hpp"
+
+#ifdef HAVE_PCM_PLAYER
+#include "Audio/LatencyProbe.hpp"
+#endif
 
 bool
 DeviceDispatcher::LineReceived(const char *line) noexcept
 {
+#ifdef HAVE_PCM_PLAYER
+  AudioLatencyProbe::OnSensorLine();
+#endif
+
   unsigned i = 0;
   for (DeviceDescriptor *device : devices) {
     if (i++ == exclude)
@@ -252,14 +252,11 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock, RangeFilter
 
   FlarmTraffic *flarm_slot = flarm.FindTraffic(traffic.id);
   if (flarm_slot == nullptr) {
-    flarm_slot = flarm.AllocateTraffic();
+    flarm_slot = flarm.AllocateTraffic(traffic.id);
     if (flarm_slot == nullptr)
       // no more slots available
       return;
 
-    flarm_slot->Clear();
-    flarm_slot->id = traffic.id;
-
     flarm.new_traffic.Update(clock);
   }
 
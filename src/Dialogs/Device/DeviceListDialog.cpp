@@ -520,7 +520,7 @@ DeviceListWidget::EnableDisableCurrent()
 
   config.enabled = !config.enabled;
   Profile::SetDeviceConfig(Profile::map, index, config);
-  Profile::Save();
+  Profile::ScheduleSave();
 
   /* update the UI */
 
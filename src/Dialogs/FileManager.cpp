@@ -81,6 +81,16 @@ UpdateAvailable(const FileRepository &repository, const char *name)
 
   return local_changed < remote_changed;
 }
+
+/**
+ * Returns the SHA-256 digest to be verified by the download manager,
+ * or nullptr if the repository does not specify one.
+ */
+static const std::array<std::byte, 32> *
+GetHash(const AvailableFile &file) noexcept
+{
+  return file.HasHash() ? &file.sha256_hash : nullptr;
+}
 #endif
 
 class ManagedFileListWidget
@@ -497,7 +507,8 @@ ManagedFileListWidget::Download()
   if (base.empty())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.uri.c_str(), base);
+  Net::DownloadManager::Enqueue(remote_file.uri.c_str(), base,
+                                GetHash(remote_file));
 #endif
 }
 
@@ -589,7 +600,8 @@ ManagedFileListWidget::Add()
   if (base.empty())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.GetURI(), base);
+  Net::DownloadManager::Enqueue(remote_file.GetURI(), base,
+                                GetHash(remote_file));
 #endif
 }
 
@@ -607,7 +619,8 @@ ManagedFileListWidget::UpdateFiles() {
         if (base.empty())
           return;
 
-        Net::DownloadManager::Enqueue(remote_file->GetURI(), base);
+        Net::DownloadManager::Enqueue(remote_file->GetURI(), base,
+                                      GetHash(*remote_file));
       }
     }
   }
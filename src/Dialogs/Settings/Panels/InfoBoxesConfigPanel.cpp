@@ -44,7 +44,7 @@ InfoBoxesConfigPanel::OnAction(int id) noexcept
                                 i >= InfoBoxSettings::PREASSIGNED_PANELS);
   if (changed) {
     Profile::Save(Profile::map, data, i);
-    Profile::Save();
+    Profile::ScheduleSave();
     ((Button &)GetRow(i)).SetCaption(gettext(data.name));
   }
 }
@@ -347,7 +347,7 @@ void dlgConfigurationShowModal()
   current_page = menu.GetCursor();
 
   if (dialog.GetChanged()) {
-    Profile::Save();
+    Profile::ScheduleSave();
     if (require_restart)
       ShowMessageBox(_("Changes to configuration saved.  Restart XCSoar to apply changes."),
                   "", MB_OK);
@@ -13,7 +13,9 @@
 #include "Widget/ButtonPanelWidget.hpp"
 #include "Widget/TwoWidgets.hpp"
 #include "Task/TaskStore.hpp"
+#include "Task/TypeStrings.hpp"
 #include "Task/ValidationErrorStrings.hpp"
+#include "Formatter/UserUnits.hpp"
 #include "LocalPath.hpp"
 #include "system/FileUtil.hpp"
 #include "Language/Language.hpp"
@@ -157,7 +159,18 @@ TaskListPanel::OnPaintItem(Canvas &canvas, const PixelRect rc,
 {
   assert(DrawListIndex <= task_store.Size());
 
-  row_renderer.DrawTextRow(canvas, rc, task_store.GetName(DrawListIndex));
+  PixelRect text_rc = rc;
+
+  /* show type and distance of tasks which have been loaded before,
+     without loading them again */
+  if (const auto *summary = task_store.GetSummary(DrawListIndex)) {
+    StaticString<64> buffer;
+    buffer.Format("%s %s", OrderedTaskFactoryName(summary->type),
+                  FormatUserDistanceSmart(summary->distance).c_str());
+    text_rc.right = row_renderer.DrawRightColumn(canvas, rc, buffer);
+  }
+
+  row_renderer.DrawTextRow(canvas, text_rc, task_store.GetName(DrawListIndex));
 }
 
 void
@@ -368,10 +368,10 @@ TrafficListWidget::UpdateList()
     /* if no filter was set, show a list of current traffic and known
        traffic */
 
-    /* add live FLARM traffic */
-    for (const auto &i : CommonInterface::Basic().flarm.traffic.list) {
+    /* add live FLARM traffic, nearest first */
+    CommonInterface::Basic().flarm.traffic.ForEachByDistance([this](const FlarmTraffic &i){
       AddItem(i.id);
-    }
+    });
 
     /* add FLARM peers that have a user-defined color */
     for (const auto &i : traffic_databases->flarm_colors) {
@@ -114,6 +114,11 @@ class WaypointListWidget final
 
   WaypointList items;
 
+  /**
+   * Caches the name matches while the pilot is typing.
+   */
+  WaypointNameSearch name_search;
+
   TwoTextRowsRenderer row_renderer;
 
   const GeoPoint location;
@@ -130,6 +135,7 @@ public:
                      unsigned _ordered_task_index)
     :way_points(_way_points), dialog(_dialog),
      filter_widget(_filter_widget),
+     name_search(_way_points.GetNameIndex()),
      location(_location), last_heading(_heading),
      ordered_task(_ordered_task),
      ordered_task_index(_ordered_task_index) {}
@@ -254,6 +260,7 @@ WaypointFilterWidget::Update(Angle _last_heading)
 
 static void
 FillList(WaypointList &list, const Waypoints &src,
+         WaypointNameSearch &name_search,
          GeoPoint location, Angle heading, const WaypointListDialogState &state,
          OrderedTask *ordered_task, unsigned ordered_task_index)
 {
@@ -265,6 +272,18 @@ FillList(WaypointList &list, const Waypoints &src,
 
   WaypointListBuilder builder(filter, location, list,
                               ordered_task, ordered_task_index);
+
+  if (!filter.name.empty()) {
+    /* the name search returns each waypoint once, best match
+       first */
+    builder.Visit(name_search);
+
+    if (filter.distance > 0 || !filter.direction.IsNegative())
+      list.SortByDistance(location);
+
+    return;
+  }
+
   builder.Visit(src);
 
   if (filter.distance > 0 || !filter.direction.IsNegative())
@@ -298,7 +317,7 @@ WaypointListWidget::UpdateList()
     FillLastUsedList(items, LastUsedWaypoints::GetList(),
                      way_points);
   else
-    FillList(items, way_points, location, last_heading,
+    FillList(items, way_points, name_search, location, last_heading,
              dialog_state,
              ordered_task, ordered_task_index);
 
@@ -385,7 +385,7 @@ EnableCloud()
     Profile::Set(ProfileKeys::CloudKey, s);
   }
 
-  Profile::Save();
+  Profile::ScheduleSave();
 }
 
 /**
@@ -398,7 +398,7 @@ DisableCloud()
     CommonInterface::SetComputerSettings().tracking.skylines.cloud;
   settings.enabled = TriState::FALSE;
   Profile::Set(ProfileKeys::CloudEnabled, false);
-  Profile::Save();
+  Profile::ScheduleSave();
 }
 #endif
 
@@ -726,7 +726,7 @@ dlgQuickGuideShowModal(bool force_info)
   if (warranty_needed && state.warranty_accepted) {
     Profile::Set(ProfileKeys::DisclaimerAcknowledgedVersion,
                  XCSoar_Version);
-    Profile::Save();
+    Profile::ScheduleSave();
   }
 
   /* Mark news as seen only if the user checked the checkbox */
@@ -737,7 +737,7 @@ dlgQuickGuideShowModal(bool force_info)
       dynamic_cast<QuickGuidePageWidget *>(&news_widget);
     if (news_page != nullptr && news_page->GetCheckboxState()) {
       Profile::Set(ProfileKeys::LastSeenNewsVersion, XCSoar_Version);
-      Profile::Save();
+      Profile::ScheduleSave();
     }
   }
 
@@ -769,7 +769,7 @@ dlgQuickGuideShowModal(bool force_info)
     if (guide_page != nullptr) {
       Profile::Set(ProfileKeys::HideQuickGuideDialogOnStartup,
                    guide_page->GetCheckboxState());
-      Profile::Save();
+      Profile::ScheduleSave();
     }
   }
 
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlatObservationZone.hpp"
+#include "KeyholeZone.hpp"
+#include "AnnularSectorZone.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/FAISphere.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include <math.h>
+
+/**
+ * The safety margin around each boundary.  It must cover the
+ * difference between the spherical model used here and the WGS84
+ * ellipsoid used by #GeoVector, which is well below 1% of the
+ * distance.
+ */
+static constexpr double MARGIN_ABSOLUTE = 10;
+static constexpr double MARGIN_RELATIVE = 0.01;
+
+[[gnu::const]]
+static constexpr double
+Margin(double radius) noexcept
+{
+  return MARGIN_ABSOLUTE + MARGIN_RELATIVE * radius;
+}
+
+/**
+ * Convert a distance to the cosine of its central angle.  A negative
+ * distance yields a value which no dot product can reach.
+ */
+[[gnu::const]]
+static double
+DistanceToCos(double distance) noexcept
+{
+  if (distance < 0)
+    return 2;
+
+  const double angle = std::clamp(distance / FAISphere::REARTH, 0., M_PI);
+  return cos(angle);
+}
+
+static constexpr FlatObservationZone::Result
+Not(FlatObservationZone::Result a) noexcept
+{
+  using Result = FlatObservationZone::Result;
+
+  switch (a) {
+  case Result::OUTSIDE:
+    return Result::INSIDE;
+
+  case Result::INSIDE:
+    return Result::OUTSIDE;
+
+  case Result::UNKNOWN:
+    break;
+  }
+
+  return Result::UNKNOWN;
+}
+
+static constexpr FlatObservationZone::Result
+And(FlatObservationZone::Result a, FlatObservationZone::Result b) noexcept
+{
+  using Result = FlatObservationZone::Result;
+
+  if (a == Result::OUTSIDE || b == Result::OUTSIDE)
+    return Result::OUTSIDE;
+
+  if (a == Result::INSIDE && b == Result::INSIDE)
+    return Result::INSIDE;
+
+  return Result::UNKNOWN;
+}
+
+static constexpr FlatObservationZone::Result
+Or(FlatObservationZone::Result a, FlatObservationZone::Result b) noexcept
+{
+  return Not(And(Not(a), Not(b)));
+}
+
+/**
+ * Compare the cosine of a central angle against the precomputed
+ * cosines of a radius minus/plus its margin.
+ */
+static constexpr FlatObservationZone::Result
+ClassifyRadius(double cos_distance,
+               double cos_inside, double cos_outside) noexcept
+{
+  using Result = FlatObservationZone::Result;
+
+  if (cos_distance >= cos_inside)
+    return Result::INSIDE;
+
+  if (cos_distance < cos_outside)
+    return Result::OUTSIDE;
+
+  return Result::UNKNOWN;
+}
+
+FlatObservationZone::Location::Location(const GeoPoint &location) noexcept
+{
+  const auto [sin_lat, cos_lat] = location.latitude.SinCos();
+  const auto [sin_lon, cos_lon] = location.longitude.SinCos();
+
+  x = cos_lat * cos_lon;
+  y = cos_lat * sin_lon;
+  z = sin_lat;
+}
+
+void
+FlatObservationZone::SetCenter(const GeoPoint &reference) noexcept
+{
+  const auto [sin_lat, cos_lat] = reference.latitude.SinCos();
+  const auto [sin_lon, cos_lon] = reference.longitude.SinCos();
+
+  center = {cos_lat * cos_lon, cos_lat * sin_lon, sin_lat};
+  east = {-sin_lon, cos_lon, 0};
+  north = {-sin_lat * cos_lon, -sin_lat * sin_lon, cos_lat};
+}
+
+void
+FlatObservationZone::SetRadii(double outer, double inner) noexcept
+{
+  const double outer_margin = Margin(outer);
+  cos_outer_inside = DistanceToCos(outer - outer_margin);
+  cos_outer_outside = DistanceToCos(outer + outer_margin);
+
+  const double inner_margin = Margin(inner);
+  cos_inner_inside = DistanceToCos(inner - inner_margin);
+  cos_inner_outside = DistanceToCos(inner + inner_margin);
+}
+
+void
+FlatObservationZone::SetRadials(double outer_radius,
+                                Angle start, Angle end) noexcept
+{
+  /* same shortcut as SectorZone::IsAngleInSector() */
+  const Angle width = (end - start).AsBearing();
+  full_circle = width <= Angle::FullCircle() / 512;
+  reflex = width > Angle::HalfCircle();
+
+  std::tie(start_east, start_north) = start.SinCos();
+  std::tie(end_east, end_north) = end.SinCos();
+
+  lateral_margin = Margin(outer_radius) / FAISphere::REARTH;
+}
+
+void
+FlatObservationZone::Update(const ObservationZonePoint &oz) noexcept
+{
+  switch (oz.GetShape()) {
+  case ObservationZone::Shape::CYLINDER:
+  case ObservationZone::Shape::MAT_CYLINDER: {
+    const CylinderZone &cylinder = (const CylinderZone &)oz;
+    SetCenter(cylinder.GetReference());
+    SetRadii(cylinder.GetRadius(), 0);
+    type = Type::CYLINDER;
+    return;
+  }
+
+  case ObservationZone::Shape::LINE:
+  case ObservationZone::Shape::FAI_SECTOR:
+  case ObservationZone::Shape::SECTOR:
+  case ObservationZone::Shape::BGA_START:
+  case ObservationZone::Shape::SYMMETRIC_QUADRANT: {
+    const SectorZone &sector = (const SectorZone &)oz;
+    SetCenter(sector.GetReference());
+    SetRadii(sector.GetRadius(), 0);
+    SetRadials(sector.GetRadius(),
+               sector.GetStartRadial(), sector.GetEndRadial());
+    type = Type::SECTOR;
+    return;
+  }
+
+  case ObservationZone::Shape::DAEC_KEYHOLE:
+  case ObservationZone::Shape::CUSTOM_KEYHOLE:
+  case ObservationZone::Shape::BGAFIXEDCOURSE:
+  case ObservationZone::Shape::BGAENHANCEDOPTION: {
+    const KeyholeZone &keyhole = (const KeyholeZone &)oz;
+    SetCenter(keyhole.GetReference());
+    SetRadii(keyhole.GetRadius(), keyhole.GetInnerRadius());
+    SetRadials(keyhole.GetRadius(),
+               keyhole.GetStartRadial(), keyhole.GetEndRadial());
+    type = Type::KEYHOLE;
+    return;
+  }
+
+  case ObservationZone::Shape::ANNULAR_SECTOR: {
+    const AnnularSectorZone &annulus = (const AnnularSectorZone &)oz;
+    SetCenter(annulus.GetReference());
+    SetRadii(annulus.GetRadius(), annulus.GetInnerRadius());
+    SetRadials(annulus.GetRadius(),
+               annulus.GetStartRadial(), annulus.GetEndRadial());
+    type = Type::ANNULAR_SECTOR;
+    return;
+  }
+  }
+
+  type = Type::INVALID;
+}
+
+FlatObservationZone::Result
+FlatObservationZone::ClassifyAngle(const Location &location) const noexcept
+{
+  if (full_circle)
+    return Result::INSIDE;
+
+  /* the location projected onto the tangent plane; the length of
+     this vector is the sine of the central angle */
+  const double e = east.Dot(location);
+  const double n = north.Dot(location);
+
+  /* positive if the location is clockwise of the start radial */
+  const double after_start = start_north * e - start_east * n;
+  /* positive if the location is counter-clockwise of the end radial */
+  const double before_end = end_east * n - end_north * e;
+
+  if (!reflex) {
+    /* the sector is the intersection of two half-planes */
+    if (after_start < -lateral_margin || before_end < -lateral_margin)
+      return Result::OUTSIDE;
+
+    if (after_start > lateral_margin && before_end > lateral_margin)
+      return Result::INSIDE;
+  } else {
+    /* the sector is the union of two half-planes; its complement is
+       the intersection of the opposite ones */
+    if (after_start > lateral_margin || before_end > lateral_margin)
+      return Result::INSIDE;
+
+    if (after_start < -lateral_margin && before_end < -lateral_margin)
+      return Result::OUTSIDE;
+  }
+
+  return Result::UNKNOWN;
+}
+
+FlatObservationZone::Result
+FlatObservationZone::Classify(const Location &location) const noexcept
+{
+  if (type == Type::INVALID)
+    return Result::UNKNOWN;
+
+  const double cos_distance = center.Dot(location);
+  const Result outer = ClassifyRadius(cos_distance,
+                                      cos_outer_inside, cos_outer_outside);
+
+  switch (type) {
+  case Type::INVALID:
+    break;
+
+  case Type::CYLINDER:
+    return outer;
+
+  case Type::SECTOR:
+    if (outer == Result::OUTSIDE)
+      return outer;
+
+    return And(outer, ClassifyAngle(location));
+
+  case Type::ANNULAR_SECTOR:
+    if (outer == Result::OUTSIDE)
+      return outer;
+
+    return And(And(outer,
+                   Not(ClassifyRadius(cos_distance, cos_inner_inside,
+                                      cos_inner_outside))),
+               ClassifyAngle(location));
+
+  case Type::KEYHOLE: {
+    const Result inner = ClassifyRadius(cos_distance, cos_inner_inside,
+                                        cos_inner_outside);
+    if (inner == Result::INSIDE || outer == Result::OUTSIDE)
+      return inner == Result::INSIDE ? inner : outer;
+
+    return Or(inner, And(outer, ClassifyAngle(location)));
+  }
+  }
+
+  return Result::UNKNOWN;
+}
+
+FlatObservationZone::Result
+FlatObservationZone::Classify(const GeoPoint &location) const noexcept
+{
+  return Classify(Location(location));
+}
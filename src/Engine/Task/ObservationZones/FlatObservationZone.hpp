@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Math/Angle.hpp"
+
+#include <cstdint>
+
+struct GeoPoint;
+class ObservationZonePoint;
+
+/**
+ * A precomputed representation of an #ObservationZonePoint which
+ * allows testing whether a location is inside the zone with only a
+ * few multiplications, instead of the iterative ellipsoid distance
+ * and bearing calculations done by ObservationZone::IsInSector().
+ *
+ * The zone is described by the unit vector of its reference point
+ * and the local tangent plane (east/north) at that point; radii are
+ * compared as cosines of central angles, and sector radials are
+ * half-plane normals in the tangent plane.
+ *
+ * Since this is a spherical model, it differs slightly from the
+ * ellipsoid model used by #ObservationZone.  Locations close to the
+ * zone's boundary are therefore reported as
+ * #FlatObservationZone::Result::UNKNOWN, and the caller must fall
+ * back to the exact test.
+ */
+class FlatObservationZone {
+public:
+  enum class Result : uint8_t {
+    OUTSIDE,
+    INSIDE,
+
+    /**
+     * The location is too close to the boundary to be decided by
+     * this approximation.
+     */
+    UNKNOWN,
+  };
+
+  /**
+   * A location prepared for being tested against one or more zones.
+   * Preparing it once per fix allows testing all task points with
+   * only dot products.
+   */
+  struct Location {
+    double x, y, z;
+
+    explicit Location(const GeoPoint &location) noexcept;
+  };
+
+private:
+  enum class Type : uint8_t {
+    INVALID,
+    CYLINDER,
+    SECTOR,
+    ANNULAR_SECTOR,
+    KEYHOLE,
+  };
+
+  struct Vector {
+    double x, y, z;
+
+    constexpr double Dot(const Location &l) const noexcept {
+      return x * l.x + y * l.y + z * l.z;
+    }
+  };
+
+  /**
+   * The unit vector of the reference point, and the east and north
+   * unit vectors of its tangent plane.
+   */
+  Vector center, east, north;
+
+  /**
+   * Cosines of the central angles of the outer radius, minus and
+   * plus the safety margin.
+   */
+  double cos_outer_inside, cos_outer_outside;
+
+  /**
+   * Same as above, for the inner radius of keyhole and annular
+   * sector zones.
+   */
+  double cos_inner_inside, cos_inner_outside;
+
+  /**
+   * The directions of the start and end radials in the tangent
+   * plane (east, north).
+   */
+  double start_east, start_north, end_east, end_north;
+
+  /**
+   * The safety margin applied to the radial half-planes, in the
+   * units of the tangent plane (i.e. earth radii).
+   */
+  double lateral_margin;
+
+  Type type = Type::INVALID;
+
+  /**
+   * Does the sector span all directions?
+   */
+  bool full_circle;
+
+  /**
+   * Is the sector wider than a half circle?
+   */
+  bool reflex;
+
+public:
+  /**
+   * Rebuild the precomputed data from the given zone.  Must be
+   * called whenever the zone's geometry changes.
+   */
+  void Update(const ObservationZonePoint &oz) noexcept;
+
+  void Clear() noexcept {
+    type = Type::INVALID;
+  }
+
+  [[gnu::pure]]
+  Result Classify(const Location &location) const noexcept;
+
+  [[gnu::pure]]
+  Result Classify(const GeoPoint &location) const noexcept;
+
+private:
+  void SetCenter(const GeoPoint &reference) noexcept;
+  void SetRadii(double outer, double inner) noexcept;
+  void SetRadials(double outer_radius, Angle start, Angle end) noexcept;
+
+  [[gnu::pure]]
+  Result ClassifyAngle(const Location &location) const noexcept;
+};
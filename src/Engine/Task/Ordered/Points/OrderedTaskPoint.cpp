@@ -40,6 +40,7 @@ void
 OrderedTaskPoint::UpdateGeometry() noexcept
 {
   SetLegs(tp_previous, tp_next);
+  flat_zone.Update(GetObservationZone());
 }
 
 void
@@ -83,6 +84,17 @@ OrderedTaskPoint::GetSearchPoints() const noexcept
 bool
 OrderedTaskPoint::IsInSector(const AircraftState &ref) const noexcept
 {
+  switch (flat_zone.Classify(ref.location)) {
+  case FlatObservationZone::Result::OUTSIDE:
+    return false;
+
+  case FlatObservationZone::Result::INSIDE:
+    return true;
+
+  case FlatObservationZone::Result::UNKNOWN:
+    break;
+  }
+
   return ObservationZoneClient::IsInSector(ref.location);
 }
 
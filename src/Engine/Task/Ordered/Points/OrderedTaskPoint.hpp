@@ -7,6 +7,7 @@
 #include "Task/Points/TaskWaypoint.hpp"
 #include "Task/Points/ScoredTaskPoint.hpp"
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
+#include "Task/ObservationZones/FlatObservationZone.hpp"
 #include "Geo/Flat/FlatBoundingBox.hpp"
 
 #include <memory>
@@ -53,6 +54,13 @@ private:
   OrderedTaskPoint *tp_previous = nullptr;
   FlatBoundingBox flat_bb{}; // empty, not initialised
 
+  /**
+   * A cheap approximation of the observation zone, used by
+   * IsInSector() to avoid the exact test for locations which are
+   * clearly inside or outside.  Rebuilt by UpdateGeometry().
+   */
+  FlatObservationZone flat_zone;
+
 public:
   /**
    * Constructor.
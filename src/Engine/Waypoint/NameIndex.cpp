@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "NameIndex.hpp"
+#include "Waypoint.hpp"
+#include "util/StringUtil.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static std::string
+Normalize(std::string_view src) noexcept
+{
+  std::string dest(src.size() + 1, '\0');
+  NormalizeSearchString(dest.data(), src);
+  dest.resize(std::strlen(dest.c_str()));
+  return dest;
+}
+
+void
+WaypointNameIndex::Clear() noexcept
+{
+  entries.clear();
+  names.clear();
+  postings.clear();
+  n_removed = 0;
+  ++generation;
+}
+
+void
+WaypointNameIndex::AddEntry(const WaypointPtr &wp,
+                            std::string_view name) noexcept
+{
+  const uint32_t i = entries.size();
+  entries.push_back({wp, uint32_t(names.size()), uint32_t(name.size())});
+  names.append(name);
+
+  const auto add = [this, i](uint32_t gram){
+    auto &list = postings[gram];
+    if (list.empty() || list.back() != i)
+      list.push_back(i);
+  };
+
+  for (std::size_t j = 0; j + 2 <= name.size(); ++j) {
+    add(MakeBigram(name.data() + j));
+    if (j + 3 <= name.size())
+      add(MakeTrigram(name.data() + j));
+  }
+}
+
+void
+WaypointNameIndex::Add(const WaypointPtr &wp) noexcept
+{
+  const std::string name = Normalize(wp->name);
+  AddEntry(wp, name);
+
+  if (!wp->shortname.empty()) {
+    const std::string shortname = Normalize(wp->shortname);
+    if (shortname != name)
+      AddEntry(wp, shortname);
+  }
+
+  ++generation;
+}
+
+void
+WaypointNameIndex::Remove(const WaypointPtr &wp) noexcept
+{
+  for (auto &entry : entries) {
+    if (entry.waypoint == wp) {
+      entry.waypoint.reset();
+      ++n_removed;
+    }
+  }
+
+  ++generation;
+
+  if (n_removed > 64 && n_removed > entries.size() / 2)
+    Compact();
+}
+
+void
+WaypointNameIndex::Compact() noexcept
+{
+  const auto old_entries = std::move(entries);
+  const auto old_names = std::move(names);
+
+  entries.clear();
+  names.clear();
+  postings.clear();
+  n_removed = 0;
+
+  for (const auto &entry : old_entries)
+    if (entry.waypoint != nullptr)
+      AddEntry(entry.waypoint,
+               std::string_view{old_names}.substr(entry.offset, entry.length));
+}
+
+/**
+ * Returns the smallest number of edits needed to make the needle
+ * appear somewhere in the haystack (Sellers' algorithm), or a value
+ * larger than #limit if that exceeds the limit.
+ *
+ * @param column a buffer for one column of the edit matrix
+ */
+static unsigned
+ApproximateFind(std::string_view needle, std::string_view haystack,
+                unsigned limit, std::vector<unsigned> &column) noexcept
+{
+  const std::size_t m = needle.size();
+  column.resize(m + 1);
+  for (std::size_t i = 0; i <= m; ++i)
+    column[i] = i;
+
+  unsigned best = column[m];
+
+  for (const char ch : haystack) {
+    /* a match may start anywhere in the haystack */
+    unsigned diagonal = 0;
+    for (std::size_t i = 1; i <= m; ++i) {
+      const unsigned substitution = diagonal + (needle[i - 1] != ch);
+      diagonal = column[i];
+      column[i] = std::min({substitution, column[i] + 1, column[i - 1] + 1});
+    }
+
+    best = std::min(best, column[m]);
+    if (best == 0)
+      break;
+  }
+
+  return best <= limit ? best : limit + 1;
+}
+
+/**
+ * Returns the sorted distinct bigrams (@a q = 2) or trigrams (@a q =
+ * 3) of the string.
+ */
+static std::vector<uint32_t>
+GetDistinctGrams(std::string_view s, std::size_t q) noexcept
+{
+  std::vector<uint32_t> grams;
+  for (std::size_t j = 0; j + q <= s.size(); ++j)
+    grams.push_back(q == 3
+                    ? WaypointNameIndex::MakeTrigram(s.data() + j)
+                    : WaypointNameIndex::MakeBigram(s.data() + j));
+
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  return grams;
+}
+
+void
+WaypointNameSearch::FindCandidates() noexcept
+{
+  candidates.clear();
+
+  /* each edit destroys at most q of the query's q-grams; a name
+     must share the others.  Trigrams are more selective, but short
+     queries don't have enough of them, so fall back to bigrams; if
+     even those are not enough, tolerate fewer errors instead of
+     examining all names */
+  std::vector<uint32_t> grams;
+  int threshold;
+  while (true) {
+    grams = GetDistinctGrams(query, 3);
+    threshold = int(grams.size()) - 3 * int(max_errors);
+    if (threshold > 0)
+      break;
+
+    grams = GetDistinctGrams(query, 2);
+    threshold = int(grams.size()) - 2 * int(max_errors);
+    if (threshold > 0 || max_errors == 0)
+      break;
+
+    --max_errors;
+  }
+
+  if (threshold <= 0) {
+    /* a single character: examine all names, but only for exact
+       matches */
+    for (uint32_t i = 0; i < index.entries.size(); ++i)
+      candidates.push_back(i);
+    return;
+  }
+
+  std::vector<uint16_t> counts(index.entries.size());
+  for (const uint32_t gram : grams) {
+    const auto p = index.postings.find(gram);
+    if (p == index.postings.end())
+      continue;
+
+    for (const uint32_t i : p->second)
+      if (++counts[i] == unsigned(threshold))
+        candidates.push_back(i);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+void
+WaypointNameSearch::Verify(std::vector<uint32_t> src) noexcept
+{
+  candidates.clear();
+  matches.clear();
+
+  std::vector<unsigned> column;
+
+  for (const uint32_t i : src) {
+    const auto &entry = index.entries[i];
+    if (entry.waypoint == nullptr)
+      continue;
+
+    const std::string_view name = index.GetName(entry);
+
+    Match match{
+      entry.waypoint, 0, 0,
+      uint16_t(std::min<std::size_t>(name.size(), 0xffff)),
+    };
+
+    const auto position = name.find(query);
+    if (position == 0) {
+      match.position = 0;
+    } else if (position != name.npos) {
+      match.position = 1;
+    } else if (max_errors > 0) {
+      const unsigned errors = ApproximateFind(query, name, max_errors, column);
+      if (errors > max_errors)
+        continue;
+
+      match.errors = errors;
+      match.position = 2;
+    } else
+      continue;
+
+    candidates.push_back(i);
+    matches.push_back(std::move(match));
+  }
+
+  const auto rank = [](const Match &a, const Match &b){
+    if (a.errors != b.errors)
+      return a.errors < b.errors;
+    if (a.position != b.position)
+      return a.position < b.position;
+    if (a.length != b.length)
+      return a.length < b.length;
+    return a.waypoint->name < b.waypoint->name;
+  };
+
+  /* keep only the best match of each waypoint (name or short
+     name) */
+  std::sort(matches.begin(), matches.end(), [&rank](const Match &a, const Match &b){
+    if (a.waypoint != b.waypoint)
+      return a.waypoint < b.waypoint;
+    return rank(a, b);
+  });
+  matches.erase(std::unique(matches.begin(), matches.end(),
+                            [](const Match &a, const Match &b){
+                              return a.waypoint == b.waypoint;
+                            }),
+                matches.end());
+
+  std::sort(matches.begin(), matches.end(), rank);
+}
+
+const std::vector<WaypointNameSearch::Match> &
+WaypointNameSearch::Update(std::string_view name) noexcept
+{
+  std::string new_query = Normalize(name);
+  const unsigned new_max_errors =
+    WaypointNameIndex::GetMaxErrors(new_query.size());
+
+  if (new_query.empty()) {
+    query.clear();
+    candidates.clear();
+    matches.clear();
+    return matches;
+  }
+
+  /* a name matching the longer query with N errors also matches its
+     prefix with N errors, so the previous matches can be narrowed
+     down unless more errors are allowed now */
+  const bool narrow = generation == index.GetGeneration() &&
+    !query.empty() && new_query.starts_with(query) &&
+    new_max_errors <= max_errors;
+
+  if (narrow && new_query == query)
+    return matches;
+
+  query = std::move(new_query);
+  max_errors = new_max_errors;
+  generation = index.GetGeneration();
+
+  if (!narrow)
+    FindCandidates();
+
+  Verify(std::move(candidates));
+  return matches;
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Ptr.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A bigram and trigram index on the normalised names (and short
+ * names) of waypoints, for substring and typo-tolerant searches.  It is
+ * maintained incrementally by #Waypoints; removed entries are only
+ * marked and get purged when there are too many of them.
+ *
+ * Use #WaypointNameSearch to query it.
+ */
+class WaypointNameIndex {
+  friend class WaypointNameSearch;
+
+  struct Entry {
+    /**
+     * nullptr if this entry has been removed.
+     */
+    WaypointPtr waypoint;
+
+    /**
+     * The normalised name within #names.
+     */
+    uint32_t offset, length;
+  };
+
+  std::vector<Entry> entries;
+
+  /**
+   * All normalised names, concatenated.
+   */
+  std::string names;
+
+  /**
+   * Maps a bigram (see MakeBigram()) or a trigram (see
+   * MakeTrigram()) to the ascending indices of all #entries
+   * containing it.  Names contain no null bytes, so bigram keys are
+   * always smaller than trigram keys and the two never collide.
+   */
+  std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+
+  /**
+   * The number of removed #entries.
+   */
+  std::size_t n_removed = 0;
+
+  /**
+   * Incremented on each modification; allows #WaypointNameSearch to
+   * discard its cached results.
+   */
+  unsigned generation = 0;
+
+public:
+  bool empty() const noexcept {
+    return entries.size() == n_removed;
+  }
+
+  unsigned GetGeneration() const noexcept {
+    return generation;
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Add the name and the short name of the waypoint.
+   */
+  void Add(const WaypointPtr &wp) noexcept;
+
+  void Remove(const WaypointPtr &wp) noexcept;
+
+  /**
+   * The number of query errors (insertions, deletions or
+   * substitutions) tolerated for a normalised query of the given
+   * length.
+   */
+  static constexpr unsigned GetMaxErrors(std::size_t length) noexcept {
+    return length >= 8 ? 2 : (length >= 4 ? 1 : 0);
+  }
+
+  static constexpr uint32_t MakeBigram(const char *p) noexcept {
+    return uint8_t(p[0]) | (uint8_t(p[1]) << 8);
+  }
+
+  static constexpr uint32_t MakeTrigram(const char *p) noexcept {
+    return uint8_t(p[0]) | (uint8_t(p[1]) << 8) | (uint8_t(p[2]) << 16);
+  }
+
+private:
+  std::string_view GetName(const Entry &entry) const noexcept {
+    return {names.data() + entry.offset, entry.length};
+  }
+
+  void AddEntry(const WaypointPtr &wp, std::string_view name) noexcept;
+
+  /**
+   * Rebuild everything without the removed entries.
+   */
+  void Compact() noexcept;
+};
+
+/**
+ * A search session on a #WaypointNameIndex, e.g. for a text field
+ * the pilot is typing in.  If the new query extends the previous one,
+ * only the previous matches are examined again.
+ */
+class WaypointNameSearch {
+public:
+  struct Match {
+    WaypointPtr waypoint;
+
+    /**
+     * The number of edits needed to find the query in the name.
+     */
+    uint8_t errors;
+
+    /**
+     * 0 if the name starts with the query, 1 if it contains it, 2 if
+     * it was only found with errors.
+     */
+    uint8_t position;
+
+    /**
+     * The length of the normalised name.
+     */
+    uint16_t length;
+  };
+
+private:
+  const WaypointNameIndex &index;
+
+  /**
+   * The index generation #candidates belongs to.
+   */
+  unsigned generation = 0;
+
+  std::string query;
+  unsigned max_errors = 0;
+
+  /**
+   * The indices of all index entries matching #query.
+   */
+  std::vector<uint32_t> candidates;
+
+  std::vector<Match> matches;
+
+public:
+  explicit WaypointNameSearch(const WaypointNameIndex &_index) noexcept
+    :index(_index) {}
+
+  /**
+   * Search the given name and return the matching waypoints, best
+   * match first: fewer errors, then prefix before substring matches,
+   * then shorter names, then alphabetically.  Each waypoint is listed
+   * only once.
+   *
+   * The returned reference is valid until the next call.
+   */
+  const std::vector<Match> &Update(std::string_view name) noexcept;
+
+private:
+  void FindCandidates() noexcept;
+  void Verify(std::vector<uint32_t> src) noexcept;
+};
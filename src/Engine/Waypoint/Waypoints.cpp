@@ -113,6 +113,7 @@ Waypoints::Append(WaypointPtr wp) noexcept
   w.id = next_id++;
 
   waypoint_tree.Add(wp);
+  name_index.Add(wp);
   name_tree.Add(wp);
 
   ++serial;
@@ -239,6 +240,27 @@ Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
   waypoint_tree.VisitWithinRange(point, mrange, visitor);
 }
 
+void
+Waypoints::VisitNearest(const GeoPoint &loc, const double range,
+                        bool (*predicate)(const Waypoint &),
+                        NearestWaypointVisitor visitor) const
+{
+  if (IsEmpty())
+    return; // nothing to do
+
+  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  waypoint_tree.VisitNearestIf(point, mrange,
+                               [predicate](const WaypointPtr &ptr){
+                                 return predicate == nullptr || predicate(*ptr);
+                               },
+                               [&visitor](const WaypointPtr &ptr, unsigned){
+                                 return visitor(ptr);
+                               });
+}
+
 void
 Waypoints::VisitNamePrefix(std::string_view prefix,
                            WaypointVisitor visitor) const
@@ -252,6 +274,7 @@ Waypoints::Clear() noexcept
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  name_index.Clear();
   waypoint_tree.clear();
   next_id = 1;
 }
@@ -268,6 +291,7 @@ Waypoints::Erase(WaypointPtr &&wp) noexcept
                                        });
   assert(f.first != waypoint_tree.end());
 
+  name_index.Remove(wp);
   name_tree.Remove(std::move(wp));
   waypoint_tree.erase(f.first);
   ++serial;
@@ -283,6 +307,7 @@ Waypoints::EraseUserMarkers() noexcept
           home = nullptr;
 
         name_tree.Remove(wp);
+        name_index.Remove(wp);
         ++serial;
         return true;
       } else
@@ -296,6 +321,7 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
   assert(!waypoint_tree.IsEmpty());
 
   name_tree.Remove(orig);
+  name_index.Remove(orig);
 
   replacement.id = orig->id;
 
@@ -310,6 +336,7 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
 
   WaypointPtr new_ptr(new Waypoint(std::move(replacement)));
   name_tree.Add(new_ptr);
+  name_index.Add(new_ptr);
 
   auto f = waypoint_tree.FindNearestIf(waypoint_tree.GetPosition(orig), 0,
                                        [&orig](const WaypointPtr &ptr){
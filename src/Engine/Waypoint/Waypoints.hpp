@@ -5,6 +5,7 @@
 
 #include "Ptr.hpp"
 #include "Waypoint.hpp"
+#include "NameIndex.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "util/RadixTree.hpp"
 #include "util/QuadTree.hxx"
@@ -15,6 +16,12 @@
 
 using WaypointVisitor = std::function<void(const WaypointPtr &)>;
 
+/**
+ * A visitor for Waypoints::VisitNearest(); returns false to stop the
+ * search.
+ */
+using NearestWaypointVisitor = std::function<bool(const WaypointPtr &)>;
+
 /**
  * Container for waypoints using kd-tree representation internally for
  * fast geospatial lookups.
@@ -62,6 +69,7 @@ class Waypoints {
 
   WaypointTree waypoint_tree;
   WaypointNameTree name_tree;
+  WaypointNameIndex name_index;
   TaskProjection task_projection;
 
   WaypointPtr home;
@@ -285,12 +293,41 @@ public:
   void VisitWithinRange(const GeoPoint &loc, double range,
                         WaypointVisitor visitor) const;
 
+  /**
+   * Call visitor function on waypoints within the specified range,
+   * nearest first, until it returns false.  This is cheaper than
+   * VisitWithinRange() followed by sorting if only the few nearest
+   * waypoints are needed, because the search stops early.
+   *
+   * @param loc Location from which to search
+   * @param range Distance in meters of search radius
+   * @param predicate Callback that checks whether the waypoint
+   * is suitable for the request; nullptr matches all waypoints
+   * @param visitor Visitor to be called on waypoints within range
+   */
+  void VisitNearest(const GeoPoint &loc, double range,
+                    bool (*predicate)(const Waypoint &),
+                    NearestWaypointVisitor visitor) const;
+
+  void VisitNearest(const GeoPoint &loc, double range,
+                    NearestWaypointVisitor visitor) const {
+    VisitNearest(loc, range, nullptr, std::move(visitor));
+  }
+
   /**
    * Call visitor function on waypoints with the specified name
    * prefix.
    */
   void VisitNamePrefix(std::string_view prefix, WaypointVisitor visitor) const;
 
+  /**
+   * Returns the trigram index on all waypoint names, to be queried
+   * with #WaypointNameSearch.
+   */
+  const WaypointNameIndex &GetNameIndex() const noexcept {
+    return name_index;
+  }
+
   /**
    * Returns a set of possible characters following the specified
    * prefix.
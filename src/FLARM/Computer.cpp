@@ -139,4 +139,8 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
         traffic.speed = last_traffic->speed;
     }
   }
+
+  /* sort by distance and find the maximum alert once, instead of
+     letting each reader scan the list */
+  flarm.traffic.Rank();
 }
@@ -19,12 +19,12 @@ extern void SaveFlarmMessagingPeriodic() noexcept __attribute__((weak));
 
 namespace FlarmDetails {
 
-const FlarmNetRecord *
+std::optional<FlarmNetRecord>
 LookupRecord(FlarmId id) noexcept
 {
   // try to find flarm from FlarmNet.org File
   if (traffic_databases == nullptr)
-    return NULL;
+    return std::nullopt;
 
   return traffic_databases->flarm_net.FindRecordById(id);
 }
@@ -85,7 +85,7 @@ ResolveInfo(FlarmId id) noexcept
     return out;
 
   const auto msg = std::as_const(traffic_databases->flarm_messages).FindRecordById(id);
-  const auto *net = traffic_databases->flarm_net.FindRecordById(id);
+  const auto net = traffic_databases->flarm_net.FindRecordById(id);
 
   out.callsign = traffic_databases->FindNameById(id);
 
@@ -100,7 +100,7 @@ ResolveInfo(FlarmId id) noexcept
 
     if (msg->frequency.IsDefined())
       out.frequency = msg->frequency;
-  } else if (net != nullptr) {
+  } else if (net.has_value()) {
     out.source = ResolvedSource::FLARMNET;
 
     out.pilot = net->Format(pilot_buf, net->pilot.c_str());
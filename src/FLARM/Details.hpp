@@ -4,6 +4,9 @@
 #pragma once
 
 #include "RadioFrequency.hpp"
+
+#include <optional>
+
 class FlarmId;
 struct FlarmNetRecord;
 struct MessagingRecord;
@@ -48,10 +51,10 @@ namespace FlarmDetails {
  * Looks up the FLARM id in the FLARMNet Database
  * and returns the FLARMNet Record
  * @param id FLARM id
- * @return The corresponding FLARMNet Record if found, otherwise NULL
+ * @return The corresponding FLARMNet Record if found
  */
 [[gnu::pure]]
-const FlarmNetRecord *
+std::optional<FlarmNetRecord>
 LookupRecord(FlarmId id) noexcept;
 
 /**
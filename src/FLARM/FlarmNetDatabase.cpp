@@ -2,9 +2,34 @@
 // Copyright The XCSoar Project
 
 #include "FlarmNetDatabase.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "lib/fmt/PathFormatter.hpp"
+#include "lib/fmt/RuntimeError.hxx"
+#include "system/Path.hpp"
 #include "util/StringAPI.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+FlarmNetDatabase::FlarmNetDatabase() noexcept = default;
+FlarmNetDatabase::~FlarmNetDatabase() noexcept = default;
+
+void
+FlarmNetDatabase::Clear() noexcept
+{
+  records = {};
+  callsign_index = {};
+  strings = {};
+  source = {};
+  buffer.clear();
+  mapping.reset();
+  pending.clear();
+}
 
 void
 FlarmNetDatabase::Insert(const FlarmNetRecord &record) noexcept
@@ -13,50 +38,301 @@ FlarmNetDatabase::Insert(const FlarmNetRecord &record) noexcept
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(record.id, record));
+  pending.push_back(record);
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const char *cn) const noexcept
+/**
+ * Builds the string pool of a compiled image, storing each distinct
+ * string only once.
+ */
+class FlarmNetStringPool {
+  std::string data{'\0'};
+  std::unordered_map<std::string, uint32_t> offsets;
+
+public:
+  uint32_t Add(const char *s) noexcept {
+    if (*s == '\0')
+      return 0;
+
+    auto [i, inserted] = offsets.try_emplace(s, data.size());
+    if (inserted)
+      data.append(s, std::strlen(s) + 1);
+    return i->second;
+  }
+
+  std::string_view GetData() const noexcept {
+    return data;
+  }
+};
+
+void
+FlarmNetDatabase::Compile() noexcept
 {
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  if (pending.empty())
+    return;
 
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  /* the existing records come first, so they win over duplicates,
+     just like the first Insert() of an id wins */
+  std::vector<FlarmNetRecord> all;
+  all.reserve(records.size() + pending.size());
+  ForEach([&all](FlarmNetRecord &&record){
+    all.emplace_back(std::move(record));
+  });
+  all.insert(all.end(), pending.begin(), pending.end());
+  pending.clear();
+  pending.shrink_to_fit();
+
+  std::stable_sort(all.begin(), all.end(), [](const auto &a, const auto &b){
+    return a.id < b.id;
+  });
+  all.erase(std::unique(all.begin(), all.end(), [](const auto &a, const auto &b){
+    return a.id == b.id;
+  }), all.end());
+
+  FlarmNetStringPool pool;
+  std::vector<FlarmNetFileRecord> new_records;
+  new_records.reserve(all.size());
+  for (const auto &src : all) {
+    FlarmNetFileRecord &dest = new_records.emplace_back();
+    dest.id = src.id.GetValue();
+    dest.pilot = pool.Add(src.pilot);
+    dest.airfield = pool.Add(src.airfield);
+    dest.plane_type = pool.Add(src.plane_type);
+    dest.registration = pool.Add(src.registration);
+    dest.callsign = pool.Add(src.callsign);
+    dest.frequency = src.frequency.IsDefined()
+      ? src.frequency.GetKiloHertz()
+      : 0;
   }
 
-  return NULL;
+  std::vector<PackedLE32> new_index(all.size());
+  for (std::size_t i = 0; i < all.size(); ++i)
+    new_index[i] = i;
+
+  std::stable_sort(new_index.begin(), new_index.end(),
+                   [&all](uint32_t a, uint32_t b){
+                     return std::strcmp(all[a].callsign, all[b].callsign) < 0;
+                   });
+
+  FlarmNetFileHeader header;
+  header.magic = FlarmNetFileHeader::MAGIC;
+  header.version = FlarmNetFileHeader::VERSION;
+  header.n_records = new_records.size();
+  header.strings_size = pool.GetData().size();
+  header.source_size = 0;
+  header.source_modified = 0;
+
+  const auto append = [this](std::span<const std::byte> src){
+    buffer.insert(buffer.end(), src.begin(), src.end());
+  };
+
+  mapping.reset();
+  buffer.clear();
+  buffer.reserve(sizeof(header) +
+                 new_records.size() * sizeof(FlarmNetFileRecord) +
+                 new_index.size() * sizeof(PackedLE32) +
+                 pool.GetData().size());
+  append(std::as_bytes(std::span{&header, 1}));
+  append(std::as_bytes(std::span{new_records}));
+  append(std::as_bytes(std::span{new_index}));
+  append(std::as_bytes(std::span{pool.GetData()}));
+
+  [[maybe_unused]] const bool valid = SetImage(buffer);
+  assert(valid);
 }
 
-unsigned
-FlarmNetDatabase::FindRecordsByCallSign(const char *cn,
-                                        const FlarmNetRecord *array[],
-                                        [[maybe_unused]] unsigned size) const noexcept
+bool
+FlarmNetDatabase::SetImage(std::span<const std::byte> image) noexcept
 {
-  unsigned count = 0;
+  if (image.size() < sizeof(FlarmNetFileHeader))
+    return false;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  const auto &header =
+    *reinterpret_cast<const FlarmNetFileHeader *>(image.data());
+  const std::size_t n_records = header.n_records;
+  const std::size_t strings_size = header.strings_size;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  /* check the counts by dividing, so a malformed header can't
+     overflow the size calculation */
+  const std::size_t available = image.size() - sizeof(header);
+  constexpr std::size_t record_size =
+    sizeof(FlarmNetFileRecord) + sizeof(PackedLE32);
 
-  return count;
+  if (header.magic != FlarmNetFileHeader::MAGIC ||
+      header.version != FlarmNetFileHeader::VERSION ||
+      n_records > available / record_size ||
+      strings_size != available - n_records * record_size ||
+      strings_size == 0)
+    return false;
+
+  const std::byte *p = image.data() + sizeof(header);
+  const std::span<const FlarmNetFileRecord> new_records{
+    reinterpret_cast<const FlarmNetFileRecord *>(p),
+    n_records,
+  };
+  p += new_records.size_bytes();
+
+  const std::span<const PackedLE32> new_index{
+    reinterpret_cast<const PackedLE32 *>(p),
+    n_records,
+  };
+  p += new_index.size_bytes();
+
+  const std::string_view new_strings{reinterpret_cast<const char *>(p),
+                                     strings_size};
+
+  const auto get_callsign = [new_records, new_strings](uint32_t i){
+    const uint32_t offset = new_records[i].callsign;
+    return offset < new_strings.size()
+      ? std::string_view{new_strings.data() + offset}
+      : std::string_view{};
+  };
+
+  /* these checks are O(n), but much cheaper than parsing; they
+     guarantee that lookups can't go out of bounds and that the
+     binary searches find everything */
+  if (new_strings.front() != '\0' || new_strings.back() != '\0' ||
+      !std::is_sorted(new_records.begin(), new_records.end(),
+                      [](const auto &a, const auto &b){
+                        return uint32_t(a.id) < uint32_t(b.id);
+                      }) ||
+      !std::all_of(new_index.begin(), new_index.end(), [n_records](uint32_t i){
+        return i < n_records;
+      }) ||
+      !std::is_sorted(new_index.begin(), new_index.end(),
+                      [&get_callsign](uint32_t a, uint32_t b){
+                        return get_callsign(a) < get_callsign(b);
+                      }))
+    return false;
+
+  records = new_records;
+  callsign_index = new_index;
+  strings = new_strings;
+  source = {header.source_size, header.source_modified};
+  return true;
+}
+
+void
+FlarmNetDatabase::Load(Path path)
+{
+  auto new_mapping = std::make_unique<FileMapping>(path);
+
+  Clear();
+  if (!SetImage(*new_mapping))
+    throw FmtRuntimeError("Malformed FlarmNet file: {}", path);
+
+  mapping = std::move(new_mapping);
+}
+
+void
+FlarmNetDatabase::Save(Path path, const FlarmNetFileSource &_source) const
+{
+  assert(pending.empty());
+
+  FileOutputStream file(path);
+  BufferedOutputStream out(file);
+
+  FlarmNetFileHeader header;
+  header.magic = FlarmNetFileHeader::MAGIC;
+  header.version = FlarmNetFileHeader::VERSION;
+  header.n_records = records.size();
+  header.strings_size = std::max<std::size_t>(strings.size(), 1);
+  header.source_size = _source.size;
+  header.source_modified = _source.modified;
+  out.WriteT(header);
+
+  out.Write(std::as_bytes(records));
+  out.Write(std::as_bytes(callsign_index));
+
+  if (strings.empty())
+    out.WriteT('\0');
+  else
+    out.Write(strings);
+
+  out.Flush();
+  file.Commit();
+}
+
+const FlarmNetFileRecord *
+FlarmNetDatabase::FindById(FlarmId id) const noexcept
+{
+  const uint32_t value = id.GetValue();
+  auto i = std::partition_point(records.begin(), records.end(),
+                                [value](const FlarmNetFileRecord &record){
+                                  return uint32_t(record.id) < value;
+                                });
+  return i != records.end() && uint32_t(i->id) == value
+    ? &*i
+    : nullptr;
+}
+
+std::span<const PackedLE32>
+FlarmNetDatabase::FindByCallSign(std::string_view cn) const noexcept
+{
+  const auto get = [this](uint32_t i){
+    return std::string_view{GetString(records[i].callsign)};
+  };
+
+  auto first = std::partition_point(callsign_index.begin(), callsign_index.end(),
+                                    [&](uint32_t i){ return get(i) < cn; });
+  auto last = std::partition_point(first, callsign_index.end(),
+                                   [&](uint32_t i){ return get(i) == cn; });
+  return {first, last};
+}
+
+FlarmNetRecord
+FlarmNetDatabase::Decode(const FlarmNetFileRecord &src) const noexcept
+{
+  FlarmNetRecord dest;
+  dest.id = FlarmId::FromValue(src.id);
+  dest.pilot = GetString(src.pilot);
+  dest.airfield = GetString(src.airfield);
+  dest.plane_type = GetString(src.plane_type);
+  dest.registration = GetString(src.registration);
+  dest.callsign = GetString(src.callsign);
+  dest.frequency = RadioFrequency::FromKiloHertz(src.frequency);
+  return dest;
+}
+
+std::optional<FlarmNetRecord>
+FlarmNetDatabase::FindRecordById(FlarmId id) const noexcept
+{
+  const FlarmNetFileRecord *record = FindById(id);
+  if (record == nullptr)
+    return std::nullopt;
+
+  return Decode(*record);
+}
+
+const char *
+FlarmNetDatabase::FindCallSignById(FlarmId id) const noexcept
+{
+  const FlarmNetFileRecord *record = FindById(id);
+  return record != nullptr
+    ? GetString(record->callsign)
+    : nullptr;
+}
+
+FlarmId
+FlarmNetDatabase::FindFirstIdByCallSign(const char *cn) const noexcept
+{
+  const auto found = FindByCallSign(cn);
+  return found.empty()
+    ? FlarmId::Undefined()
+    : FlarmId::FromValue(records[found.front()].id);
 }
 
 unsigned
 FlarmNetDatabase::FindIdsByCallSign(const char *cn, FlarmId array[],
-                                    [[maybe_unused]] unsigned size) const noexcept
+                                    unsigned size) const noexcept
 {
   unsigned count = 0;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  for (uint32_t i : FindByCallSign(cn)) {
+    if (count >= size)
+      break;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = id;
+    array[count++] = FlarmId::FromValue(records[i].id);
   }
 
   return count;
@@ -5,60 +5,161 @@
 
 #include "Id.hpp"
 #include "FlarmNetRecord.hpp"
+#include "FlarmNetFile.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class Path;
+class FileMapping;
 
-#include <map>
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are kept in the compact format described in
+ * FlarmNetFile.hpp: a sorted id array for O(log n) id lookups, a
+ * record index sorted by call sign, and a pool of deduplicated
+ * strings.  This image is either built from the records passed to
+ * Insert() (see Compile()) or mapped from a file written by Save(),
+ * which needs no parsing at all.
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * The compiled image if it was not loaded from a file.
+   */
+  std::vector<std::byte> buffer;
+
+  /**
+   * Sorted by id.
+   */
+  std::span<const FlarmNetFileRecord> records;
+
+  /**
+   * Indexes into #records, sorted by call sign.
+   */
+  std::span<const PackedLE32> callsign_index;
+
+  std::string_view strings;
+
+  /**
+   * The source file of the image loaded by Load().
+   */
+  FlarmNetFileSource source;
+
+  /**
+   * Records passed to Insert() which have not yet been compiled.
+   */
+  std::vector<FlarmNetRecord> pending;
 
 public:
+  FlarmNetDatabase() noexcept;
+  ~FlarmNetDatabase() noexcept;
+
+  FlarmNetDatabase(const FlarmNetDatabase &) = delete;
+  FlarmNetDatabase &operator=(const FlarmNetDatabase &) = delete;
+
   bool IsEmpty() const noexcept {
-    return map.empty();
+    return records.empty() && pending.empty();
   }
 
-  void Clear() noexcept {
-    map.clear();
+  std::size_t size() const noexcept {
+    return records.size();
   }
 
+  void Clear() noexcept;
+
+  /**
+   * Add a record.  It becomes visible after the next Compile() call;
+   * records with an id which is already present are ignored.
+   */
   void Insert(const FlarmNetRecord &record) noexcept;
 
+  /**
+   * Merge all records passed to Insert() into the compact image.
+   */
+  void Compile() noexcept;
+
+  /**
+   * Replace the contents with the given compiled file.  Throws on
+   * error.
+   */
+  void Load(Path path);
+
+  /**
+   * Returns the #FlarmNetFileSource of the file passed to Load(), to
+   * check whether it is still up to date.
+   */
+  const FlarmNetFileSource &GetSource() const noexcept {
+    return source;
+  }
+
+  /**
+   * Write the compiled image to the given file.  Throws on error.
+   *
+   * @param source describes the text file the records were parsed
+   * from
+   */
+  void Save(Path path, const FlarmNetFileSource &source) const;
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   [[gnu::pure]]
-  const FlarmNetRecord *FindRecordById(FlarmId id) const noexcept {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  std::optional<FlarmNetRecord> FindRecordById(FlarmId id) const noexcept;
 
   /**
-   * Finds a FLARMNetRecord object based on the given Callsign
-   * @param cn Callsign
-   * @return FLARMNetRecord object
+   * Returns the call sign of the given FLARM id, or nullptr if the
+   * id is unknown.  The pointer is valid as long as this object is
+   * not modified.
    */
   [[gnu::pure]]
-  const FlarmNetRecord *FindFirstRecordByCallSign(const char *cn) const noexcept;
+  const char *FindCallSignById(FlarmId id) const noexcept;
+
+  /**
+   * Returns the id of the first record with the given call sign, or
+   * FlarmId::Undefined().
+   */
+  [[gnu::pure]]
+  FlarmId FindFirstIdByCallSign(const char *cn) const noexcept;
 
-  unsigned FindRecordsByCallSign(const char *cn,
-                                 const FlarmNetRecord *array[],
-                                 unsigned size) const noexcept;
   unsigned FindIdsByCallSign(const char *cn, FlarmId array[],
                              unsigned size) const noexcept;
 
-  [[gnu::pure]]
-  auto begin() const noexcept {
-    return map.begin();
+  /**
+   * Invoke the function with each #FlarmNetRecord, sorted by id.
+   */
+  template<typename F>
+  void ForEach(F &&f) const {
+    for (const auto &record : records)
+      f(Decode(record));
   }
 
+private:
   [[gnu::pure]]
-  auto end() const noexcept {
-    return map.end();
+  const FlarmNetFileRecord *FindById(FlarmId id) const noexcept;
+
+  [[gnu::pure]]
+  std::span<const PackedLE32> FindByCallSign(std::string_view cn) const noexcept;
+
+  [[gnu::pure]]
+  const char *GetString(uint32_t offset) const noexcept {
+    return offset < strings.size() ? strings.data() + offset : "";
   }
+
+  [[gnu::pure]]
+  FlarmNetRecord Decode(const FlarmNetFileRecord &record) const noexcept;
+
+  /**
+   * Point the spans at the given image (a header followed by the
+   * data).  Returns false if the image is malformed.
+   */
+  bool SetImage(std::span<const std::byte> image) noexcept;
 };
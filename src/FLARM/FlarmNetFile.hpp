@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/PackedLittleEndian.hxx"
+
+#include <cstdint>
+
+/**
+ * One record of a compiled FlarmNet file (see #FlarmNetDatabase).
+ * All integers are little-endian and the struct has no padding, so a
+ * file can be mapped into memory and used directly.  The strings are
+ * byte offsets into the string pool.
+ */
+struct FlarmNetFileRecord {
+  PackedLE32 id;
+
+  PackedLE32 pilot, airfield, plane_type, registration, callsign;
+
+  /**
+   * The radio frequency [kHz]; 0 if unknown.
+   */
+  PackedLE32 frequency;
+};
+
+static_assert(sizeof(FlarmNetFileRecord) == 28, "Wrong size");
+static_assert(alignof(FlarmNetFileRecord) == 1, "Wrong alignment");
+
+/**
+ * The header of a compiled FlarmNet file.  It is followed by:
+ *
+ * - FlarmNetFileHeader::n_records instances of #FlarmNetFileRecord
+ *   sorted by id
+ * - FlarmNetFileHeader::n_records record indexes (PackedLE32) sorted
+ *   by call sign
+ * - FlarmNetFileHeader::strings_size bytes of null-terminated UTF-8
+ *   strings; offset 0 is the empty string
+ */
+struct FlarmNetFileHeader {
+  static constexpr uint32_t MAGIC = 0x54454e46; // "FNET"
+  static constexpr uint32_t VERSION = 2;
+
+  PackedLE32 magic;
+  PackedLE32 version;
+  PackedLE32 n_records;
+  PackedLE32 strings_size;
+
+  /**
+   * The size and modification time (microseconds since the epoch)
+   * of the text file this file was compiled from; see
+   * #FlarmNetFileSource.
+   */
+  PackedLE64 source_size, source_modified;
+};
+
+static_assert(sizeof(FlarmNetFileHeader) == 32, "Wrong size");
+
+/**
+ * Identifies the FlarmNet text file a compiled file was built from.
+ * A compiled file is only used if this matches the text file
+ * exactly.
+ */
+struct FlarmNetFileSource {
+  uint64_t size = 0;
+
+  /**
+   * The modification time in microseconds since the epoch.
+   */
+  uint64_t modified = 0;
+
+  constexpr bool operator==(const FlarmNetFileSource &) const noexcept = default;
+};
@@ -116,6 +116,7 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmNetDatabase &database)
     }
   }
 
+  database.Compile();
   return itemCount;
 }
 
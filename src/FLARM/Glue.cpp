@@ -23,9 +23,39 @@
 #include "Profile/Profile.hpp"
 #include "Profile/Keys.hpp"
 #include "time/PeriodClock.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
 
 /**
- * Loads the FLARMnet file
+ * Returns the path of the compiled copy of the given FLARMnet file
+ * in the cache directory.
+ */
+static AllocatedPath
+GetFLARMnetCachePath(Path path) noexcept
+{
+  return AllocatedPath::Build(GetCachePath(), path.GetBase()) + ".bin";
+}
+
+/**
+ * Returns the size and modification time of the given FLARMnet text
+ * file, which are stored in the compiled copy.
+ */
+static FlarmNetFileSource
+GetFLARMnetSource(Path path) noexcept
+{
+  const auto modified = File::GetLastModification(path).time_since_epoch();
+
+  return {
+    File::GetSize(path),
+    uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(modified).count()),
+  };
+}
+
+/**
+ * Loads the FLARMnet file.  The parsed database is saved in the
+ * compiled format, which is mapped directly on the next startup
+ * if the size and modification time of the text file are still the
+ * same.
  */
 static void
 LoadFLARMnet(FlarmNetDatabase &db) noexcept
@@ -35,9 +65,33 @@ try {
     return;
   }
 
+  const auto cache_path = GetFLARMnetCachePath(path);
+  const auto source = GetFLARMnetSource(path);
+  if (source.modified != 0 && File::Exists(cache_path)) {
+    try {
+      db.Load(cache_path);
+      if (db.GetSource() == source) {
+        LogFormat("FLARMnet IDs found: %u", unsigned(db.size()));
+        return;
+      }
+
+      db.Clear();
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+  }
+
   unsigned num_records = FlarmNetReader::LoadFile(path, db);
-  if (num_records > 0)
+  if (num_records > 0) {
     LogFormat("FLARMnet IDs found: %u", num_records);
+
+    try {
+      Directory::Create(GetCachePath());
+      db.Save(cache_path, source);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save FLARMnet cache");
+    }
+  }
 } catch (...) {
   LogError(std::current_exception());
 }
@@ -32,6 +32,26 @@ public:
     value = UNDEFINED_VALUE;
   }
 
+  /**
+   * Returns the raw value, e.g. for storing it in a binary file.
+   */
+  constexpr uint32_t GetValue() const noexcept {
+    return value;
+  }
+
+  static constexpr FlarmId FromValue(uint32_t value) noexcept {
+    return FlarmId(value);
+  }
+
+  /**
+   * Returns a hash of this id for open-addressing tables; the upper
+   * bits are the best distributed ones.
+   */
+  constexpr uint32_t Hash() const noexcept {
+    /* Fibonacci hashing: FLARM ids are often sequential */
+    return value * 0x9e3779b1u;
+  }
+
   friend constexpr auto operator<=>(const FlarmId &,
                                     const FlarmId &) noexcept = default;
 
@@ -3,9 +3,39 @@
 
 #include "List.hpp"
 
+void
+TrafficList::Rank() noexcept
+{
+  const unsigned n = list.size();
+  for (unsigned i = 0; i < n; ++i)
+    by_distance[i] = i;
+
+  std::sort(by_distance, by_distance + n, [this](uint8_t a, uint8_t b){
+    return list[a].distance < list[b].distance;
+  });
+
+  /* walking in distance order lets the nearer target win if the
+     alarm levels match */
+  maximum_alert = NO_INDEX;
+  for (unsigned i = 0; i < n; ++i) {
+    const uint8_t index = by_distance[i];
+    const FlarmTraffic &traffic = list[index];
+    if (traffic.HasAlarm() &&
+        (maximum_alert == NO_INDEX ||
+         (unsigned)traffic.alarm_level >
+         (unsigned)list[maximum_alert].alarm_level))
+      maximum_alert = index;
+  }
+
+  ranked = true;
+}
+
 const FlarmTraffic *
 TrafficList::FindMaximumAlert() const noexcept
 {
+  if (ranked)
+    return maximum_alert != NO_INDEX ? &list[maximum_alert] : NULL;
+
   const FlarmTraffic *alert = NULL;
 
   for (const auto &traffic : list)
@@ -24,6 +54,10 @@ TrafficList::FindMaximumAlert() const noexcept
 bool
 TrafficList::InCloseRange() const noexcept
 {
+  if (ranked)
+    return !list.empty() &&
+      list[by_distance[0]].distance < (RoughDistance)4000;
+
   return std::any_of(list.begin(), list.end(), [](const auto &traffic)
     { return traffic.distance < (RoughDistance)4000; });
 }
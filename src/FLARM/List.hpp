@@ -7,14 +7,47 @@
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <algorithm>
+#include <cstdint>
 #include <type_traits>
 
 /**
  * This class keeps track of the traffic objects received from a
- * FLARM.
+ * FLARM (including ADS-B targets relayed by it).
+ *
+ * Lookups by #FlarmId use an open-addressing hash table stored in
+ * this object, so it remains trivially copyable and can live in the
+ * blackboard.  FlarmComputer calls Rank() after each merge, which
+ * allows readers to obtain the most critical alert and the nearest
+ * targets without scanning the whole list.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The maximum number of targets.  This object is copied with each
+   * #MoreData blackboard, so don't make it larger than necessary.
+   */
+  static constexpr size_t MAX_COUNT = 50;
+
+  /**
+   * The number of bits of the id table size; it has at least twice
+   * as many slots as #MAX_COUNT, which keeps the probe sequences
+   * short.
+   */
+  static constexpr unsigned ID_TABLE_BITS = 7;
+  static constexpr size_t ID_TABLE_SIZE = size_t(1) << ID_TABLE_BITS;
+  static_assert(ID_TABLE_SIZE >= 2 * MAX_COUNT);
+
+  /**
+   * Marks an undefined #maximum_alert and a failed lookup.
+   */
+  static constexpr uint8_t NO_INDEX = 0xff;
+  static_assert(MAX_COUNT < NO_INDEX);
+
+  /**
+   * Marks an empty #id_table slot.  This is zero, so a
+   * zero-initialised table is a valid empty table.
+   */
+  static constexpr uint8_t EMPTY_SLOT = 0;
 
   /**
    * Time stamp of the latest modification to this object.
@@ -29,10 +62,36 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Maps the hash of a #FlarmId to an index in #list plus one
+   * (linear probing); #EMPTY_SLOT marks an empty slot.
+   */
+  uint8_t id_table[ID_TABLE_SIZE];
+
+  /**
+   * Indexes into #list, sorted by distance (nearest first).  Only
+   * valid if #ranked is set.
+   */
+  uint8_t by_distance[MAX_COUNT];
+
+  /**
+   * The index of the most critical alert, or #NO_INDEX.  Only valid
+   * if #ranked is set.
+   */
+  uint8_t maximum_alert;
+
+  /**
+   * Have #by_distance and #maximum_alert been calculated by Rank()
+   * after the last structural modification?
+   */
+  bool ranked;
+
   constexpr void Clear() noexcept {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    std::fill_n(id_table, ID_TABLE_SIZE, EMPTY_SLOT);
+    ranked = false;
   }
 
   constexpr bool IsEmpty() const noexcept {
@@ -54,13 +113,15 @@ struct TrafficList {
       /* don't bother merging the two lists, we can simply memcpy()
          it */
       list = add.list;
+      std::copy_n(add.id_table, ID_TABLE_SIZE, id_table);
+      ranked = false;
       return;
     }
 
     // Add unique traffic from 'add' list
     for (auto &traffic : add.list) {
       if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
+        FlarmTraffic *new_traffic = AllocateTraffic(traffic.id);
         if (new_traffic == nullptr)
           return;
         *new_traffic = traffic;
@@ -72,9 +133,16 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      RebuildIdTable();
   }
 
   constexpr unsigned GetActiveTrafficCount() const noexcept {
@@ -88,11 +156,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr FlarmTraffic *FindTraffic(FlarmId id) noexcept {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const uint8_t i = FindIndex(id);
+    return i != NO_INDEX ? &list[i] : NULL;
   }
 
   /**
@@ -102,11 +167,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr const FlarmTraffic *FindTraffic(FlarmId id) const noexcept {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const uint8_t i = FindIndex(id);
+    return i != NO_INDEX ? &list[i] : NULL;
   }
 
   /**
@@ -140,14 +202,25 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array and
+   * registers it with the given id.  The caller must make sure that
+   * the id is not yet in the list.
    *
-   * @return the FLARM_TRAFFIC pointer, NULL if the array is full
+   * @return the cleared FLARM_TRAFFIC pointer, NULL if the array is
+   * full
    */
-  constexpr FlarmTraffic *AllocateTraffic() noexcept {
-    return list.full()
-      ? NULL
-      : &list.append();
+  constexpr FlarmTraffic *AllocateTraffic(FlarmId id) noexcept {
+    if (list.full())
+      return NULL;
+
+    const uint8_t index = list.size();
+    FlarmTraffic &traffic = list.append();
+    traffic.Clear();
+    traffic.id = id;
+
+    InsertIndex(index);
+    ranked = false;
+    return &traffic;
   }
 
   /**
@@ -182,6 +255,13 @@ struct TrafficList {
     return list.empty() ? NULL : list.end() - 1;
   }
 
+  /**
+   * Sort the targets by distance and determine the most critical
+   * alert.  Must be called after #FlarmTraffic::distance has been
+   * updated; structural modifications invalidate the ranking.
+   */
+  void Rank() noexcept;
+
   /**
    * Finds the most critical alert.  Returns NULL if there is no
    * alert.
@@ -189,6 +269,20 @@ struct TrafficList {
   [[gnu::pure]]
   const FlarmTraffic *FindMaximumAlert() const noexcept;
 
+  /**
+   * Invoke the function for each target, nearest first if Rank()
+   * has been called, in list order otherwise.
+   */
+  template<typename F>
+  void ForEachByDistance(F &&f) const {
+    if (ranked)
+      for (unsigned i = 0; i < list.size(); ++i)
+        f(list[by_distance[i]]);
+    else
+      for (const auto &traffic : list)
+        f(traffic);
+  }
+
   constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
     return t - list.begin();
   }
@@ -196,7 +290,51 @@ struct TrafficList {
   /**
    * Is set if traffic is present and closer than 4Km.
    */
+  [[gnu::pure]]
   bool InCloseRange() const noexcept;
+
+private:
+  static constexpr unsigned GetIdSlot(FlarmId id) noexcept {
+    return id.Hash() >> (32 - ID_TABLE_BITS);
+  }
+
+  constexpr uint8_t FindIndex(FlarmId id) const noexcept {
+    unsigned slot = GetIdSlot(id);
+    for (unsigned n = 0; n < ID_TABLE_SIZE; ++n) {
+      const uint8_t value = id_table[slot];
+      if (value == EMPTY_SLOT)
+        break;
+
+      const uint8_t i = value - 1;
+      if (i < list.size() && list[i].id == id)
+        return i;
+
+      slot = (slot + 1) % ID_TABLE_SIZE;
+    }
+
+    return NO_INDEX;
+  }
+
+  constexpr void InsertIndex(uint8_t index) noexcept {
+    /* the table is never more than half full, so this always finds
+       an empty slot */
+    unsigned slot = GetIdSlot(list[index].id);
+    while (id_table[slot] != EMPTY_SLOT)
+      slot = (slot + 1) % ID_TABLE_SIZE;
+    id_table[slot] = index + 1;
+  }
+
+  /**
+   * Rebuild #id_table after items have been moved around in #list.
+   */
+  constexpr void RebuildIdTable() noexcept {
+    std::fill_n(id_table, ID_TABLE_SIZE, EMPTY_SLOT);
+
+    for (unsigned i = 0; i < list.size(); ++i)
+      InsertIndex(i);
+
+    ranked = false;
+  }
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
@@ -25,11 +25,7 @@ TrafficDatabases::FindNameById(FlarmId id) const noexcept
   }
 
   // try to find flarm from FlarmNet.org File
-  const FlarmNetRecord *record = flarm_net.FindRecordById(id);
-  if (record != nullptr)
-    return record->callsign;
-
-  return nullptr;
+  return flarm_net.FindCallSignById(id);
 }
 
 FlarmId
@@ -43,11 +39,7 @@ TrafficDatabases::FindIdByName(const char *name) const noexcept
     return id;
 
   // try to find flarm from FlarmNet.org File
-  const FlarmNetRecord *record = flarm_net.FindFirstRecordByCallSign(name);
-  if (record != NULL)
-    return record->id;
-
-  return FlarmId::Undefined();
+  return flarm_net.FindFirstIdByCallSign(name);
 }
 
 unsigned
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlightHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+static constexpr double MICRO_DEGREES = 1000000;
+
+FlightHistory::Packed
+FlightHistory::Pack(const Sample &sample) noexcept
+{
+  Packed p;
+  p.time = sample.time.count();
+  p.altitude = std::lround(sample.altitude * 10);
+  p.vario = std::lround(sample.vario * 100);
+  p.speed = std::lround(sample.speed * 100);
+
+  if (sample.location.IsValid()) {
+    p.latitude = std::lround(sample.location.latitude.Degrees() * MICRO_DEGREES);
+    p.longitude = std::lround(sample.location.longitude.Degrees() * MICRO_DEGREES);
+  } else {
+    /* out of range, see Unpack() */
+    p.latitude = 360 * MICRO_DEGREES;
+    p.longitude = 0;
+  }
+
+  return p;
+}
+
+FlightHistory::Sample
+FlightHistory::Unpack(const Packed &p) noexcept
+{
+  Sample sample;
+  sample.time = Duration(p.time);
+  sample.altitude = p.altitude / 10.;
+  sample.vario = p.vario / 100.;
+  sample.speed = p.speed / 100.;
+  sample.location = std::abs(p.latitude) <= 90 * MICRO_DEGREES
+    ? GeoPoint(Angle::Degrees(p.longitude / MICRO_DEGREES),
+               Angle::Degrees(p.latitude / MICRO_DEGREES))
+    : GeoPoint::Invalid();
+  return sample;
+}
+
+inline void
+FlightHistory::Include(Envelope &envelope, const Packed &p) noexcept
+{
+  envelope.altitude.Include(p.altitude / 10.);
+  envelope.vario.Include(p.vario / 100.);
+  envelope.speed.Include(p.speed / 100.);
+}
+
+static void
+EncodeDelta(std::vector<uint8_t> &data, int32_t value, int32_t previous)
+{
+  const int32_t delta = int32_t(uint32_t(value) - uint32_t(previous));
+  uint32_t zigzag = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+
+  while (zigzag >= 0x80) {
+    data.push_back(uint8_t(zigzag) | 0x80);
+    zigzag >>= 7;
+  }
+
+  data.push_back(uint8_t(zigzag));
+}
+
+std::size_t
+FlightHistory::GetMemoryUsage() const noexcept
+{
+  std::size_t size = blocks.capacity() * sizeof(blocks.front()) +
+    data.capacity() + current.capacity() * sizeof(current.front());
+
+  for (const auto &level : pyramid)
+    size += level.capacity() * sizeof(level.front());
+
+  return size;
+}
+
+void
+FlightHistory::Clear() noexcept
+{
+  blocks.clear();
+  data.clear();
+  pyramid.clear();
+  current.clear();
+  current_envelope = Envelope::Empty();
+}
+
+FlightHistory::Duration
+FlightHistory::GetFirstTime() const noexcept
+{
+  assert(!empty());
+
+  return Duration(blocks.empty()
+                  ? current.front().time
+                  : blocks.front().first.time);
+}
+
+FlightHistory::Duration
+FlightHistory::GetLastTime() const noexcept
+{
+  assert(!empty());
+
+  return Duration(current.empty()
+                  ? blocks.back().last_time
+                  : current.back().time);
+}
+
+void
+FlightHistory::Append(const Sample &sample) noexcept
+{
+  if (!empty() && sample.time <= GetLastTime())
+    return;
+
+  const Packed p = Pack(sample);
+
+  if (current.empty())
+    current.reserve(BLOCK_SIZE);
+
+  current.push_back(p);
+  Include(current_envelope, p);
+
+  if (current.size() == BLOCK_SIZE)
+    Flush();
+}
+
+void
+FlightHistory::Flush() noexcept
+{
+  assert(!current.empty());
+
+  Block &block = blocks.emplace_back();
+  block.first = current.front();
+  block.last_time = current.back().time;
+  block.n_samples = current.size();
+  block.offset = data.size();
+  block.envelope = current_envelope;
+
+  auto previous = current.front().ToArray();
+  for (auto i = std::next(current.begin()); i != current.end(); ++i) {
+    const auto value = i->ToArray();
+    for (unsigned column = 0; column < value.size(); ++column)
+      EncodeDelta(data, value[column], previous[column]);
+    previous = value;
+  }
+
+  current.clear();
+  current_envelope = Envelope::Empty();
+
+  /* update the pyramid: whenever a level gets an even number of
+     entries, the last pair is combined into the next level */
+  std::size_t n = blocks.size();
+  for (unsigned level = 0; n % 2 == 0; ++level, n /= 2) {
+    if (level == pyramid.size())
+      pyramid.emplace_back();
+
+    Envelope e = level == 0
+      ? blocks[n - 2].envelope
+      : pyramid[level - 1][n - 2];
+    e.Include(level == 0
+              ? blocks[n - 1].envelope
+              : pyramid[level - 1][n - 1]);
+    pyramid[level].push_back(e);
+  }
+}
+
+std::size_t
+FlightHistory::FindBlock(Duration time) const noexcept
+{
+  return std::partition_point(blocks.begin(), blocks.end(),
+                              [time](const Block &block){
+                                return block.last_time < int32_t(time.count());
+                              }) - blocks.begin();
+}
+
+FlightHistory::Envelope
+FlightHistory::GetBlocksEnvelope(std::size_t first,
+                                 std::size_t last) const noexcept
+{
+  assert(first <= last);
+  assert(last <= blocks.size());
+
+  Envelope result = Envelope::Empty();
+
+  /* walk up the pyramid like in a segment tree */
+  const auto get = [this](unsigned level, std::size_t i) -> const Envelope & {
+    return level == 0 ? blocks[i].envelope : pyramid[level - 1][i];
+  };
+
+  for (unsigned level = 0; first < last; ++level, first /= 2, last /= 2) {
+    if (first % 2 != 0)
+      result.Include(get(level, first++));
+
+    if (last % 2 != 0)
+      result.Include(get(level, --last));
+  }
+
+  return result;
+}
+
+FlightHistory::Envelope
+FlightHistory::GetEnvelope(Duration begin, Duration end) const noexcept
+{
+  Envelope result = Envelope::Empty();
+
+  const int32_t begin_time = begin.count(), end_time = end.count();
+  const auto include_partial = [&](std::size_t i){
+    DecodeBlock(i, [&](const Packed &p){
+      if (p.time >= begin_time && p.time <= end_time)
+        Include(result, p);
+    });
+  };
+
+  std::size_t first = FindBlock(begin);
+  std::size_t last = std::partition_point(blocks.begin() + first, blocks.end(),
+                                          [end_time](const Block &block){
+                                            return block.first.time <= end_time;
+                                          }) - blocks.begin();
+
+  if (first < last && blocks[first].first.time < begin_time)
+    include_partial(first++);
+
+  if (first < last && blocks[last - 1].last_time > end_time)
+    include_partial(--last);
+
+  result.Include(GetBlocksEnvelope(first, last));
+
+  if (!current.empty()) {
+    if (current.front().time >= begin_time && current.back().time <= end_time)
+      result.Include(current_envelope);
+    else
+      for (const auto &p : current)
+        if (p.time >= begin_time && p.time <= end_time)
+          Include(result, p);
+  }
+
+  return result;
+}
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A compact, time-indexed store of per-second flight samples for the
+ * analysis charts.
+ *
+ * Samples are collected in an uncompressed block; once it is full,
+ * it gets delta-encoded (zigzag varints) into a byte buffer.  Each
+ * block carries the minimum and maximum of all columns, and a
+ * pyramid of these envelopes allows determining the range of any
+ * time span with O(log n) block lookups, so charts can be scaled and
+ * drawn at any zoom level without decoding the whole flight.
+ */
+class FlightHistory {
+public:
+  using Duration = std::chrono::duration<uint32_t>;
+
+  struct Sample {
+    /** the flight time */
+    Duration time;
+
+    /** altitude [m] */
+    double altitude;
+
+    /** vertical speed [m/s] */
+    double vario;
+
+    /** ground speed [m/s] */
+    double speed;
+
+    GeoPoint location;
+  };
+
+  struct Range {
+    double min, max;
+
+    constexpr void Include(double value) noexcept {
+      if (value < min)
+        min = value;
+      if (value > max)
+        max = value;
+    }
+
+    constexpr void Include(const Range &other) noexcept {
+      if (other.min < min)
+        min = other.min;
+      if (other.max > max)
+        max = other.max;
+    }
+  };
+
+  /**
+   * The minimum/maximum of all numeric columns over a time span.
+   */
+  struct Envelope {
+    Range altitude, vario, speed;
+
+    /**
+     * Has at least one sample been included?
+     */
+    constexpr bool IsDefined() const noexcept {
+      return altitude.min <= altitude.max;
+    }
+
+    static constexpr Envelope Empty() noexcept {
+      constexpr Range EMPTY{1e99, -1e99};
+      return {EMPTY, EMPTY, EMPTY};
+    }
+
+    constexpr void Include(const Envelope &other) noexcept {
+      altitude.Include(other.altitude);
+      vario.Include(other.vario);
+      speed.Include(other.speed);
+    }
+  };
+
+  static constexpr unsigned BLOCK_SIZE = 256;
+
+private:
+  /**
+   * A sample in the fixed-point units stored in the blocks.
+   */
+  struct Packed {
+    /** seconds */
+    int32_t time;
+
+    /** decimetres */
+    int32_t altitude;
+
+    /** centimetres per second */
+    int32_t vario, speed;
+
+    /** micro degrees */
+    int32_t latitude, longitude;
+
+    static constexpr unsigned N_COLUMNS = 6;
+
+    constexpr std::array<int32_t, N_COLUMNS> ToArray() const noexcept {
+      return {time, altitude, vario, speed, latitude, longitude};
+    }
+
+    static constexpr Packed FromArray(const std::array<int32_t, N_COLUMNS> &a) noexcept {
+      return {a[0], a[1], a[2], a[3], a[4], a[5]};
+    }
+  };
+
+  struct Block {
+    /** the first sample, stored verbatim */
+    Packed first;
+
+    /** the last sample's time, for binary search */
+    int32_t last_time;
+
+    /** the number of samples */
+    uint16_t n_samples;
+
+    /** offset of the deltas of the 2nd and following samples in #data */
+    uint32_t offset;
+
+    Envelope envelope;
+  };
+
+  std::vector<Block> blocks;
+
+  /**
+   * Zigzag varint encoded deltas of all completed blocks.
+   */
+  std::vector<uint8_t> data;
+
+  /**
+   * Level 0 contains the envelopes of pairs of blocks, level 1 of
+   * pairs of level 0 entries and so on.
+   */
+  std::vector<std::vector<Envelope>> pyramid;
+
+  /**
+   * The samples not yet compressed.
+   */
+  std::vector<Packed> current;
+
+  Envelope current_envelope = Envelope::Empty();
+
+public:
+  bool empty() const noexcept {
+    return blocks.empty() && current.empty();
+  }
+
+  /**
+   * Returns the number of samples.
+   */
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return blocks.size() * BLOCK_SIZE + current.size();
+  }
+
+  /**
+   * Returns the approximate number of bytes allocated for the
+   * samples.
+   */
+  [[gnu::pure]]
+  std::size_t GetMemoryUsage() const noexcept;
+
+  void Clear() noexcept;
+
+  /**
+   * Append a sample.  Samples which are not newer than the previous
+   * one are ignored.
+   */
+  void Append(const Sample &sample) noexcept;
+
+  [[gnu::pure]]
+  Duration GetFirstTime() const noexcept;
+
+  [[gnu::pure]]
+  Duration GetLastTime() const noexcept;
+
+  /**
+   * Determine the minimum/maximum of all samples within the given
+   * (inclusive) time span.
+   */
+  [[gnu::pure]]
+  Envelope GetEnvelope(Duration begin, Duration end) const noexcept;
+
+  /**
+   * Invoke the function for each sample within the given
+   * (inclusive) time span, in chronological order.
+   */
+  template<typename F>
+  void ForEach(Duration begin, Duration end, F &&f) const {
+    for (std::size_t i = FindBlock(begin); i < blocks.size(); ++i) {
+      if (blocks[i].first.time > int32_t(end.count()))
+        return;
+
+      DecodeBlock(i, [&](const Packed &p){
+        if (p.time >= int32_t(begin.count()) && p.time <= int32_t(end.count()))
+          f(Unpack(p));
+      });
+    }
+
+    for (const auto &p : current)
+      if (p.time >= int32_t(begin.count()) && p.time <= int32_t(end.count()))
+        f(Unpack(p));
+  }
+
+private:
+  [[gnu::const]]
+  static Packed Pack(const Sample &sample) noexcept;
+
+  [[gnu::const]]
+  static Sample Unpack(const Packed &packed) noexcept;
+
+  static void Include(Envelope &envelope, const Packed &p) noexcept;
+
+  /**
+   * Compress #current into a new block.
+   */
+  void Flush() noexcept;
+
+  /**
+   * Returns the index of the first block which may contain samples
+   * at or after the given time.
+   */
+  [[gnu::pure]]
+  std::size_t FindBlock(Duration time) const noexcept;
+
+  /**
+   * Determine the envelope of the completed blocks [first, last).
+   */
+  [[gnu::pure]]
+  Envelope GetBlocksEnvelope(std::size_t first,
+                             std::size_t last) const noexcept;
+
+  template<typename F>
+  void DecodeBlock(std::size_t i, F &&f) const {
+    const Block &block = blocks[i];
+    auto value = block.first.ToArray();
+    f(block.first);
+
+    const uint8_t *p = data.data() + block.offset;
+    for (unsigned n = 1; n < block.n_samples; ++n) {
+      for (auto &column : value)
+        column = int32_t(uint32_t(column) + uint32_t(DecodeDelta(p)));
+      f(Packed::FromArray(value));
+    }
+  }
+
+  static int32_t DecodeDelta(const uint8_t *&p) noexcept {
+    uint32_t zigzag = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      const uint8_t byte = *p++;
+      zigzag |= uint32_t(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        break;
+    }
+
+    return int32_t(zigzag >> 1) ^ -int32_t(zigzag & 1);
+  }
+};
@@ -32,6 +32,7 @@ FlightStatistics::Reset() noexcept
   altitude_terrain.Reset();
   vario_circling_histogram.Reset(-7.5,7.5);
   vario_cruise_histogram.Reset(-7.5,7.5);
+  history.Clear();
 }
 
 void
@@ -189,3 +190,19 @@ FlightStatistics::GetVarioScaleNegative() const noexcept
   return std::min(vario_circling_histogram.GetPercentile(PERCENTILE_VARIO),
                   vario_cruise_histogram.GetPercentile(PERCENTILE_VARIO));
 }
+
+void
+FlightStatistics::AddHistorySample(const FloatDuration tflight,
+                                   const double alt, const double vario,
+                                   const double speed,
+                                   const GeoPoint &location) noexcept
+{
+  if (tflight.count() < 0)
+    return;
+
+  const std::lock_guard lock{mutex};
+  history.Append({
+      std::chrono::duration_cast<FlightHistory::Duration>(tflight),
+      alt, vario, speed, location,
+    });
+}
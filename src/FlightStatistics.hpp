@@ -6,6 +6,7 @@
 #include "Math/LeastSquares.hpp"
 #include "Math/ConvexFilter.hpp"
 #include "Math/Histogram.hpp"
+#include "FlightHistory.hpp"
 #include "thread/Mutex.hxx"
 #include "time/FloatDuration.hxx"
 
@@ -19,6 +20,12 @@ public:
   LeastSquares altitude_terrain;
   Histogram vario_circling_histogram;
   Histogram vario_cruise_histogram;
+
+  /**
+   * Per-second samples of the whole flight.
+   */
+  FlightHistory history;
+
   mutable Mutex mutex;
 
   void StartTask() noexcept;
@@ -48,6 +55,8 @@ public:
                          FloatDuration tflight_end, double v) noexcept;
   void AddClimbRate(FloatDuration tflight,
                     double vario, bool circling) noexcept;
+  void AddHistorySample(FloatDuration tflight, double alt, double vario,
+                        double speed, const GeoPoint &location) noexcept;
 
   void Reset() noexcept;
 };
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IGCFixTable.hpp"
+#include "IGCParser.hpp"
+#include "IGCFix.hpp"
+#include "IGCExtensions.hpp"
+#include "io/FileMapping.hpp"
+#include "system/Path.hpp"
+#include "util/SpanCast.hxx"
+#include "util/StringSplit.hxx"
+
+#include <algorithm>
+
+#include <string.h>
+
+/**
+ * A "B" record is 35 characters plus extensions; this is a rough
+ * estimate to reserve memory for all columns at once.
+ */
+static constexpr std::size_t ESTIMATED_LINE_LENGTH = 40;
+
+void
+IGCFixTable::Load(Path path)
+{
+  const FileMapping mapping(path);
+
+  clear();
+  Parse(ToStringView(std::span<const std::byte>{mapping}));
+}
+
+void
+IGCFixTable::clear() noexcept
+{
+  date = BrokenDate::Invalid();
+  date_records.clear();
+  times.clear();
+  locations.clear();
+  gps_altitudes.clear();
+  pressure_altitudes.clear();
+  gps_valid.clear();
+
+  for (auto &column : extensions)
+    column.clear();
+}
+
+void
+IGCFixTable::Parse(std::string_view contents) noexcept
+{
+  const std::size_t estimate = size() + contents.size() / ESTIMATED_LINE_LENGTH;
+  times.reserve(estimate);
+  locations.reserve(estimate);
+  gps_altitudes.reserve(estimate);
+  pressure_altitudes.reserve(estimate);
+  gps_valid.reserve(estimate);
+  for (auto &column : extensions)
+    column.reserve(estimate);
+
+  IGCExtensions igc_extensions;
+  igc_extensions.clear();
+
+  /* the parser functions need a null-terminated string; copy each
+     relevant line into this buffer (longer lines are truncated) */
+  char buffer[256];
+
+  while (!contents.empty()) {
+    auto [line, rest] = Split(contents, '\n');
+    contents = rest;
+
+    if (line.empty())
+      continue;
+
+    const char type = line.front();
+    if (type != 'B' && type != 'I' && type != 'H')
+      /* skip all other records without copying them */
+      continue;
+
+    if (line.back() == '\r')
+      line.remove_suffix(1);
+
+    const std::size_t length = std::min(line.size(), sizeof(buffer) - 1);
+    memcpy(buffer, line.data(), length);
+    buffer[length] = '\0';
+
+    switch (type) {
+    case 'B':
+      if (IGCFix fix; IGCParseFix(buffer, igc_extensions, fix))
+        Append(fix);
+      break;
+
+    case 'I':
+      IGCParseExtensions(buffer, igc_extensions);
+      break;
+
+    case 'H':
+      if (BrokenDate d; IGCParseDateRecord(buffer, d)) {
+        date_records.push_back({size(), d});
+        if (!date.IsPlausible())
+          date = d;
+      }
+      break;
+    }
+  }
+}
+
+void
+IGCFixTable::Append(const IGCFix &fix) noexcept
+{
+  times.push_back(fix.time.GetSecondOfDay());
+  locations.push_back(fix.location);
+  gps_altitudes.push_back(fix.gps_altitude);
+  pressure_altitudes.push_back(fix.pressure_altitude);
+  gps_valid.push_back(fix.gps_valid);
+
+  const int16_t values[] = {
+    fix.enl, fix.rpm, fix.hdm, fix.hdt, fix.trm,
+    fix.trt, fix.gsp, fix.ias, fix.tas, fix.siu,
+  };
+
+  static_assert(std::size(values) == std::size_t(Extension::COUNT));
+
+  for (std::size_t i = 0; i < std::size(values); ++i)
+    extensions[i].push_back(values[i]);
+}
+
+IGCFix
+IGCFixTable::GetFix(std::size_t i) const noexcept
+{
+  IGCFix fix;
+  fix.time = BrokenTime::FromSecondOfDay(times[i]);
+  fix.location = locations[i];
+  fix.gps_valid = gps_valid[i];
+  fix.gps_altitude = gps_altitudes[i];
+  fix.pressure_altitude = pressure_altitudes[i];
+
+  const auto e = [this, i](Extension x){
+    return extensions[std::size_t(x)][i];
+  };
+
+  fix.enl = e(Extension::ENL);
+  fix.rpm = e(Extension::RPM);
+  fix.hdm = e(Extension::HDM);
+  fix.hdt = e(Extension::HDT);
+  fix.trm = e(Extension::TRM);
+  fix.trt = e(Extension::TRT);
+  fix.gsp = e(Extension::GSP);
+  fix.ias = e(Extension::IAS);
+  fix.tas = e(Extension::TAS);
+  fix.siu = e(Extension::SIU);
+  return fix;
+}
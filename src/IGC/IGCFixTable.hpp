@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "time/BrokenDate.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class Path;
+struct IGCFix;
+
+/**
+ * All fixes ("B" records) of an IGC file, decoded in one pass into
+ * one array per column.  This is meant for tools which need the
+ * whole flight (replay, analysis, batch scoring); they can iterate
+ * over the columns without copying or re-parsing.
+ *
+ * Index #i of each column belongs to the same fix.
+ */
+class IGCFixTable {
+public:
+  /**
+   * The extension columns (see #IGCExtensions).  Values are negative
+   * if the extension is not present in the file.
+   */
+  enum class Extension : uint8_t {
+    ENL, RPM, HDM, HDT, TRM, TRT, GSP, IAS, TAS, SIU,
+    COUNT
+  };
+
+  /**
+   * A "HFDTE" record.  Some loggers write another one after
+   * midnight or when a new flight begins.
+   */
+  struct DateRecord {
+    /**
+     * The index of the first fix following this record.
+     */
+    std::size_t fix_index;
+
+    BrokenDate date;
+  };
+
+private:
+  /**
+   * The date from the first "HFDTE" record; invalid if there is
+   * none.
+   */
+  BrokenDate date = BrokenDate::Invalid();
+
+  /**
+   * All valid "HFDTE" records in file order.
+   */
+  std::vector<DateRecord> date_records;
+
+  /**
+   * Seconds since midnight UTC, exactly as in the file (i.e. without
+   * correcting midnight roll-overs).
+   */
+  std::vector<uint32_t> times;
+
+  std::vector<GeoPoint> locations;
+
+  std::vector<int32_t> gps_altitudes, pressure_altitudes;
+
+  std::vector<bool> gps_valid;
+
+  std::array<std::vector<int16_t>, std::size_t(Extension::COUNT)> extensions;
+
+public:
+  /**
+   * Load an IGC file.  The file is mapped into memory instead of
+   * being read line by line.
+   *
+   * Throws on I/O error.
+   */
+  void Load(Path path);
+
+  /**
+   * Parse the contents of an IGC file and append its fixes.
+   * Malformed records are skipped.
+   */
+  void Parse(std::string_view contents) noexcept;
+
+  void clear() noexcept;
+
+  [[gnu::pure]]
+  bool empty() const noexcept {
+    return times.empty();
+  }
+
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return times.size();
+  }
+
+  const BrokenDate &GetDate() const noexcept {
+    return date;
+  }
+
+  std::span<const DateRecord> GetDateRecords() const noexcept {
+    return date_records;
+  }
+
+  std::span<const uint32_t> GetTimes() const noexcept {
+    return times;
+  }
+
+  std::span<const GeoPoint> GetLocations() const noexcept {
+    return locations;
+  }
+
+  std::span<const int32_t> GetGPSAltitudes() const noexcept {
+    return gps_altitudes;
+  }
+
+  std::span<const int32_t> GetPressureAltitudes() const noexcept {
+    return pressure_altitudes;
+  }
+
+  [[gnu::pure]]
+  bool IsGPSValid(std::size_t i) const noexcept {
+    return gps_valid[i];
+  }
+
+  std::span<const int16_t> GetExtension(Extension e) const noexcept {
+    return extensions[std::size_t(e)];
+  }
+
+  /**
+   * Assemble all columns of one fix into an #IGCFix.
+   */
+  [[gnu::pure]]
+  IGCFix GetFix(std::size_t i) const noexcept;
+
+private:
+  void Append(const IGCFix &fix) noexcept;
+};
@@ -208,21 +208,97 @@ ParseExtensionValueN(const char *p, const char *end, size_t n,
     value_r = value;
 }
 
+/**
+ * Parse exactly #n decimal digits.
+ *
+ * @return the value, or -1 if one of the characters is not a digit
+ */
+static int
+ParseDigits(const char *p, unsigned n) noexcept
+{
+  int value = 0;
+
+  for (unsigned i = 0; i < n; ++i) {
+    if (!IsDigitASCII(p[i]))
+      return -1;
+
+    value = value * 10 + (p[i] - '0');
+  }
+
+  return value;
+}
+
+/**
+ * Parse a 5 character altitude field, which may begin with a minus
+ * sign.
+ */
+static bool
+ParseAltitude(const char *p, int &value) noexcept
+{
+  if (*p == '-') {
+    value = ParseDigits(p + 1, 4);
+    if (value < 0)
+      return false;
+
+    value = -value;
+    return true;
+  }
+
+  value = ParseDigits(p, 5);
+  return value >= 0;
+}
+
+/**
+ * Parse the validity character and the two altitudes of a "B"
+ * record.
+ */
+static bool
+ParseFixAltitudes(const char *buffer, char &valid_char,
+                  int &pressure_altitude, int &gps_altitude) noexcept
+{
+  valid_char = buffer[0];
+  if (ParseAltitude(buffer + 1, pressure_altitude) &&
+      ParseAltitude(buffer + 6, gps_altitude))
+    return true;
+
+  /* fall back to sscanf() for unusual formatting, e.g. spaces */
+  return sscanf(buffer, "%c%05d%05d",
+                &valid_char, &pressure_altitude, &gps_altitude) == 3;
+}
+
+/**
+ * Pack a 3 letter extension code into an integer, to allow using it
+ * in a switch statement.
+ */
+static constexpr uint_least32_t
+PackExtensionCode(const char *code) noexcept
+{
+  return (uint_least32_t(uint8_t(code[0])) << 16) |
+    (uint_least32_t(uint8_t(code[1])) << 8) |
+    uint_least32_t(uint8_t(code[2]));
+}
+
 bool
 IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
 {
   if (*buffer != 'B')
     return false;
 
+  /* a "B" record has at least 35 characters; this check allows
+     parsing fixed-width fields below without looking for the
+     terminator */
+  const size_t line_length = strlen(buffer);
+  if (line_length < 35)
+    return false;
+
   BrokenTime time;
   if (!IGCParseTime(buffer + 1, time))
     return false;
 
   char valid_char;
   int gps_altitude, pressure_altitude;
-
-  if (sscanf(buffer + 24, "%c%05d%05d",
-             &valid_char, &pressure_altitude, &gps_altitude) != 3)
+  if (!ParseFixAltitudes(buffer + 24, valid_char,
+                         pressure_altitude, gps_altitude))
     return false;
 
   if (valid_char == 'A')
@@ -242,7 +318,6 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
 
   fix.ClearExtensions();
 
-  const size_t line_length = strlen(buffer);
   for (auto i = extensions.begin(), end = extensions.end(); i != end; ++i) {
     const IGCExtension &extension = *i;
     assert(extension.start > 0);
@@ -255,26 +330,47 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
     const char *start = buffer + extension.start - 1;
     const char *finish = buffer + extension.finish;
 
-    if (StringIsEqual(extension.code, "ENL"))
+    switch (PackExtensionCode(extension.code)) {
+    case PackExtensionCode("ENL"):
       ParseExtensionValue(start, finish, fix.enl);
-    else if (StringIsEqual(extension.code, "RPM"))
+      break;
+
+    case PackExtensionCode("RPM"):
       ParseExtensionValue(start, finish, fix.rpm);
-    else if (StringIsEqual(extension.code, "HDM"))
+      break;
+
+    case PackExtensionCode("HDM"):
       ParseExtensionValue(start, finish, fix.hdm);
-    else if (StringIsEqual(extension.code, "HDT"))
+      break;
+
+    case PackExtensionCode("HDT"):
       ParseExtensionValue(start, finish, fix.hdt);
-    else if (StringIsEqual(extension.code, "TRM"))
+      break;
+
+    case PackExtensionCode("TRM"):
       ParseExtensionValue(start, finish, fix.trm);
-    else if (StringIsEqual(extension.code, "TRT"))
+      break;
+
+    case PackExtensionCode("TRT"):
       ParseExtensionValue(start, finish, fix.trt);
-    else if (StringIsEqual(extension.code, "GSP"))
+      break;
+
+    case PackExtensionCode("GSP"):
       ParseExtensionValueN(start, finish, 3, fix.gsp);
-    else if (StringIsEqual(extension.code, "IAS"))
+      break;
+
+    case PackExtensionCode("IAS"):
       ParseExtensionValueN(start, finish, 3, fix.ias);
-    else if (StringIsEqual(extension.code, "TAS"))
+      break;
+
+    case PackExtensionCode("TAS"):
       ParseExtensionValueN(start, finish, 3, fix.tas);
-    else if (StringIsEqual(extension.code, "SIU"))
+      break;
+
+    case PackExtensionCode("SIU"):
       ParseExtensionValue(start, finish, fix.siu);
+      break;
+    }
   }
 
   return true;
@@ -286,9 +382,23 @@ IGCParseLocation(const char *buffer, GeoPoint &location)
   unsigned lat_degrees, lat_minutes, lon_degrees, lon_minutes;
   char lat_char, lon_char;
 
-  if (sscanf(buffer, "%02u%05u%c%03u%05u%c",
-             &lat_degrees, &lat_minutes, &lat_char,
-             &lon_degrees, &lon_minutes, &lon_char) != 6)
+  /* fast path for the usual fixed-width format; the short-circuit
+     evaluation stops at the terminator of short strings */
+  int a, b, c, d;
+  if ((a = ParseDigits(buffer, 2)) >= 0 &&
+      (b = ParseDigits(buffer + 2, 5)) >= 0 &&
+      buffer[7] != '\0' &&
+      (c = ParseDigits(buffer + 8, 3)) >= 0 &&
+      (d = ParseDigits(buffer + 11, 5)) >= 0) {
+    lat_degrees = a;
+    lat_minutes = b;
+    lat_char = buffer[7];
+    lon_degrees = c;
+    lon_minutes = d;
+    lon_char = buffer[16];
+  } else if (sscanf(buffer, "%02u%05u%c%03u%05u%c",
+                    &lat_degrees, &lat_minutes, &lat_char,
+                    &lon_degrees, &lon_minutes, &lon_char) != 6)
     return false;
 
   if (lat_degrees >= 90 || lat_minutes >= 60000 ||
@@ -317,7 +427,15 @@ IGCParseTime(const char *buffer, BrokenTime &time)
 {
   unsigned hour, minute, second;
 
-  if (sscanf(buffer, "%02u%02u%02u", &hour, &minute, &second) != 3)
+  /* fast path for the usual fixed-width format */
+  int h, m, s;
+  if ((h = ParseTwoDigits(buffer)) >= 0 &&
+      (m = ParseTwoDigits(buffer + 2)) >= 0 &&
+      (s = ParseTwoDigits(buffer + 4)) >= 0) {
+    hour = h;
+    minute = m;
+    second = s;
+  } else if (sscanf(buffer, "%02u%02u%02u", &hour, &minute, &second) != 3)
     return false;
 
   time = BrokenTime(hour, minute, second);
@@ -1176,6 +1176,37 @@ static constexpr MetaData meta_data[] = {
 static_assert(ARRAY_SIZE(meta_data) == NUM_TYPES,
               "Wrong InfoBox factory size");
 
+/**
+ * The inputs of those InfoBox types which read nothing but a few
+ * #NMEAInfo attributes (and settings, which trigger a full update
+ * when they are modified).  All other types depend on
+ * #InfoBoxInputs::ALL.
+ */
+static constexpr struct {
+  Type type;
+  InfoBoxInputs::Mask inputs;
+} input_table[] = {
+  { e_HeightGPS, InfoBoxInputs::GPS_ALTITUDE },
+  { e_H_Baro, InfoBoxInputs::BARO },
+  { e_FlightLevel, InfoBoxInputs::BARO | InfoBoxInputs::GPS_ALTITUDE },
+  { e_Track_GPS, InfoBoxInputs::TRACK },
+  { e_AirSpeed_Ext, InfoBoxInputs::AIRSPEED },
+  { e_Speed, InfoBoxInputs::AIRSPEED },
+  { e_Load_G, InfoBoxInputs::ACCELERATION },
+  { e_TimeLocal, InfoBoxInputs::CLOCK },
+  { e_TimeUTC, InfoBoxInputs::CLOCK },
+  { e_Temperature, InfoBoxInputs::ATMOSPHERE },
+  { e_HumidityRel, InfoBoxInputs::ATMOSPHERE },
+  { e_NbrSat, InfoBoxInputs::GPS_STATUS },
+  { e_ActiveRadio, 0 },
+  { e_StandbyRadio, 0 },
+  { e_HeartRate, InfoBoxInputs::HEART_RATE },
+  { e_TransponderCode, 0 },
+  { e_EngineCHT, InfoBoxInputs::ENGINE },
+  { e_EngineEGT, InfoBoxInputs::ENGINE },
+  { e_EngineRPM, InfoBoxInputs::ENGINE },
+};
+
 const char *
 InfoBoxFactory::GetName(Type type) noexcept
 {
@@ -1206,6 +1237,18 @@ InfoBoxFactory::GetDescription(Type type) noexcept
   return meta_data[type].description;
 }
 
+InfoBoxInputs::Mask
+InfoBoxFactory::GetInputs(Type type) noexcept
+{
+  assert(type < NUM_TYPES);
+
+  for (const auto &i : input_table)
+    if (i.type == type)
+      return i.inputs;
+
+  return InfoBoxInputs::ALL;
+}
+
 std::unique_ptr<InfoBoxContent>
 InfoBoxFactory::Create(Type type) noexcept
 {
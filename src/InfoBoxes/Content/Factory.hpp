@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Type.hpp"
+#include "InfoBoxes/Inputs.hpp"
 
 #include <memory>
 class InfoBoxContent;
@@ -33,5 +34,13 @@ namespace InfoBoxFactory
   const char *
   GetDescription(Type type) noexcept;
 
+  /**
+   * Returns the blackboard inputs the info box type depends on (see
+   * #InfoBoxInputs).
+   */
+  [[gnu::const]]
+  InfoBoxInputs::Mask
+  GetInputs(Type type) noexcept;
+
   std::unique_ptr<InfoBoxContent> Create(Type infobox_type) noexcept;
 };
@@ -5,6 +5,7 @@
 #include "InfoBoxes/InfoBoxWindow.hpp"
 #include "InfoBoxes/InfoBoxLayout.hpp"
 #include "InfoBoxes/Content/Factory.hpp"
+#include "InfoBoxes/Inputs.hpp"
 #include "Language/Language.hpp"
 #include "Form/DataField/ComboList.hpp"
 #include "Dialogs/ComboPicker.hpp"
@@ -12,6 +13,7 @@
 #include "Profile/Current.hpp"
 #include "Interface.hpp"
 #include "UIState.hpp"
+#include "LogFile.hpp"
 
 namespace InfoBoxManager {
 
@@ -34,6 +36,19 @@ InfoBoxDrawIfDirty() noexcept;
 static bool infoboxes_dirty = false;
 static bool infoboxes_hidden = false;
 
+/**
+ * Shall all InfoBoxes be updated, not only those whose inputs have
+ * changed?  Set by InfoBoxManager::SetDirty().
+ */
+static bool infoboxes_force_update = false;
+
+/**
+ * The inputs of the previous DisplayInfoBox() call.
+ */
+static InfoBoxInputSnapshot last_inputs;
+
+static InfoBoxManager::Statistics statistics;
+
 static InfoBoxWindow *infoboxes[InfoBoxSettings::Panel::MAX_CONTENTS];
 
 // TODO locking
@@ -75,6 +90,21 @@ InfoBoxManager::DisplayInfoBox() noexcept
   const InfoBoxSettings::Panel &settings =
     CommonInterface::GetUISettings().info_boxes.panels[panel];
 
+  const ComputerSettings &settings_computer =
+    CommonInterface::GetComputerSettings();
+  const auto inputs =
+    InfoBoxInputSnapshot::Make(CommonInterface::Basic(),
+                               settings_computer.pressure_available
+                               ? settings_computer.pressure
+                               : AtmosphericPressure::Zero());
+
+  const InfoBoxInputs::Mask changed = first || infoboxes_force_update
+    ? InfoBoxInputs::ALL
+    : inputs.Compare(last_inputs) | InfoBoxInputs::OTHER;
+
+  last_inputs = inputs;
+  infoboxes_force_update = false;
+
   for (unsigned i = 0; i < layout.count; i++) {
     // All calculations are made in a separate thread. Slow calculations
     // should apply to the function DoCalculationsSlow()
@@ -92,7 +122,12 @@ InfoBoxManager::DisplayInfoBox() noexcept
       DisplayTypeLast[i] = DisplayType;
     }
 
-    infoboxes[i]->UpdateContent();
+    if (needupdate ||
+        (InfoBoxFactory::GetInputs(DisplayType) & changed) != 0) {
+      infoboxes[i]->UpdateContent();
+      ++statistics.updated;
+    } else
+      ++statistics.skipped;
   }
 
   first = false;
@@ -116,6 +151,19 @@ void
 InfoBoxManager::SetDirty() noexcept
 {
   infoboxes_dirty = true;
+  infoboxes_force_update = true;
+}
+
+void
+InfoBoxManager::ScheduleUpdate() noexcept
+{
+  infoboxes_dirty = true;
+}
+
+const InfoBoxManager::Statistics &
+InfoBoxManager::GetStatistics() noexcept
+{
+  return statistics;
 }
 
 void
@@ -176,6 +224,9 @@ InfoBoxManager::Create(ContainerWindow &parent,
 void
 InfoBoxManager::Destroy() noexcept
 {
+  LogFormat("InfoBox updates: %lu performed, %lu skipped",
+            statistics.updated, statistics.skipped);
+
   for (unsigned i = 0; i < layout.count; i++) {
     delete infoboxes[i];
     infoboxes[i] = NULL;
@@ -16,9 +16,38 @@ extern InfoBoxLayout::Layout layout;
 void
 ProcessTimer() noexcept;
 
+/**
+ * Update all InfoBoxes on the next ProcessTimer() call.  Call this
+ * after settings which may be shown in an InfoBox were modified.
+ */
 void
 SetDirty() noexcept;
 
+/**
+ * New data is available on the blackboard.  On the next
+ * ProcessTimer() call, only those InfoBoxes whose inputs (see
+ * #InfoBoxInputs) have changed will be updated.
+ */
+void
+ScheduleUpdate() noexcept;
+
+struct Statistics {
+  /**
+   * The number of InfoBoxContent::Update() calls.
+   */
+  unsigned long updated;
+
+  /**
+   * The number of updates which were skipped because the inputs of
+   * the InfoBox had not changed.
+   */
+  unsigned long skipped;
+};
+
+[[gnu::pure]]
+const Statistics &
+GetStatistics() noexcept;
+
 /**
  * Call after the UI language was switched (#ReadLanguageFile) so
  * captions and content use the new gettext catalogue on the next draw
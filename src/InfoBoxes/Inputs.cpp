@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Inputs.hpp"
+#include "NMEA/Info.hpp"
+
+/**
+ * Returns the value if it is available, std::nullopt otherwise.
+ */
+template<typename T>
+static constexpr std::optional<T>
+If(bool available, T value) noexcept
+{
+  if (!available)
+    return std::nullopt;
+
+  return value;
+}
+
+InfoBoxInputSnapshot
+InfoBoxInputSnapshot::Make(const NMEAInfo &basic,
+                           AtmosphericPressure qnh) noexcept
+{
+  const auto &engine = basic.engine;
+
+  InfoBoxInputSnapshot s;
+  s.second_of_day = If(basic.time_available,
+                       basic.date_time_utc.GetSecondOfDay());
+  s.gps_altitude = If(basic.gps_altitude_available, basic.gps_altitude);
+  s.baro_altitude = If(basic.baro_altitude_available, basic.baro_altitude);
+  s.pressure_altitude = If(basic.pressure_altitude_available,
+                           basic.pressure_altitude);
+  s.qnh = qnh;
+  s.track = If(basic.track_available, basic.track);
+  s.indicated_airspeed = If(basic.airspeed_available,
+                            basic.indicated_airspeed);
+  s.true_airspeed = If(basic.airspeed_available, basic.true_airspeed);
+  s.temperature = If(basic.temperature_available, basic.temperature);
+  s.humidity = If(basic.humidity_available, basic.humidity);
+  s.alive = basic.alive;
+  s.location_available = basic.location_available;
+  s.gps_altitude_available = basic.gps_altitude_available;
+  s.satellites_used = If(basic.gps.satellites_used_available,
+                         basic.gps.satellites_used);
+  s.heart_rate = If(basic.heart_rate_available, basic.heart_rate);
+  s.cht_temperature = If(engine.cht_temperature_available.IsValid(),
+                         engine.cht_temperature);
+  s.egt_temperature = If(engine.egt_temperature_available.IsValid(),
+                         engine.egt_temperature);
+  s.revolutions_per_second =
+    If(engine.revolutions_per_second_available.IsValid(),
+       engine.revolutions_per_second);
+  s.g_load = If(basic.acceleration.available, basic.acceleration.g_load);
+  return s;
+}
+
+InfoBoxInputs::Mask
+InfoBoxInputSnapshot::Compare(const InfoBoxInputSnapshot &other) const noexcept
+{
+  using namespace InfoBoxInputs;
+
+  Mask changed = 0;
+
+  if (second_of_day != other.second_of_day)
+    changed |= CLOCK;
+
+  if (gps_altitude != other.gps_altitude)
+    changed |= GPS_ALTITUDE;
+
+  if (baro_altitude != other.baro_altitude ||
+      pressure_altitude != other.pressure_altitude ||
+      qnh != other.qnh)
+    changed |= BARO;
+
+  if (track != other.track)
+    changed |= TRACK;
+
+  if (indicated_airspeed != other.indicated_airspeed ||
+      true_airspeed != other.true_airspeed)
+    changed |= AIRSPEED;
+
+  if (temperature != other.temperature || humidity != other.humidity)
+    changed |= ATMOSPHERE;
+
+  if (alive != other.alive ||
+      location_available != other.location_available ||
+      gps_altitude_available != other.gps_altitude_available ||
+      satellites_used != other.satellites_used)
+    changed |= GPS_STATUS;
+
+  if (heart_rate != other.heart_rate)
+    changed |= HEART_RATE;
+
+  if (cht_temperature != other.cht_temperature ||
+      egt_temperature != other.egt_temperature ||
+      revolutions_per_second != other.revolutions_per_second)
+    changed |= ENGINE;
+
+  if (g_load != other.g_load)
+    changed |= ACCELERATION;
+
+  return changed;
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Atmosphere/Pressure.hpp"
+#include "Atmosphere/Temperature.hpp"
+#include "Math/Angle.hpp"
+
+#include <cstdint>
+#include <optional>
+
+struct NMEAInfo;
+
+/**
+ * Bit masks describing which blackboard attributes an InfoBox
+ * content reads.  The #InfoBoxManager updates an InfoBox only if
+ * one of its inputs has changed since the previous update.
+ */
+namespace InfoBoxInputs {
+
+using Mask = uint_least16_t;
+
+/** NMEAInfo::date_time_utc */
+inline constexpr Mask CLOCK = 0x1;
+
+/** NMEAInfo::gps_altitude */
+inline constexpr Mask GPS_ALTITUDE = 0x2;
+
+/**
+ * NMEAInfo::baro_altitude, NMEAInfo::pressure_altitude and the QNH
+ * setting
+ */
+inline constexpr Mask BARO = 0x4;
+
+/** NMEAInfo::track */
+inline constexpr Mask TRACK = 0x8;
+
+/** NMEAInfo::indicated_airspeed, NMEAInfo::true_airspeed */
+inline constexpr Mask AIRSPEED = 0x10;
+
+/** NMEAInfo::temperature, NMEAInfo::humidity */
+inline constexpr Mask ATMOSPHERE = 0x20;
+
+/** GPS connection, fix and satellites */
+inline constexpr Mask GPS_STATUS = 0x40;
+
+/** NMEAInfo::heart_rate */
+inline constexpr Mask HEART_RATE = 0x80;
+
+/** NMEAInfo::engine */
+inline constexpr Mask ENGINE = 0x100;
+
+/** NMEAInfo::acceleration */
+inline constexpr Mask ACCELERATION = 0x200;
+
+/**
+ * Everything not covered by the other bits, most importantly
+ * #DerivedInfo.  This input is assumed to change on every
+ * calculation cycle.
+ */
+inline constexpr Mask OTHER = 0x8000;
+
+inline constexpr Mask ALL = ~Mask(0);
+
+} // namespace InfoBoxInputs
+
+/**
+ * A copy of the blackboard values covered by #InfoBoxInputs.
+ * Comparing two snapshots determines which inputs have changed.
+ *
+ * Each value is only present if it is available; a value which is
+ * updated by the device without changing does not count as a
+ * change.
+ */
+struct InfoBoxInputSnapshot {
+  std::optional<unsigned> second_of_day;
+
+  std::optional<double> gps_altitude;
+
+  std::optional<double> baro_altitude, pressure_altitude;
+  AtmosphericPressure qnh;
+
+  std::optional<Angle> track;
+
+  std::optional<double> indicated_airspeed, true_airspeed;
+
+  std::optional<Temperature> temperature;
+  std::optional<double> humidity;
+
+  bool alive, location_available, gps_altitude_available;
+  std::optional<int> satellites_used;
+
+  std::optional<unsigned> heart_rate;
+
+  std::optional<Temperature> cht_temperature, egt_temperature;
+  std::optional<float> revolutions_per_second;
+
+  std::optional<double> g_load;
+
+  /**
+   * @param qnh the QNH setting; AtmosphericPressure::Zero() if not
+   * available
+   */
+  [[gnu::pure]]
+  static InfoBoxInputSnapshot Make(const NMEAInfo &basic,
+                                   AtmosphericPressure qnh) noexcept;
+
+  /**
+   * Returns the mask of inputs which differ between the two
+   * snapshots.  This never includes #InfoBoxInputs::OTHER.
+   */
+  [[gnu::pure]]
+  InfoBoxInputs::Mask Compare(const InfoBoxInputSnapshot &other) const noexcept;
+};
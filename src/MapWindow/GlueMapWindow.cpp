@@ -101,14 +101,18 @@ GlueMapWindow::SetUIState(const UIState &new_value) noexcept
 void
 GlueMapWindow::ExchangeBlackboard() noexcept
 {
-  /* copy device_blackboard to MapWindow */
+  /* copy device_blackboard to MapWindow; skip the parts which have
+     not been modified since the last frame */
 
-  {
-    auto &device_blackboard = *backend_components->device_blackboard;
-    const std::lock_guard lock{device_blackboard.mutex};
-    ReadBlackboard(device_blackboard.Basic(),
-                   device_blackboard.Calculated());
-  }
+  auto &device_blackboard = *backend_components->device_blackboard;
+
+  if (const auto basic =
+      device_blackboard.basic_snapshot.GetModified(basic_serial))
+    ReadBlackboardBasic(*basic);
+
+  if (const auto calculated =
+      device_blackboard.calculated_snapshot.GetModified(calculated_serial))
+    ReadBlackboardCalculated(*calculated);
 
 #ifndef ENABLE_OPENGL
   {
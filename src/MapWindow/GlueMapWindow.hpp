@@ -5,6 +5,7 @@
 
 #include "MapWindow.hpp"
 #include "time/PeriodClock.hpp"
+#include "util/Serial.hpp"
 #include "UIUtil/TrackingGestureManager.hpp"
 #include "UIUtil/KineticManager.hpp"
 #include "Renderer/ThermalBandRenderer.hpp"
@@ -92,6 +93,12 @@ class GlueMapWindow : public MapWindow {
    */
   unsigned int bottom_margin = 0;
 
+  /**
+   * The DeviceBlackboard snapshot versions which were last copied by
+   * ExchangeBlackboard().
+   */
+  Serial basic_serial, calculated_serial;
+
 #ifndef ENABLE_OPENGL
   /**
    * This mutex protects the attributes that are read by the
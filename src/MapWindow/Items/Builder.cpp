@@ -73,9 +73,14 @@ MapItemListBuilder::AddSelfIfNear(const GeoPoint &self, Angle bearing)
 void
 MapItemListBuilder::AddWaypoints(const Waypoints &waypoints)
 {
-  waypoints.VisitWithinRange(location, range, [&list=list](const auto &w){
-    if (!list.full())
-      list.append(new WaypointMapItem(w));
+  /* nearest first: if the list overflows, the waypoints closest to
+     the click are kept */
+  waypoints.VisitNearest(location, range, [&list=list](const auto &w){
+    if (list.full())
+      return false;
+
+    list.append(new WaypointMapItem(w));
+    return true;
   });
 }
 
@@ -368,6 +368,12 @@ private:
    */
   void RenderAirspace(Canvas &canvas) noexcept;
 
+  /**
+   * Renders the airspace labels
+   * @param canvas The drawing canvas
+   */
+  void RenderAirspaceLabels(Canvas &canvas) noexcept;
+
   /**
    * Renders the NOAA stations
    * @param canvas The drawing canvas
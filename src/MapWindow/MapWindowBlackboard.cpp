@@ -59,8 +59,7 @@ UpdateFadingTraffic(bool fade_traffic,
 }
 
 void
-MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
-				    const DerivedInfo &derived_info) noexcept
+MapWindowBlackboard::ReadBlackboardBasic(const MoreData &nmea_info) noexcept
 {
   UpdateFadingTraffic(settings_map.fade_traffic,
                       fading_flarm_traffic, gps_info.flarm.traffic,
@@ -68,6 +67,5 @@ MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
                       nmea_info.clock);
 
   gps_info = nmea_info;
-  calculated_info = derived_info;
 }
 
@@ -77,7 +77,17 @@ protected:
   }
 
   void ReadBlackboard(const MoreData &nmea_info,
-                      const DerivedInfo &derived_info) noexcept;
+                      const DerivedInfo &derived_info) noexcept {
+    ReadBlackboardBasic(nmea_info);
+    ReadBlackboardCalculated(derived_info);
+  }
+
+  void ReadBlackboardBasic(const MoreData &nmea_info) noexcept;
+
+  void ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept {
+    calculated_info = derived_info;
+  }
+
   void ReadComputerSettings(const ComputerSettings &settings) noexcept;
   void ReadMapSettings(const MapSettings &settings) noexcept;
 
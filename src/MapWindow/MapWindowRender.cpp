@@ -112,13 +112,19 @@ MapWindow::RenderAirspace(Canvas &canvas) noexcept
                            Basic(), Calculated(),
                            GetComputerSettings().airspace,
                            GetMapSettings().airspace);
+  }
+}
 
+inline void
+MapWindow::RenderAirspaceLabels(Canvas &canvas) noexcept
+{
+  if (GetMapSettings().airspace.enable)
     airspace_label_renderer.Draw(canvas,
                                  render_projection,
                                  Basic(), Calculated(),
                                  GetComputerSettings().airspace,
-                                 GetMapSettings().airspace);
-  }
+                                 GetMapSettings().airspace,
+                                 label_block);
 }
 
 inline void
@@ -166,7 +172,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   const NMEAInfo &basic = Basic();
 
   // reset label over-write preventer
-  label_block.reset();
+  label_block.reset(rc.GetSize());
 
   render_projection = visible_projection;
 
@@ -237,6 +243,11 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   DrawThermalEstimate(canvas);
 
   //////////////////////////////////////////////// text items
+  // Waypoint labels have been placed already; airspace and
+  // topography labels only get the space which is still free
+  draw_sw.Mark("RenderAirspaceLabels");
+  RenderAirspaceLabels(canvas);
+
   // Render topography on top of airspace, to keep the text readable
   draw_sw.Mark("RenderTopographyLabels");
   RenderTopographyLabels(canvas);
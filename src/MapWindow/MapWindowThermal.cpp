@@ -53,6 +53,11 @@ MapWindow::DrawThermalEstimate(Canvas &canvas) const noexcept
                      calculated.wind_available
                      ? calculated.wind : SpeedVector::Zero());
 
+  /* climbs from earlier flights */
+  for (const auto &i : calculated.thermal_map.hotspots)
+    if (auto p = render_projection.GeoToScreenIfVisible(i.location))
+      look.thermal_source_icon.Draw(canvas, *p);
+
 #ifdef HAVE_SKYLINES_TRACKING
   const auto &cloud_settings = GetComputerSettings().tracking.skylines.cloud;
   if (cloud_settings.show_thermals && skylines_data != nullptr) {
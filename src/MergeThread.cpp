@@ -25,11 +25,23 @@ MergeThread::MergeThread(DeviceBlackboard &_device_blackboard,
    devices(_devices)
 {
   last_fix.Reset();
-  last_any.Reset();
+
+  auto initial = std::make_shared<MoreData>();
+  initial->Reset();
+  last_any = std::move(initial);
 }
 
 void
-MergeThread::Process() noexcept
+MergeThread::FirstRun() noexcept
+{
+  assert(!IsDefined());
+
+  Process(*device_blackboard.calculated_snapshot.Get());
+  device_blackboard.basic_snapshot.Publish(device_blackboard.Basic());
+}
+
+void
+MergeThread::Process(const DerivedInfo &calculated) noexcept
 {
   assert(!IsDefined() || IsInside());
 
@@ -40,8 +52,8 @@ MergeThread::Process() noexcept
     device_blackboard.GetComputerSettings();
 
   computer.Fill(device_blackboard.SetMoreData(), settings_computer);
-  computer.Compute(device_blackboard.SetMoreData(), last_any, last_fix,
-                   device_blackboard.Calculated());
+  computer.Compute(device_blackboard.SetMoreData(), *last_any, last_fix,
+                   calculated);
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
@@ -57,10 +69,15 @@ MergeThread::Tick() noexcept
   double vario;
 #endif
 
+  const auto calculated = device_blackboard.calculated_snapshot.Get();
+
+  /* the next version of last_any, which will also be published */
+  auto next = device_blackboard.basic_snapshot.Allocate();
+
   {
     const std::lock_guard lock{device_blackboard.mutex};
 
-    Process();
+    Process(*calculated);
 
     const MoreData &basic = device_blackboard.Basic();
 
@@ -69,13 +86,13 @@ MergeThread::Tick() noexcept
       devices->NotifySensorUpdate(basic);
 
     /* trigger update if gps has become available or dropped out */
-    gps_updated = last_any.location_available != basic.location_available;
+    gps_updated = last_any->location_available != basic.location_available;
 
     /* trigger a redraw when the connection was just lost, to show the
        new state; when no GPS is connected, no other entity triggers
        the redraw, so we have to do it */
-    calculated_updated = (bool)last_any.alive != (bool)basic.alive ||
-      (bool)last_any.location_available != (bool)basic.location_available;
+    calculated_updated = (bool)last_any->alive != (bool)basic.alive ||
+      (bool)last_any->location_available != (bool)basic.location_available;
 
 #ifdef HAVE_PCM_PLAYER
     vario_available = basic.brutto_vario_available;
@@ -83,7 +100,7 @@ MergeThread::Tick() noexcept
 #endif
 
     /* update last_any in every iteration */
-    last_any = basic;
+    *next = basic;
 
     /* update last_fix only when a new GPS fix was received */
     if ((basic.time_available &&
@@ -92,6 +109,11 @@ MergeThread::Tick() noexcept
       last_fix = basic;
   }
 
+  /* publish the new last_any without holding the lock; the old one
+     is released first, so it can be recycled */
+  last_any = next;
+  device_blackboard.basic_snapshot.PublishAllocated(std::move(next));
+
 #ifdef HAVE_PCM_PLAYER
   if (vario_available)
     AudioVarioGlue::SetValue(vario);
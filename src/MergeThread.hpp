@@ -8,6 +8,9 @@
 #include "FLARM/Computer.hpp"
 #include "NMEA/MoreData.hpp"
 
+#include <memory>
+
+struct DerivedInfo;
 class DeviceBlackboard;
 class MultipleDevices;
 
@@ -28,9 +31,10 @@ class MergeThread final : public WorkerThread {
 
   /**
    * The previous values at the time of the last update of any
-   * attribute (last Connected modification).
+   * attribute (last Connected modification).  This is the version
+   * most recently published to DeviceBlackboard::basic_snapshot.
    */
-  MoreData last_any;
+  std::shared_ptr<const MoreData> last_any;
 
   BasicComputer computer;
   FlarmComputer flarm_computer;
@@ -43,11 +47,7 @@ public:
    * This method is called during XCSoar startup, for the initial run
    * of the MergeThread.
    */
-  void FirstRun() noexcept {
-    assert(!IsDefined());
-
-    Process();
-  }
+  void FirstRun() noexcept;
 
   /**
    * Throws on error.
@@ -58,7 +58,7 @@ public:
   }
 
 private:
-  void Process() noexcept;
+  void Process(const DerivedInfo &calculated) noexcept;
 
 protected:
   void Tick() noexcept override;
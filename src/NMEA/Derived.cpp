@@ -67,6 +67,7 @@ DerivedInfo::Reset()
   thermal_encounter_collection.Reset();
 
   thermal_locator.Clear();
+  thermal_map.Clear();
 
   trace_history.clear();
 
@@ -15,6 +15,7 @@
 #include "Engine/ThermalBand/ThermalEncounterBand.hpp"
 #include "Engine/ThermalBand/ThermalEncounterCollection.hpp"
 #include "NMEA/ThermalLocator.hpp"
+#include "NMEA/ThermalMapInfo.hpp"
 #include "NMEA/Validity.hpp"
 #include "NMEA/ClimbHistory.hpp"
 #include "TeamCode/TeamCode.hpp"
@@ -219,6 +220,9 @@ struct DerivedInfo:
 
   ThermalLocatorInfo thermal_locator;
 
+  /** Climbs from earlier flights near the aircraft */
+  ThermalMapInfo thermal_map;
+
   /** Store of short term history of variables */
   TraceHistory trace_history;
 
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "util/TrivialArray.hxx"
+
+#include <type_traits>
+
+/**
+ * A climb from an earlier flight which is close to the aircraft.
+ */
+struct ThermalMapHotspot {
+  /** The location where the climb started */
+  GeoPoint location;
+
+  /** Average climb rate [m/s] */
+  double lift;
+};
+
+/**
+ * The best climbs from the #ThermalMap around the aircraft, recorded
+ * at a similar time of day and with similar wind.
+ */
+struct ThermalMapInfo {
+  static constexpr unsigned MAX_HOTSPOTS = 16;
+
+  TrivialArray<ThermalMapHotspot, MAX_HOTSPOTS> hotspots;
+
+  void Clear() noexcept {
+    hotspots.clear();
+  }
+};
+
+static_assert(std::is_trivial<ThermalMapInfo>::value,
+              "type is not trivial");
@@ -16,6 +16,7 @@
 #include "InfoBoxes/InfoBoxManager.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "BallastDumpManager.hpp"
+#include "Profile/Profile.hpp"
 #include "Operation/Operation.hpp"
 #include "Tracking/TrackingGlue.hpp"
 #include "net/client/tim/Glue.hpp"
@@ -164,6 +165,7 @@ SettingsProcessTimer() noexcept
 {
   BallastDumpProcessTimer();
   ProcessAutoBugs();
+  Profile::ProcessScheduledSave();
 }
 
 static void
@@ -14,7 +14,7 @@ ProfileMap::Set(std::string_view key, const char *value) noexcept
       /* not modified, don't set the "modified" flag */
       return;
 
-    i->second.assign(value);
+    i->second.Assign(value);
   } else {
     map.emplace_hint(i, key, value);
   }
@@ -21,7 +21,78 @@ template<typename T> class StringPointer;
 template<typename T> class BasicAllocatedString;
 
 class ProfileMap {
-  std::map<std::string, std::string, std::less<>> map;
+public:
+  /**
+   * A value in the profile.  The string is what gets loaded and
+   * saved; its numeric conversions are parsed once when the string is
+   * assigned, because many settings are read more often than they are
+   * written.  Reading a #Value does not modify it, so concurrent
+   * readers are safe as long as nobody writes.
+   */
+  class Value {
+    std::string value;
+
+    /**
+     * Did the respective conversion succeed?
+     */
+    bool int_valid, unsigned_valid, double_valid;
+
+    int int_value;
+    unsigned unsigned_value;
+    double double_value;
+
+  public:
+    explicit Value(const char *_value) noexcept
+      :value(_value) {
+      Parse();
+    }
+
+    const char *c_str() const noexcept {
+      return value.c_str();
+    }
+
+    bool operator==(const char *other) const noexcept {
+      return value == other;
+    }
+
+    /**
+     * Replace the string and update the numeric conversions.
+     */
+    void Assign(const char *_value) noexcept {
+      value.assign(_value);
+      Parse();
+    }
+
+    bool GetInt(int &result) const noexcept {
+      if (!int_valid)
+        return false;
+
+      result = int_value;
+      return true;
+    }
+
+    bool GetUnsigned(unsigned &result) const noexcept {
+      if (!unsigned_valid)
+        return false;
+
+      result = unsigned_value;
+      return true;
+    }
+
+    bool GetDouble(double &result) const noexcept {
+      if (!double_valid)
+        return false;
+
+      result = double_value;
+      return true;
+    }
+
+  private:
+    void Parse() noexcept;
+  };
+
+private:
+  std::map<std::string, Value, std::less<>> map;
 
   bool modified = false;
 
@@ -87,6 +158,15 @@ public:
 
   void Set(std::string_view key, const char *value) noexcept;
 
+private:
+  [[gnu::pure]]
+  const Value *Find(std::string_view key) const noexcept {
+    const auto i = map.find(key);
+    return i != map.end() ? &i->second : nullptr;
+  }
+
+public:
+
   // char string values
 
   /**
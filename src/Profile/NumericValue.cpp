@@ -4,40 +4,36 @@
 #include "Map.hpp"
 #include "util/NumberParser.hpp"
 
-bool
-ProfileMap::Get(std::string_view key, int &value) const noexcept
+void
+ProfileMap::Value::Parse() noexcept
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a number
+  const char *str = value.c_str();
   char *endptr;
-  int tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
-    return false;
 
-  // Save parsed value to output parameter value and return success
-  value = tmp;
-  return true;
+  int_value = ParseInt(str, &endptr, 0);
+  int_valid = endptr != str;
+
+  unsigned_value = ParseUnsigned(str, &endptr, 0);
+  unsigned_valid = endptr != str;
+
+  double_value = ParseDouble(str, &endptr);
+  double_valid = endptr != str;
 }
 
 bool
-ProfileMap::Get(std::string_view key, short &value) const noexcept
+ProfileMap::Get(std::string_view key, int &value) const noexcept
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
+  const Value *v = Find(key);
+  return v != nullptr && v->GetInt(value);
+}
 
-  // Parse the string for a number
-  char *endptr;
-  short tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
+bool
+ProfileMap::Get(std::string_view key, short &value) const noexcept
+{
+  int tmp;
+  if (!Get(key, tmp))
     return false;
 
-  // Save parsed value to output parameter value and return success
   value = tmp;
   return true;
 }
@@ -58,20 +54,8 @@ ProfileMap::Get(std::string_view key, bool &value) const noexcept
 bool
 ProfileMap::Get(std::string_view key, unsigned &value) const noexcept
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a unsigned number
-  char *endptr;
-  unsigned tmp = ParseUnsigned(str, &endptr, 0);
-  if (endptr == str)
-    return false;
-
-  // Save parsed value to output parameter value and return success
-  value = tmp;
-  return true;
+  const Value *v = Find(key);
+  return v != nullptr && v->GetUnsigned(value);
 }
 
 bool
@@ -99,20 +83,8 @@ ProfileMap::Get(std::string_view key, uint8_t &value) const noexcept
 bool
 ProfileMap::Get(std::string_view key, double &value) const noexcept
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a floating point number
-  char *endptr;
-  double tmp = ParseDouble(str, &endptr);
-  if (endptr == str)
-    return false;
-
-  // Save parsed value to output parameter value and return success
-  value = tmp;
-  return true;
+  const Value *v = Find(key);
+  return v != nullptr && v->GetDouble(value);
 }
 
 void
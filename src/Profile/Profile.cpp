@@ -15,6 +15,8 @@
 #include "util/StringCompare.hxx"
 #include "util/StringUtil.hpp"
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <cassert>
 #include <windef.h> /* for MAX_PATH */
@@ -24,6 +26,18 @@
 
 static AllocatedPath startProfileFile = nullptr;
 
+/**
+ * How long does ScheduleSave() wait before writing the file?
+ */
+static constexpr std::chrono::steady_clock::duration SAVE_DELAY =
+  std::chrono::seconds{2};
+
+/**
+ * When shall the scheduled save be performed?  Empty if no save is
+ * scheduled.
+ */
+static std::optional<std::chrono::steady_clock::time_point> save_deadline;
+
 Path
 Profile::GetPath() noexcept
 {
@@ -54,6 +68,8 @@ Profile::LoadFile(Path path) noexcept
 void
 Profile::Save() noexcept
 {
+  save_deadline.reset();
+
   if (!IsModified())
     return;
 
@@ -70,6 +86,20 @@ Profile::Save() noexcept
   }
 }
 
+void
+Profile::ScheduleSave() noexcept
+{
+  if (!save_deadline)
+    save_deadline = std::chrono::steady_clock::now() + SAVE_DELAY;
+}
+
+void
+Profile::ProcessScheduledSave() noexcept
+{
+  if (save_deadline && std::chrono::steady_clock::now() >= *save_deadline)
+    Save();
+}
+
 void
 Profile::SaveFile(Path path)
 {
@@ -43,6 +43,22 @@ LoadFile(Path path) noexcept;
 void
 Save() noexcept;
 
+/**
+ * Save the profile a few seconds from now.  Use this instead of
+ * Save() where the profile may be modified several times in a row;
+ * all of these modifications are written to the file at once.
+ * Shutdown calls Save(), which performs a pending save immediately.
+ */
+void
+ScheduleSave() noexcept;
+
+/**
+ * Perform the save requested by ScheduleSave() if it is due.  This
+ * is called periodically by the main thread.
+ */
+void
+ProcessScheduledSave() noexcept;
+
 /**
  * Saves the profile into the given profile file
  */
@@ -4,6 +4,7 @@
 #include "Projection.hpp"
 #include "Geo/FAISphere.hpp"
 #include "Math/Angle.hpp"
+#include "Math/FastTrig.hpp"
 
 #include <algorithm>
 
@@ -53,6 +54,62 @@ Projection::GeoToScreen(const GeoPoint &g) const noexcept
   return sc;
 }
 
+void
+Projection::GeoToScreen(std::span<const Angle> latitudes,
+                        std::span<const Angle> longitudes,
+                        std::span<PixelPoint> dest) const noexcept
+{
+  assert(IsValid());
+  assert(longitudes.size() == latitudes.size());
+  assert(dest.size() == latitudes.size());
+
+  /* the points are converted in chunks; the temporary arrays are
+     small enough to stay in the L1 cache */
+  constexpr std::size_t CHUNK = 256;
+  double dx[CHUNK], dy[CHUNK], cosine[CHUNK];
+  unsigned cosine_index[CHUNK];
+
+  const double origin_latitude = geo_location.latitude.Native();
+  const double origin_longitude = geo_location.longitude.Native();
+  const double half_circle = Angle::HalfCircle().Native();
+  const double quarter_circle = Angle::QuarterCircle().Native();
+  const double full_circle = Angle::FullCircle().Native();
+
+  for (std::size_t offset = 0; offset < latitudes.size(); offset += CHUNK) {
+    const std::size_t n = std::min(CHUNK, latitudes.size() - offset);
+    const Angle *lat = latitudes.data() + offset;
+    const Angle *lon = longitudes.data() + offset;
+
+    /* pass 1 (vectorisable): the deltas in pixels and the sine table
+       index, with the same normalisation as GeoPoint::operator-() */
+    for (std::size_t i = 0; i < n; ++i) {
+      double dlon = origin_longitude - lon[i].Native();
+      dlon += full_circle * (dlon <= -half_circle);
+      dlon -= full_circle * (dlon > half_circle);
+
+      const double dlat = std::clamp(origin_latitude - lat[i].Native(),
+                                     -quarter_circle, quarter_circle);
+
+      dx[i] = dlon * draw_scale;
+      dy[i] = dlat * draw_scale;
+      cosine_index[i] = NATIVE_TO_INT_COS(lat[i].Native());
+    }
+
+    /* pass 2: the table lookup of fastcosine() */
+    for (std::size_t i = 0; i < n; ++i)
+      cosine[i] = SINETABLE[cosine_index[i]];
+
+    /* pass 3 (vectorisable): integer rotation */
+    PixelPoint *out = dest.data() + offset;
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto p = screen_rotation.Rotate(PixelPoint(int(cosine[i] * dx[i]),
+                                                       int(dy[i])));
+      out[i].x = screen_origin.x - p.x;
+      out[i].y = screen_origin.y + p.y;
+    }
+  }
+}
+
 void
 Projection::SetScale(const double _scale) noexcept
 {
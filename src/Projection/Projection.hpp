@@ -9,6 +9,7 @@
 #include "ui/dim/Point.hpp"
 
 #include <cassert>
+#include <span>
 
 /**
  * This is a class that can be used for converting geographical into screen
@@ -119,6 +120,21 @@ public:
   [[gnu::pure]]
   PixelPoint GeoToScreen(const GeoPoint &g) const noexcept;
 
+  /**
+   * Converts many points to screen coordinates at once.  The result
+   * is the same as calling GeoToScreen() for each point, but the
+   * separate latitude/longitude arrays allow the compiler to
+   * vectorise most of the work.
+   *
+   * @param latitudes the latitudes of all points
+   * @param longitudes the normalised longitudes of all points
+   * (same size as #latitudes)
+   * @param dest the destination buffer (same size as #latitudes)
+   */
+  void GeoToScreen(std::span<const Angle> latitudes,
+                   std::span<const Angle> longitudes,
+                   std::span<PixelPoint> dest) const noexcept;
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
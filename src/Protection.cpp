@@ -92,7 +92,7 @@ CreateCalculationThread() noexcept
   glide_computer.ProcessGPS(true);
 
   /* copy GlideComputer results to DeviceBlackboard */
-  device_blackboard.ReadBlackboard(glide_computer.Calculated());
+  device_blackboard.calculated_snapshot.Publish(glide_computer.Calculated());
 
   backend_components->calculation_thread = std::make_unique<CalculationThread>(device_blackboard, glide_computer);
   backend_components->calculation_thread->SetComputerSettings(CommonInterface::GetComputerSettings());
@@ -3,6 +3,7 @@
 
 #include "AirspaceLabelRenderer.hpp"
 #include "AirspaceRendererSettings.hpp"
+#include "LabelBlock.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Look/AirspaceLook.hpp"
 #include "Airspace/Airspaces.hpp"
@@ -41,7 +42,8 @@ AirspaceLabelRenderer::Draw(Canvas &canvas,
                             const WindowProjection &projection,
                             const MoreData &basic, const DerivedInfo &calculated,
                             const AirspaceComputerSettings &computer_settings,
-                            const AirspaceRendererSettings &settings) noexcept
+                            const AirspaceRendererSettings &settings,
+                            LabelBlock &label_block) noexcept
 {
   if (settings.label_selection != AirspaceRendererSettings::LabelSelection::ALL ||
       airspaces == nullptr || airspaces->IsEmpty())
@@ -56,14 +58,16 @@ AirspaceLabelRenderer::Draw(Canvas &canvas,
                                    aircraft, awc);
 
   DrawInternal(canvas,
-               projection, visible, computer_settings.warnings);
+               projection, visible, computer_settings.warnings,
+               label_block);
 }
 
 inline void
 AirspaceLabelRenderer::DrawInternal(Canvas &canvas,
                                     const WindowProjection &projection,
                                     AirspacePredicate visible,
-                                    const AirspaceWarningConfig &config) noexcept
+                                    const AirspaceWarningConfig &config,
+                                    LabelBlock &label_block) noexcept
 {
   AirspaceLabelList labels;
   for (const auto &i : airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
@@ -85,13 +89,14 @@ AirspaceLabelRenderer::DrawInternal(Canvas &canvas,
 
   // draw
   for (const auto &label : labels)
-    DrawLabel(canvas, projection, label);
+    DrawLabel(canvas, projection, label, label_block);
 }
 
 inline void
 AirspaceLabelRenderer::DrawLabel(Canvas &canvas,
                                  const WindowProjection &projection,
-                                 const AirspaceLabelList::Label &label) noexcept
+                                 const AirspaceLabelList::Label &label,
+                                 LabelBlock &label_block) noexcept
 {
   char topText[NAME_SIZE + 1];
   AirspaceFormatter::FormatAltitudeShort(topText, label.top, false);
@@ -113,6 +118,10 @@ AirspaceLabelRenderer::DrawLabel(Canvas &canvas,
   rect.top = pos.y;
   rect.right = rect.left + labelWidth;
   rect.bottom = rect.top + labelHeight;
+
+  if (!label_block.check(rect))
+    return;
+
   canvas.DrawRectangle(rect);
 
 #ifdef USE_GDI
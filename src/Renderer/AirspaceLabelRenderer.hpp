@@ -16,6 +16,7 @@ class Airspaces;
 class ProtectedAirspaceWarningManager;
 class Canvas;
 class WindowProjection;
+class LabelBlock;
 
 class AirspaceLabelRenderer
 {
@@ -56,18 +57,23 @@ private:
   void DrawInternal(Canvas &canvas,
                     const WindowProjection &projection,
                     AirspacePredicate visible,
-                    const AirspaceWarningConfig &config) noexcept;
+                    const AirspaceWarningConfig &config,
+                    LabelBlock &label_block) noexcept;
 
   void DrawLabel(Canvas &canvas, const WindowProjection &projection,
-                 const AirspaceLabelList::Label &label) noexcept;
+                 const AirspaceLabelList::Label &label,
+                 LabelBlock &label_block) noexcept;
 
 public:
    /**
    * Draw labels that are visible according to standard rules.
+   * Labels which overlap with one already registered in the
+   * #LabelBlock are skipped.
    */
   void Draw(Canvas &canvas,
             const WindowProjection &projection,
             const MoreData &basic, const DerivedInfo &calculated,
             const AirspaceComputerSettings &computer_settings,
-            const AirspaceRendererSettings &settings) noexcept;
+            const AirspaceRendererSettings &settings,
+            LabelBlock &label_block) noexcept;
 };
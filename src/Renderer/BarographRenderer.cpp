@@ -15,6 +15,65 @@
 #include "Engine/Task/TaskManager.hpp"
 #include "TaskLegRenderer.hpp"
 #include "GradientRenderer.hpp"
+#include "thread/Mutex.hxx"
+
+#include <algorithm>
+#include <vector>
+
+static constexpr double
+ToHours(FlightHistory::Duration t) noexcept
+{
+  return std::chrono::duration<double, std::chrono::hours::period>(t).count();
+}
+
+/**
+ * Scale the chart to the time span and the altitude range of the
+ * whole #FlightHistory.
+ */
+static void
+ScaleFromHistory(ChartRenderer &chart, const FlightHistory &history) noexcept
+{
+  const auto first = history.GetFirstTime(), last = history.GetLastTime();
+  const auto envelope = history.GetEnvelope(first, last);
+
+  chart.ScaleXFromValue(ToHours(first));
+  chart.ScaleXFromValue(ToHours(last));
+  chart.ScaleYFromValue(envelope.altitude.min);
+  chart.ScaleYFromValue(envelope.altitude.max);
+}
+
+/**
+ * Draw the altitude from the #FlightHistory, using at most one
+ * sample per pixel column.
+ *
+ * @return the last point which was drawn
+ */
+static DoublePoint2D
+DrawAltitudeHistory(ChartRenderer &chart, const FlightHistory &history,
+                    ChartLook::Style style) noexcept
+{
+  const auto first = history.GetFirstTime(), last = history.GetLastTime();
+  const unsigned width = std::max(chart.GetChartRect().GetWidth(), 1U);
+  const auto step = std::max((last - first) / width,
+                             FlightHistory::Duration{1});
+
+  std::vector<DoublePoint2D> points;
+  points.reserve((last - first) / step + 2);
+
+  auto next = first;
+  history.ForEach(first, last, [&](const FlightHistory::Sample &sample){
+    if (sample.time < next && sample.time != last)
+      return;
+
+    points.push_back({ToHours(sample.time), sample.altitude});
+    next = sample.time + step;
+  });
+
+  if (points.size() >= 2)
+    chart.DrawLineGraph(points, style);
+
+  return points.back();
+}
 
 void
 BarographCaption(char *sTmp, const FlightStatistics &fs)
@@ -54,37 +113,43 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
   ChartRenderer chart(chart_look, canvas, rc, false);
   chart.Begin();
 
-  if (!fs.altitude.HasResult())
+  if (fs.history.size() < 2)
     return;
 
-  chart.ScaleXFromData(fs.altitude);
-  chart.ScaleYFromData(fs.altitude);
+  ScaleFromHistory(chart, fs.history);
   chart.ScaleYFromValue(0);
 
   if (_task != nullptr) {
+    /* the calculation thread locks FlightStatistics::mutex while
+       holding the task lease; never take them in the opposite
+       order */
+    const ScopeUnlock unlock{fs.mutex};
     ProtectedTaskManager::Lease task(*_task);
     canvas.SelectHollowBrush();
     RenderTaskLegs(chart, task, nmea_info, derived_info, -1);
   }
 
+  if (fs.history.size() < 2)
+    /* cleared meanwhile */
+    return;
+
   canvas.SelectNullPen();
   canvas.Select(cross_section_look.terrain_brush);
 
-  chart.DrawFilledLineGraph(fs.altitude_terrain);
+  if (fs.altitude_terrain.HasResult())
+    chart.DrawFilledLineGraph(fs.altitude_terrain);
 
-  chart.DrawLineGraph(fs.altitude, inverse? ChartLook::STYLE_WHITE: ChartLook::STYLE_BLACK);
+  const auto last =
+    DrawAltitudeHistory(chart, fs.history,
+                        inverse ? ChartLook::STYLE_WHITE : ChartLook::STYLE_BLACK);
 
   // draw dot
-  if (fs.altitude.GetCount()) {
-    if (inverse)
-      chart.GetCanvas().SelectWhiteBrush();
-    else
-      chart.GetCanvas().SelectBlackBrush();
-
-    const auto &slots = fs.altitude.GetSlots();
-    const auto &s = slots[fs.altitude.GetCount()-1];
-    chart.DrawDot(s, Layout::Scale(2));
-  }
+  if (inverse)
+    chart.GetCanvas().SelectWhiteBrush();
+  else
+    chart.GetCanvas().SelectBlackBrush();
+
+  chart.DrawDot(last, Layout::Scale(2));
 
   chart.Finish();
 }
@@ -98,12 +163,13 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
                 const DerivedInfo &derived_info,
                 const ProtectedTaskManager *_task)
 {
+  const std::lock_guard lock{fs.mutex};
   ChartRenderer chart(chart_look, canvas, rc);
   chart.SetXLabel("t", "hr");
   chart.SetYLabel("h", Units::GetAltitudeName());
   chart.Begin();
 
-  if (!fs.altitude.HasResult()) {
+  if (fs.history.size() < 2) {
     chart.DrawNoData();
     chart.Finish();
     return;
@@ -113,10 +179,8 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
                        cross_section_look.sky_color, cross_section_look.background_color,
                        cross_section_look.background_color);
 
-  chart.ScaleXFromData(fs.altitude);
-  chart.ScaleYFromData(fs.altitude);
+  ScaleFromHistory(chart, fs.history);
   chart.ScaleYFromValue(0);
-  chart.ScaleXFromValue(fs.altitude.GetMinX());
   if (derived_info.flight.flying)
     chart.ScaleXFromValue(derived_info.flight.flight_time / std::chrono::hours{1});
 
@@ -125,14 +189,23 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
   }
 
   if (_task != nullptr) {
+    /* see RenderBarographSpark() */
+    const ScopeUnlock unlock{fs.mutex};
     ProtectedTaskManager::Lease task(*_task);
     RenderTaskLegs(chart, task, nmea_info, derived_info, 0.33);
   }
 
+  if (fs.history.size() < 2) {
+    /* cleared meanwhile */
+    chart.Finish();
+    return;
+  }
+
   canvas.SelectNullPen();
   canvas.Select(cross_section_look.terrain_brush);
 
-  chart.DrawFilledLineGraph(fs.altitude_terrain);
+  if (fs.altitude_terrain.HasResult())
+    chart.DrawFilledLineGraph(fs.altitude_terrain);
 
   Pen bg_pen(1, chart_look.background_color);
   Brush bg_brush(chart_look.background_color);
@@ -153,7 +226,7 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
     chart.DrawTrend(fs.altitude_ceiling, ChartLook::STYLE_BLUETHINDASH);
   }
 
-  chart.DrawLineGraph(fs.altitude, ChartLook::STYLE_BLACK);
+  DrawAltitudeHistory(chart, fs.history, ChartLook::STYLE_BLACK);
   chart.Finish();
 }
 
@@ -3,41 +3,66 @@
 
 #include "LabelBlock.hpp"
 
-inline bool
-LabelBlock::Bucket::Check(const PixelRect rc) const noexcept
+#include <algorithm>
+
+void
+LabelBlock::reset(PixelSize screen_size) noexcept
 {
-  for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
-    if (i->OverlapsWith(rc))
-      return false;
+  const unsigned new_columns =
+    std::max((screen_size.width + CELL_SIZE - 1) >> CELL_SHIFT, 1u);
+  const unsigned new_rows =
+    std::max((screen_size.height + CELL_SIZE - 1) >> CELL_SHIFT, 1u);
 
-  return true;
+  if (new_columns != columns || new_rows != rows) {
+    columns = new_columns;
+    rows = new_rows;
+    cells.resize(columns * rows);
+  }
+
+  /* clear() keeps the capacity, so the next frame does not need to
+     allocate again */
+  for (auto &cell : cells)
+    cell.clear();
 }
 
-void
-LabelBlock::reset() noexcept
+static constexpr unsigned
+ClampCell(int coordinate, unsigned shift, unsigned n) noexcept
 {
-  for (auto &i : buckets)
-    i.Clear();
+  /* right-shifting a negative int is an arithmetic shift in C++20 */
+  return std::clamp(coordinate >> shift, 0, int(n) - 1);
+}
+
+inline LabelBlock::CellRange
+LabelBlock::GetCellRange(const PixelRect &rc) const noexcept
+{
+  /* rectangles outside of the screen are clamped to the border
+     cells, which preserves all overlaps; the right and bottom edges
+     are inclusive, just like in PixelRect::OverlapsWith() */
+  return {
+    ClampCell(rc.left, CELL_SHIFT, columns),
+    ClampCell(rc.top, CELL_SHIFT, rows),
+    ClampCell(rc.right, CELL_SHIFT, columns),
+    ClampCell(rc.bottom, CELL_SHIFT, rows),
+  };
 }
 
 bool
 LabelBlock::check(const PixelRect rc) noexcept
 {
-  unsigned top = rc.top >> BUCKET_SHIFT;
-  unsigned bottom = rc.bottom >> BUCKET_SHIFT;
-
-  if (top >= BUCKET_COUNT)
-    top = BUCKET_COUNT - 1;
+  if (cells.empty())
+    return true;
 
-  if (bottom < BUCKET_COUNT && !buckets[bottom].Check(rc))
-    return false;
+  const CellRange range = GetCellRange(rc);
 
-  if (top < bottom && !buckets[top].Check(rc))
-    return false;
+  for (unsigned row = range.top; row <= range.bottom; ++row)
+    for (unsigned column = range.left; column <= range.right; ++column)
+      for (const auto &i : GetCell(column, row))
+        if (i.OverlapsWith(rc))
+          return false;
 
-  buckets[top].Add(rc);
-  if (bottom < BUCKET_COUNT && top != bottom)
-    buckets[bottom].Add(rc);
+  for (unsigned row = range.top; row <= range.bottom; ++row)
+    for (unsigned column = range.left; column <= range.right; ++column)
+      GetCell(column, row).push_back(rc);
 
   return true;
 }
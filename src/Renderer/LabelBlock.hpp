@@ -4,43 +4,51 @@
 #pragma once
 
 #include "ui/dim/Rect.hpp"
-#include "util/StaticArray.hxx"
+#include "ui/dim/Size.hpp"
+
+#include <vector>
 
 /**
- * Simple code to prevent text writing over map city names.
+ * Prevents labels from being drawn over each other.  All map layers
+ * (waypoints, airspaces, topography) share one instance per frame;
+ * the first label to claim an area wins, so the layers must be
+ * rendered in order of decreasing label priority.
+ *
+ * The screen is divided into a uniform grid of square cells, and
+ * each cell stores the rectangles which overlap it, so a hit test
+ * only needs to look at the few rectangles near the new label.
  */
 class LabelBlock {
-  static constexpr unsigned SCREEN_HEIGHT = 4096;
-  static constexpr unsigned BUCKET_SIZE = 64;
-  static constexpr unsigned BUCKET_SHIFT = 7;
-  static constexpr unsigned BUCKET_HEIGHT = 1 << BUCKET_SHIFT;
-  static constexpr unsigned BUCKET_COUNT = SCREEN_HEIGHT / BUCKET_HEIGHT;
+  static constexpr unsigned CELL_SHIFT = 6;
+  static constexpr unsigned CELL_SIZE = 1 << CELL_SHIFT;
+
+  unsigned columns = 0, rows = 0;
+
+  std::vector<std::vector<PixelRect>> cells;
 
+public:
   /**
-   * A bucket is responsible for hit tests in one horizontal section
-   * of the screen.
+   * Clear all labels and adjust the grid to the given screen size.
    */
-  class Bucket {
-    typedef StaticArray<PixelRect, BUCKET_SIZE> BlockArray;
-    BlockArray blocks;
-
-  public:
-    void Clear() noexcept {
-      blocks.clear();
-    }
-
-    [[gnu::pure]]
-    bool Check(const PixelRect rc) const noexcept;
-
-    void Add(const PixelRect rc) noexcept {
-      if (!blocks.full())
-        blocks.append(rc);
-    }
+  void reset(PixelSize screen_size) noexcept;
+
+  /**
+   * Check whether the given rectangle overlaps with an existing
+   * label, and if not, claim it.
+   *
+   * @return true if the rectangle is free and has been claimed
+   */
+  bool check(const PixelRect rc) noexcept;
+
+private:
+  struct CellRange {
+    unsigned left, top, right, bottom;
   };
 
-  Bucket buckets[BUCKET_COUNT];
+  [[gnu::pure]]
+  CellRange GetCellRange(const PixelRect &rc) const noexcept;
 
-public:
-  bool check(const PixelRect rc) noexcept;
-  void reset() noexcept;
+  std::vector<PixelRect> &GetCell(unsigned column, unsigned row) noexcept {
+    return cells[row * columns + column];
+  }
 };
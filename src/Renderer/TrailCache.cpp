@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TrailCache.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Geo/FAISphere.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+void
+TrailCache::Clear() noexcept
+{
+  points.clear();
+  flat.clear();
+
+  for (auto &level : levels) {
+    level.settled.clear();
+    level.tail.clear();
+  }
+
+  synced = false;
+}
+
+bool
+TrailCache::Sync(const Trace &trace) noexcept
+{
+  if (synced && trace.GetAppendSerial() == append_serial)
+    return false;
+
+  if (trace.empty()) {
+    Clear();
+  } else if (synced && trace.GetModifySerial() == modify_serial &&
+             trace.size() > points.size() && !points.empty()) {
+    /* only new points were appended */
+    const std::size_t n = trace.size() - points.size();
+    std::copy(std::prev(trace.end(), n), trace.end(),
+              std::back_inserter(points));
+
+    for (std::size_t i = points.size() - n; i < points.size(); ++i)
+      flat.push_back(Project(points[i].GetLocation()));
+
+    for (unsigned i = 0; i < N_LEVELS; ++i)
+      Update(levels[i], GetTolerance(i));
+  } else {
+    trace.GetPoints(points);
+    Rebuild();
+  }
+
+  append_serial = trace.GetAppendSerial();
+  modify_serial = trace.GetModifySerial();
+  synced = true;
+  return true;
+}
+
+unsigned
+TrailCache::FindLevel(double max_error) const noexcept
+{
+  unsigned level = 0;
+  while (level + 1 < N_LEVELS && GetTolerance(level + 1) <= max_error)
+    ++level;
+
+  return level;
+}
+
+std::size_t
+TrailCache::FindTime(TracePoint::Time min_time) const noexcept
+{
+  return std::partition_point(points.begin(), points.end(),
+                              [min_time](const TracePoint &point){
+                                return point.GetTime() < min_time;
+                              }) - points.begin();
+}
+
+FlatPoint
+TrailCache::Project(const GeoPoint &location) const noexcept
+{
+  const GeoPoint delta = location - origin;
+  return {
+    delta.longitude.Radians() * longitude_scale,
+    FAISphere::AngleToEarthDistance(delta.latitude),
+  };
+}
+
+void
+TrailCache::Rebuild() noexcept
+{
+  flat.clear();
+  if (!points.empty()) {
+    origin = points.front().GetLocation();
+    longitude_scale = FAISphere::REARTH * origin.latitude.cos();
+
+    flat.reserve(points.size());
+    for (const auto &point : points)
+      flat.push_back(Project(point.GetLocation()));
+  }
+
+  for (unsigned i = 0; i < N_LEVELS; ++i) {
+    Level &level = levels[i];
+    level.settled.assign(1, 0);
+    level.tail.clear();
+
+    if (!points.empty())
+      Update(level, GetTolerance(i));
+  }
+}
+
+void
+TrailCache::Update(Level &level, unsigned tolerance) noexcept
+{
+  assert(!points.empty());
+  assert(!level.settled.empty());
+
+  const uint32_t last = points.size() - 1;
+
+  /* settle all complete chunks; the chunk boundaries depend only on
+     the points, so incremental updates give the same result as a
+     rebuild */
+  uint32_t anchor = level.settled.back();
+  while (last - anchor > CHUNK_SIZE) {
+    level.settled.pop_back();
+    Simplify(anchor, anchor + CHUNK_SIZE, tolerance, level.settled);
+    anchor = level.settled.back();
+  }
+
+  level.tail.clear();
+  Simplify(anchor, last, tolerance, level.tail);
+}
+
+/**
+ * Returns the square distance of point #p from the line segment
+ * #a..#b.
+ */
+[[gnu::const]]
+static double
+SquareSegmentDistance(const FlatPoint p,
+                      const FlatPoint a, const FlatPoint b) noexcept
+{
+  const double dx = b.x - a.x, dy = b.y - a.y;
+  double px = p.x - a.x, py = p.y - a.y;
+
+  const double length2 = dx * dx + dy * dy;
+  if (length2 > 0) {
+    const double t = std::clamp((px * dx + py * dy) / length2, 0., 1.);
+    px -= t * dx;
+    py -= t * dy;
+  }
+
+  return px * px + py * py;
+}
+
+void
+TrailCache::Simplify(uint32_t first, uint32_t last, unsigned tolerance,
+                     std::vector<uint32_t> &dest) const noexcept
+{
+  assert(first <= last);
+  assert(last < points.size());
+
+  dest.push_back(first);
+  if (last == first)
+    return;
+
+  const double square_tolerance = double(tolerance) * tolerance;
+  const std::size_t start = dest.size();
+
+  /* iterative Douglas-Peucker with an explicit stack of ranges */
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  stack.emplace_back(first, last);
+
+  while (!stack.empty()) {
+    const auto [a, b] = stack.back();
+    stack.pop_back();
+
+    const FlatPoint fa = flat[a], fb = flat[b];
+
+    double max_distance = square_tolerance;
+    uint32_t max_index = 0;
+    for (uint32_t i = a + 1; i < b; ++i) {
+      const double d = SquareSegmentDistance(flat[i], fa, fb);
+      if (d > max_distance) {
+        max_distance = d;
+        max_index = i;
+      }
+    }
+
+    if (max_index > 0) {
+      dest.push_back(max_index);
+      stack.emplace_back(a, max_index);
+      stack.emplace_back(max_index, b);
+    }
+  }
+
+  std::sort(std::next(dest.begin(), start), dest.end());
+  dest.push_back(last);
+}
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Trace/Vector.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
+#include "util/Serial.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Trace;
+
+/**
+ * A copy of a #Trace for the snail trail, with a level-of-detail
+ * pyramid: each level is the trace simplified with the
+ * Douglas-Peucker algorithm, with a tolerance that doubles from one
+ * level to the next.  The renderer picks the level matching the map
+ * scale, so it only needs to project a few points per pixel.
+ *
+ * The simplification works on a local flat projection in meters;
+ * the integer projection of the #Trace (about 100m per unit) is too
+ * coarse for zoomed-in maps.  New points are appended
+ * incrementally: the trace is split into chunks of #CHUNK_SIZE
+ * points which are simplified once; only the last (incomplete) chunk
+ * is simplified again.  The cache is rebuilt only when the #Trace
+ * gets thinned or cleared.
+ */
+class TrailCache {
+public:
+  static constexpr unsigned N_LEVELS = 12;
+
+  /**
+   * The number of points simplified together.  This bounds the cost
+   * of an incremental update.
+   */
+  static constexpr unsigned CHUNK_SIZE = 128;
+
+private:
+  struct Level {
+    /**
+     * Indices into #points of the points that survived
+     * simplification, in chronological order.  The last one is the
+     * start of the incomplete chunk.
+     */
+    std::vector<uint32_t> settled;
+
+    /**
+     * The simplified incomplete chunk, starting with
+     * settled.back().
+     */
+    std::vector<uint32_t> tail;
+
+    /**
+     * Returns the index of the #n-th point of this level.
+     */
+    uint32_t operator[](std::size_t n) const noexcept {
+      return n < settled.size() ? settled[n] : tail[n - settled.size() + 1];
+    }
+
+    std::size_t size() const noexcept {
+      return tail.empty() ? 0 : settled.size() + tail.size() - 1;
+    }
+  };
+
+  Serial append_serial, modify_serial;
+
+  /**
+   * Has this object been synchronised with a #Trace?
+   */
+  bool synced = false;
+
+  /**
+   * The origin of the flat projection, i.e. the first point.
+   */
+  GeoPoint origin;
+
+  /**
+   * The length of one radian longitude at #origin [m].
+   */
+  double longitude_scale;
+
+  TracePointVector points;
+
+  /**
+   * The projected location of each point of #points [m].
+   */
+  std::vector<FlatPoint> flat;
+
+  std::array<Level, N_LEVELS> levels;
+
+public:
+  /**
+   * Returns the maximum distance [m] between the original trace and
+   * the given level.
+   */
+  static constexpr unsigned GetTolerance(unsigned level) noexcept {
+    return 1u << level;
+  }
+
+  bool empty() const noexcept {
+    return points.empty();
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Copy new points from the #Trace and update the pyramid.  The
+   * caller must hold the lock protecting the #Trace.
+   *
+   * @return true if something has changed
+   */
+  bool Sync(const Trace &trace) noexcept;
+
+  /**
+   * All points of the trace (not simplified).
+   */
+  const TracePointVector &GetPoints() const noexcept {
+    return points;
+  }
+
+  /**
+   * The locations of GetPoints() in a flat projection [m].
+   */
+  const std::vector<FlatPoint> &GetFlatPoints() const noexcept {
+    return flat;
+  }
+
+  /**
+   * Returns the coarsest level which does not deviate from the trace
+   * by more than the given distance [m].
+   */
+  [[gnu::pure]]
+  unsigned FindLevel(double max_error) const noexcept;
+
+  /**
+   * Returns the index of the first point not older than the given
+   * time.
+   */
+  [[gnu::pure]]
+  std::size_t FindTime(TracePoint::Time min_time) const noexcept;
+
+  /**
+   * Invoke the function with the index (into GetPoints()) of each
+   * point of the given level, starting at the given index.
+   */
+  template<typename F>
+  void ForEach(unsigned level, std::size_t first, F &&f) const {
+    const Level &l = levels[level];
+    const std::size_t n = l.size();
+
+    /* binary search for the first point */
+    std::size_t lo = 0, hi = n;
+    while (lo < hi) {
+      const std::size_t mid = (lo + hi) / 2;
+      if (l[mid] < first)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    for (std::size_t i = lo; i < n; ++i)
+      f(l[i]);
+  }
+
+private:
+  void Rebuild() noexcept;
+
+  [[gnu::pure]]
+  FlatPoint Project(const GeoPoint &location) const noexcept;
+
+  void Update(Level &level, unsigned tolerance) noexcept;
+
+  /**
+   * Simplify the points [first, last] and append the indices of the
+   * surviving points (including #first and #last) to #dest.
+   */
+  void Simplify(uint32_t first, uint32_t last, unsigned tolerance,
+                std::vector<uint32_t> &dest) const noexcept;
+};
@@ -13,6 +13,7 @@
 #include "Engine/Contest/ContestTrace.hpp"
 
 #include <algorithm>
+#include <span>
 
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer) noexcept
@@ -60,7 +61,7 @@ GetAltitudeColorIndex(double alt, double min_alt, double max_alt) noexcept
 
 [[gnu::pure]]
 static std::pair<double, double>
-GetMinMax(TrailSettings::Type type, const TracePointVector &trace) noexcept
+GetMinMax(TrailSettings::Type type, std::span<const TracePoint> trace) noexcept
 {
   double value_min, value_max;
 
@@ -88,6 +89,15 @@ GetMinMax(TrailSettings::Type type, const TracePointVector &trace) noexcept
   return std::make_pair(value_min, value_max);
 }
 
+static constexpr bool
+IsDotsType(TrailSettings::Type type) noexcept
+{
+  return type == TrailSettings::Type::VARIO_1_DOTS ||
+    type == TrailSettings::Type::VARIO_2_DOTS ||
+    type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
+    type == TrailSettings::Type::VARIO_EINK;
+}
+
 void
 TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
                     const WindowProjection &projection,
@@ -99,7 +109,15 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
   if (settings.length == TrailSettings::Length::OFF)
     return;
 
-  if (!LoadTrace(trace_computer, min_time, projection))
+  {
+    const std::lock_guard<Mutex> lock{trace_computer};
+    cache.Sync(trace_computer.GetFull());
+  }
+
+  const auto &all = cache.GetPoints();
+  const std::size_t first =
+    cache.FindTime(min_time.Cast<std::chrono::duration<unsigned>>());
+  if (first >= all.size())
     return;
 
   if (!basic.location_available || !calculated.wind_available)
@@ -113,7 +131,7 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
     traildrift = basic.location - tp1;
   }
 
-  auto minmax = GetMinMax(settings.type, trace);
+  auto minmax = GetMinMax(settings.type, std::span{all}.subspan(first));
   auto value_min = minmax.first;
   auto value_max = minmax.second;
 
@@ -122,62 +140,109 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
 
   const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
 
-  PixelPoint last_point(0, 0);
+  /* collect the points of the level of detail matching the map
+     scale which are near the screen */
+  vertices.clear();
+  latitudes.clear();
+  longitudes.clear();
+
+  const unsigned level =
+    cache.FindLevel(projection.DistancePixelsToMeters(1));
+
   bool last_valid = false;
-  for (const auto &i : trace) {
+  cache.ForEach(level, first, [&](uint32_t index){
+    const TracePoint &i = all[index];
     const GeoPoint gp = enable_traildrift
       ? i.GetLocation().Parametric(traildrift, i.CalculateDrift(basic.time))
       : i.GetLocation();
     if (!bounds.IsInside(gp)) {
       /* the point is outside of the MapWindow; don't paint it */
       last_valid = false;
-      continue;
+      return;
     }
 
-    auto pt = projection.GeoToScreen(gp);
+    vertices.push_back({index, last_valid});
+    latitudes.push_back(gp.latitude);
+    longitudes.push_back(gp.longitude);
+    last_valid = true;
+  });
+
+  if (vertices.empty())
+    return;
+
+  screen_points.resize(vertices.size());
+  projection.GeoToScreen(latitudes, longitudes, screen_points);
 
-    if (last_valid) {
-      if (settings.type == TrailSettings::Type::ALTITUDE) {
-        unsigned index = GetAltitudeColorIndex(i.GetAltitude(),
-                                               value_min, value_max);
-        canvas.Select(look.trail_pens[index]);
+  /* consecutive line segments with the same pen are merged into one
+     polyline */
+  BulkPixelPoint *const run = Prepare(vertices.size());
+  unsigned run_length = 0;
+  const Pen *run_pen = nullptr;
+
+  const auto flush = [&]{
+    if (run_length >= 2) {
+      canvas.Select(*run_pen);
+      canvas.DrawPolyline(run, run_length);
+    }
+
+    run_length = 0;
+  };
+
+  const auto add_line = [&](const Pen &pen, PixelPoint a, PixelPoint b){
+    if (run_length == 0 || &pen != run_pen) {
+      flush();
+      run_pen = &pen;
+      run[run_length++] = a;
+    }
+
+    run[run_length++] = b;
+  };
+
+  for (std::size_t j = 1; j < vertices.size(); ++j) {
+    if (!vertices[j].connected) {
+      flush();
+      continue;
+    }
+
+    const TracePoint &i = all[vertices[j].index];
+    const PixelPoint last_point = screen_points[j - 1];
+    const PixelPoint pt = screen_points[j];
+
+    if (settings.type == TrailSettings::Type::ALTITUDE) {
+      unsigned index = GetAltitudeColorIndex(i.GetAltitude(),
+                                             value_min, value_max);
+      add_line(look.trail_pens[index], last_point, pt);
+    } else {
+      unsigned color_index = GetSnailColorIndex(i.GetVario(),
+                                                value_min, value_max);
+      if (i.GetVario() < 0 && IsDotsType(settings.type)) {
+        flush();
+        canvas.SelectNullPen();
+        canvas.Select(look.trail_brushes[color_index]);
+        canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
+                          look.trail_widths[color_index]);
+      } else if (settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
+                 settings.type == TrailSettings::Type::VARIO_EINK) {
+        // positive vario case
+        flush();
+        canvas.Select(look.trail_brushes[color_index]);
+        canvas.Select(look.trail_pens[color_index]); //fixed-width pen
+        canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
+                          look.trail_widths[color_index]);
         canvas.DrawLinePiece(last_point, pt);
-      } else {
-        unsigned color_index = GetSnailColorIndex(i.GetVario(),
-                                                  value_min, value_max);
-        if (i.GetVario() < 0 &&
-            (settings.type == TrailSettings::Type::VARIO_1_DOTS ||
-             settings.type == TrailSettings::Type::VARIO_2_DOTS ||
-             settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
-             settings.type == TrailSettings::Type::VARIO_EINK)) {
-          canvas.SelectNullPen();
-          canvas.Select(look.trail_brushes[color_index]);
-          canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
-                            look.trail_widths[color_index]);
-        } else {
-          // positive vario case
-          if (settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
-              settings.type == TrailSettings::Type::VARIO_EINK) {
-            canvas.Select(look.trail_brushes[color_index]);
-            canvas.Select(look.trail_pens[color_index]); //fixed-width pen
-            canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
-                            look.trail_widths[color_index]);
-          } else if (scaled_trail)
-            // width scaled to vario
-            canvas.Select(look.scaled_trail_pens[color_index]);
-          else
-            // fixed-width pen
-            canvas.Select(look.trail_pens[color_index]);
-          canvas.DrawLinePiece(last_point, pt);
-        }
-      }
+      } else if (scaled_trail)
+        // width scaled to vario
+        add_line(look.scaled_trail_pens[color_index], last_point, pt);
+      else
+        // fixed-width pen
+        add_line(look.trail_pens[color_index], last_point, pt);
     }
-    last_point = pt;
-    last_valid = true;
   }
 
+  flush();
+
   if (last_valid)
-    canvas.DrawLine(last_point, pos);
+    canvas.DrawLine(screen_points.back(), pos);
 }
 
 void
@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include "TrailCache.hpp"
 #include "util/AllocatedArray.hxx"
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
+#include "Math/Angle.hpp"
+#include "ui/dim/Point.hpp"
 #include "time/Stamp.hpp"
 
-struct PixelPoint;
+#include <vector>
+
 struct BulkPixelPoint;
 class Canvas;
 class TraceComputer;
@@ -32,6 +36,28 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<BulkPixelPoint> points;
 
+  /**
+   * The simplified snail trail, updated incrementally by Draw().
+   */
+  TrailCache cache;
+
+  /**
+   * Buffers for the visible snail trail points, reused by each
+   * Draw() call.
+   */
+  struct Vertex {
+    uint32_t index;
+
+    /**
+     * Is this point connected with the previous one?
+     */
+    bool connected;
+  };
+
+  std::vector<Vertex> vertices;
+  std::vector<Angle> latitudes, longitudes;
+  std::vector<PixelPoint> screen_points;
+
 public:
   TrailRenderer(const TrailLook &_look) noexcept:look(_look) {}
 
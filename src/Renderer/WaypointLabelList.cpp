@@ -74,6 +74,8 @@ WaypointLabelList::Add(const char *Name, PixelPoint p,
 void
 WaypointLabelList::Sort() noexcept
 {
-  std::sort(labels.begin(), labels.end(),
-            MapWaypointLabelListCompare);
+  /* stable sort: labels with equal priority keep their order, so
+     the placement does not flicker between frames */
+  std::stable_sort(labels.begin(), labels.end(),
+                   MapWaypointLabelListCompare);
 }
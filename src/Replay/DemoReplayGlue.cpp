@@ -19,15 +19,17 @@ DemoReplayGlue::DemoReplayGlue(DeviceBlackboard &_device_blackboard,
   DemoReplay::Start(ta, device_blackboard.Basic().location);
 
   // get wind from aircraft
-  aircraft.GetState().wind = device_blackboard.Calculated().GetWindOrZero();
+  aircraft.GetState().wind =
+    device_blackboard.calculated_snapshot.Get()->GetWindOrZero();
 }
 
 bool
 DemoReplayGlue::Update(NMEAInfo &data)
 {
   double floor_alt = 300;
-  if (device_blackboard.Calculated().terrain_valid) {
-    floor_alt += device_blackboard.Calculated().terrain_altitude;
+  if (const auto calculated = device_blackboard.calculated_snapshot.Get();
+      calculated->terrain_valid) {
+    floor_alt += calculated->terrain_altitude;
   }
 
   bool retval;
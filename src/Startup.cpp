@@ -52,11 +52,13 @@
 #include "Computer/GlideComputer.hpp"
 #include "Computer/GlideComputerInterface.hpp"
 #include "Computer/Events.hpp"
+#include "Computer/ThermalMap/ThermalMap.hpp"
 #include "Monitor/AllMonitors.hpp"
 #include "MergeThread.hpp"
 #include "CalculationThread.hpp"
 #include "Replay/Replay.hpp"
 #include "LocalPath.hpp"
+#include "system/FileUtil.hpp"
 #include "io/FileCache.hpp"
 #include "io/async/AsioThread.hpp"
 #include "io/async/GlobalAsioThread.hpp"
@@ -121,6 +123,18 @@ static AllMonitors *all_monitors;
 static GlideComputerTaskEvents *task_events;
 static DeviceFactory *device_factory;
 
+/**
+ * The name of the #ThermalMap file in the XCSoarData directory.
+ */
+static constexpr char THERMAL_MAP_FILE[] = "thermals.tmap";
+
+/**
+ * Set if the #ThermalMap file exists but could not be loaded.  It
+ * must not be overwritten then, or the climbs it contains would be
+ * lost.
+ */
+static bool thermal_map_load_failed = false;
+
 static bool
 LoadProfile()
 {
@@ -443,6 +457,18 @@ Startup(UI::Display &display)
                                     *task_events);
   backend_components->glide_computer->SetTerrain(data_components->terrain.get());
   backend_components->glide_computer->SetLogger(backend_components->igc_logger.get());
+
+  backend_components->thermal_map = std::make_unique<ThermalMap>();
+  if (const auto path = LocalPath(THERMAL_MAP_FILE); File::Exists(path)) {
+    try {
+      backend_components->thermal_map->Load(path);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load thermal map");
+      thermal_map_load_failed = true;
+    }
+  }
+
+  backend_components->glide_computer->SetThermalMap(backend_components->thermal_map.get());
   backend_components->glide_computer->Initialise();
 
   backend_components->replay =
@@ -534,7 +560,7 @@ Startup(UI::Display &display)
   {
     const AircraftState aircraft_state =
       ToAircraftState(backend_components->device_blackboard->Basic(),
-                      backend_components->device_blackboard->Calculated());
+                      *backend_components->device_blackboard->calculated_snapshot.Get());
     ProtectedAirspaceWarningManager::ExclusiveLease lease(backend_components->glide_computer->GetAirspaceWarnings());
     lease->Reset(aircraft_state);
   }
@@ -740,6 +766,16 @@ Shutdown()
       backend_components->calculation_thread->Join();
       backend_components->calculation_thread.reset();
     }
+
+    if (backend_components->thermal_map &&
+        !backend_components->thermal_map->empty() &&
+        !thermal_map_load_failed) {
+      try {
+        backend_components->thermal_map->Save(LocalPath(THERMAL_MAP_FILE));
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save thermal map");
+      }
+    }
   }
 
   //  Wait for the drawing thread to finish
@@ -3,9 +3,8 @@
 
 #include "LoadFile.hpp"
 #include "Deserialiser.hpp"
-#include "XML/Node.hpp"
 #include "XML/DataNodeXML.hpp"
-#include "XML/Parser.hpp"
+#include "XML/Document.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "system/Path.hpp"
 #include "util/StringUtil.hpp"
@@ -18,8 +17,8 @@ LoadTask(Path path, const TaskBehaviour &task_behaviour,
          const Waypoints *waypoints)
 {
   // Load root node
-  const auto xml_root = XML::ParseFile(path);
-  const ConstDataNodeXML root(xml_root);
+  const auto xml = XML::Document::ParseFile(path);
+  const ConstDataNodeXML root(xml.GetRoot());
 
   // Check if root node is a <Task> node
   if (!StringIsEqual(root.GetName(), "Task"))
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TaskIndex.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "util/IterableSplitString.hxx"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
+
+#include <math.h>
+
+static constexpr char HEADER[] = "XCSoar task index 1";
+
+TaskIndex::Stamp
+TaskIndex::Stamp::Get(Path path) noexcept
+{
+  const auto mtime = File::GetLastModification(path);
+  if (mtime == std::chrono::system_clock::time_point{})
+    return {0, 0};
+
+  return {
+    std::chrono::duration_cast<std::chrono::seconds>(mtime.time_since_epoch()).count(),
+    File::GetSize(path),
+  };
+}
+
+/**
+ * Parse a number followed by a tab.  Returns nullptr on error.
+ */
+template<typename T, typename P>
+static char *
+ParseColumn(char *p, T &value, P parse) noexcept
+{
+  char *endptr;
+  value = parse(p, &endptr, 10);
+  if (endptr == p || *endptr != '\t')
+    return nullptr;
+
+  return endptr + 1;
+}
+
+static bool
+ParseSummary(char *p, TaskIndex::Summary &summary) noexcept
+{
+  unsigned type;
+  p = ParseColumn(p, type, ParseUnsigned);
+  if (p == nullptr || type >= unsigned(TaskFactoryType::COUNT))
+    return false;
+
+  summary.type = TaskFactoryType(type);
+
+  unsigned distance;
+  p = ParseColumn(p, distance, ParseUnsigned);
+  if (p == nullptr)
+    return false;
+
+  summary.distance = distance;
+
+  summary.turnpoints.clear();
+  if (*p != '\0')
+    for (const std::string_view name : IterableSplitString(p, '\t'))
+      summary.turnpoints.emplace_back(name);
+
+  return true;
+}
+
+/**
+ * Parse one line of the index file.
+ *
+ * @param entry the current file entry (updated by "F" lines)
+ * @return false if the line is malformed
+ */
+static bool
+ParseLine(char *line, auto &entries, auto *&entry) noexcept
+{
+  if (line[0] == '\0' || line[1] != '\t')
+    return false;
+
+  char *p = line + 2;
+
+  switch (line[0]) {
+  case 'F':
+    {
+      TaskIndex::Stamp stamp;
+      p = ParseColumn(p, stamp.mtime, ParseInt64);
+      if (p != nullptr)
+        p = ParseColumn(p, stamp.size, ParseUint64);
+      if (p == nullptr || *p == '\0')
+        return false;
+
+      entry = &entries[p];
+      entry->stamp = stamp;
+      entry->tasks.clear();
+      entry->seen = false;
+      return true;
+    }
+
+  case 'T':
+    if (entry == nullptr)
+      return false;
+
+    entry->tasks.push_back({p, std::nullopt});
+    return true;
+
+  case 'S':
+    if (entry == nullptr || entry->tasks.empty())
+      return false;
+
+    if (TaskIndex::Summary summary; ParseSummary(p, summary)) {
+      entry->tasks.back().summary = std::move(summary);
+      return true;
+    } else
+      return false;
+
+  default:
+    return false;
+  }
+}
+
+void
+TaskIndex::Load(Path path) noexcept
+try {
+  entries.clear();
+  modified = false;
+
+  FileLineReaderA reader(path);
+
+  const char *header = reader.ReadLine();
+  if (header == nullptr || !StringIsEqual(header, HEADER))
+    return;
+
+  Entry *entry = nullptr;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (!ParseLine(line, entries, entry)) {
+      /* start with an empty index; it will be rebuilt by the next
+         scan */
+      entries.clear();
+      return;
+    }
+  }
+} catch (...) {
+  /* the file does not exist yet or cannot be read */
+  entries.clear();
+}
+
+/**
+ * Write a string, replacing characters which have a special meaning
+ * in the index file.
+ */
+static void
+WriteField(BufferedOutputStream &out, std::string_view s)
+{
+  for (char ch : s)
+    out.Write(ch == '\t' || ch == '\n' || ch == '\r' ? ' ' : ch);
+}
+
+void
+TaskIndex::Save(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream out(file);
+
+  out.Write(HEADER);
+  out.NewLine();
+
+  for (const auto &[name, entry] : entries) {
+    out.Fmt("F\t{}\t{}\t", entry.stamp.mtime, entry.stamp.size);
+    WriteField(out, name);
+    out.NewLine();
+
+    for (const auto &task : entry.tasks) {
+      out.Write("T\t");
+      WriteField(out, task.name);
+      out.NewLine();
+
+      if (task.summary) {
+        out.Fmt("S\t{}\t{}\t", unsigned(task.summary->type),
+                unsigned(lround(task.summary->distance)));
+
+        bool first = true;
+        for (const auto &turnpoint : task.summary->turnpoints) {
+          if (!first)
+            out.Write('\t');
+          first = false;
+          WriteField(out, turnpoint);
+        }
+
+        out.NewLine();
+      }
+    }
+  }
+
+  out.Flush();
+  file.Commit();
+
+  modified = false;
+}
+
+const std::vector<TaskIndex::Task> *
+TaskIndex::Find(Path path, const Stamp &stamp) noexcept
+{
+  auto i = entries.find(path.c_str());
+  if (i == entries.end() || i->second.stamp != stamp)
+    return nullptr;
+
+  i->second.seen = true;
+  return &i->second.tasks;
+}
+
+void
+TaskIndex::Put(Path path, const Stamp &stamp,
+               const std::vector<std::string> &names) noexcept
+{
+  Entry &entry = entries[path.c_str()];
+  entry.stamp = stamp;
+  entry.seen = true;
+
+  entry.tasks.clear();
+  for (const auto &name : names)
+    entry.tasks.push_back({name, std::nullopt});
+
+  modified = true;
+}
+
+void
+TaskIndex::PutSummary(Path path, unsigned index, Summary &&summary) noexcept
+{
+  auto i = entries.find(path.c_str());
+  if (i == entries.end() || index >= i->second.tasks.size())
+    return;
+
+  auto &task = i->second.tasks[index];
+  if (task.summary == summary)
+    return;
+
+  task.summary = std::move(summary);
+  modified = true;
+}
+
+const TaskIndex::Summary *
+TaskIndex::GetSummary(Path path, unsigned index) const noexcept
+{
+  auto i = entries.find(path.c_str());
+  if (i == entries.end() || index >= i->second.tasks.size())
+    return nullptr;
+
+  const auto &summary = i->second.tasks[index].summary;
+  return summary ? &*summary : nullptr;
+}
+
+void
+TaskIndex::Prune() noexcept
+{
+  for (auto i = entries.begin(); i != entries.end();) {
+    if (i->second.seen) {
+      i->second.seen = false;
+      ++i;
+    } else {
+      i = entries.erase(i);
+      modified = true;
+    }
+  }
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Task/Factory/TaskFactoryType.hpp"
+#include "system/Path.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * A persistent index of task files.  It remembers the names of the
+ * tasks in each file and a summary of each task which has been loaded
+ * once, so #TaskStore needs to parse only files which were modified
+ * since the last scan.
+ *
+ * A file is considered unmodified if its modification time and its
+ * size are the same as in the index.
+ */
+class TaskIndex {
+public:
+  struct Stamp {
+    /**
+     * Modification time [seconds since epoch].
+     */
+    int64_t mtime;
+
+    uint64_t size;
+
+    /**
+     * Determine the stamp of the given file.  Returns a zero stamp
+     * if the file does not exist.
+     */
+    static Stamp Get(Path path) noexcept;
+
+    constexpr bool operator==(const Stamp &other) const noexcept = default;
+  };
+
+  struct Summary {
+    TaskFactoryType type;
+
+    /**
+     * The nominal task distance [m].
+     */
+    double distance;
+
+    std::vector<std::string> turnpoints;
+
+    bool operator==(const Summary &other) const noexcept = default;
+  };
+
+  struct Task {
+    std::string name;
+
+    /**
+     * The summary, or std::nullopt if this task has never been
+     * loaded.
+     */
+    std::optional<Summary> summary;
+  };
+
+private:
+  struct Entry {
+    Stamp stamp;
+
+    std::vector<Task> tasks;
+
+    /**
+     * Was this entry looked up since the last Prune() call?
+     */
+    bool seen = true;
+  };
+
+  std::map<std::string, Entry, std::less<>> entries;
+
+  /**
+   * Has the index been modified since Load() or Save()?
+   */
+  bool modified = false;
+
+public:
+  [[gnu::pure]]
+  bool IsModified() const noexcept {
+    return modified;
+  }
+
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return entries.size();
+  }
+
+  void Clear() noexcept {
+    modified = modified || !entries.empty();
+    entries.clear();
+  }
+
+  /**
+   * Replace the contents with an index file written by Save().
+   * Errors are ignored; a missing or malformed file results in an
+   * empty index.
+   */
+  void Load(Path path) noexcept;
+
+  /**
+   * Write the index to a file.
+   *
+   * Throws on error.
+   */
+  void Save(Path path);
+
+  /**
+   * Look up the tasks of a file.  Returns nullptr if the file is
+   * unknown or its stamp has changed.
+   */
+  const std::vector<Task> *Find(Path path, const Stamp &stamp) noexcept;
+
+  /**
+   * Add or replace the list of tasks of a file, discarding old
+   * summaries.
+   */
+  void Put(Path path, const Stamp &stamp,
+           const std::vector<std::string> &names) noexcept;
+
+  /**
+   * Store the summary of a task which was loaded.  This is ignored
+   * if the file is not in the index.
+   */
+  void PutSummary(Path path, unsigned index, Summary &&summary) noexcept;
+
+  [[gnu::pure]]
+  const Summary *GetSummary(Path path, unsigned index) const noexcept;
+
+  /**
+   * Remove all files which were not looked up since the previous
+   * call, i.e. files which have been deleted.
+   */
+  void Prune() noexcept;
+};
@@ -4,6 +4,8 @@
 #include "Task/TaskStore.hpp"
 #include "Task/TaskFile.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
 #include "system/FileUtil.hpp"
 #include "system/Path.hpp"
 #include "LocalPath.hpp"
@@ -13,24 +15,35 @@
 #include <algorithm>
 #include <memory>
 
+static constexpr char INDEX_NAME[] = "task_index";
+
 class TaskFileVisitor: public File::Visitor
 {
 private:
   TaskStore::ItemVector &store;
+  TaskIndex &index;
 
 public:
-  TaskFileVisitor(TaskStore::ItemVector &_store):
-    store(_store) {}
+  TaskFileVisitor(TaskStore::ItemVector &_store, TaskIndex &_index):
+    store(_store), index(_index) {}
 
   void Visit(Path path, Path base_name) override
   try {
-    // Create a TaskFile instance to determine how many
-    // tasks are inside of this task file
-    const auto task_file = TaskFile::Create(path);
-    if (!task_file)
-      return;
+    const auto stamp = TaskIndex::Stamp::Get(path);
+    const auto *tasks = index.Find(path, stamp);
+    if (tasks == nullptr) {
+      // Create a TaskFile instance to determine how many
+      // tasks are inside of this task file
+      const auto task_file = TaskFile::Create(path);
+      if (!task_file)
+        return;
+
+      index.Put(path, stamp, task_file->GetList());
+      tasks = index.Find(path, stamp);
+      assert(tasks != nullptr);
+    }
 
-    const auto list = task_file->GetList();
+    const auto &list = *tasks;
 
     // Count the tasks in the task file
     unsigned count = list.size();
@@ -40,7 +53,7 @@ public:
       StaticString<256> name(base_name.c_str());
 
       // If the task file holds more than one task
-      const auto &saved_name = list[i];
+      const auto &saved_name = list[i].name;
       if (!saved_name.empty()) {
         name += ": ";
         name += saved_name.c_str();
@@ -57,6 +70,30 @@ public:
   }
 };
 
+TaskStore::TaskStore() noexcept = default;
+
+TaskStore::~TaskStore() noexcept
+{
+  SaveIndex();
+}
+
+void
+TaskStore::SaveIndex() noexcept
+{
+  if (!index.IsModified())
+    return;
+
+  const auto cache_path = MakeCacheDirectory("tasks");
+  if (cache_path == nullptr)
+    return;
+
+  try {
+    index.Save(AllocatedPath::Build(cache_path, INDEX_NAME));
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+}
+
 void
 TaskStore::Clear()
 {
@@ -69,16 +106,30 @@ TaskStore::Scan(bool extra)
 {
   Clear();
 
+  if (!index_loaded) {
+    index_loaded = true;
+
+    if (const auto cache_path = MakeCacheDirectory("tasks");
+        cache_path != nullptr)
+      index.Load(AllocatedPath::Build(cache_path, INDEX_NAME));
+  }
+
   // scan files
-  TaskFileVisitor tfv(store);
+  TaskFileVisitor tfv(store, index);
   VisitDataFiles("*.tsk", tfv);
 
   if (extra) {
     VisitDataFiles("*.cup", tfv);
     VisitDataFiles("*.igc", tfv);
+
+    /* forget files which have been deleted; this is only possible
+       after a full scan */
+    index.Prune();
   }
 
   std::sort(store.begin(), store.end());
+
+  SaveIndex();
 }
 
 TaskStore::Item::~Item() noexcept = default;
@@ -115,8 +166,32 @@ TaskStore::GetPath(unsigned index) const
 }
 
 const OrderedTask *
-TaskStore::GetTask(unsigned index, const TaskBehaviour &task_behaviour,
+TaskStore::GetTask(unsigned i, const TaskBehaviour &task_behaviour,
                    Waypoints *waypoints)
 {
-  return store[index].GetTask(task_behaviour, waypoints);
+  auto &item = store[i];
+  const bool loaded = item.task != nullptr;
+  const OrderedTask *task = item.GetTask(task_behaviour, waypoints);
+  if (task != nullptr && !loaded) {
+    /* remember the summary for the next time the list is shown */
+    TaskIndex::Summary summary{
+      task->GetFactoryType(),
+      task->GetStats().distance_nominal,
+      {},
+    };
+
+    for (unsigned j = 0, n = task->TaskSize(); j < n; ++j)
+      summary.turnpoints.emplace_back(task->GetTaskPoint(j).GetWaypoint().name);
+
+    index.PutSummary(item.GetPath(), item.task_index, std::move(summary));
+  }
+
+  return task;
+}
+
+const TaskIndex::Summary *
+TaskStore::GetSummary(unsigned i) const noexcept
+{
+  const auto &item = store[i];
+  return index.GetSummary(item.GetPath(), item.task_index);
 }
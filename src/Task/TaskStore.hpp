@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "TaskIndex.hpp"
 #include "system/Path.hpp"
 
 #include <string>
@@ -67,7 +68,25 @@ private:
    */
   ItemVector store;
 
+  /**
+   * The persistent index, which allows Scan() to skip files which
+   * have not been modified.
+   */
+  TaskIndex index;
+
+  bool index_loaded = false;
+
 public:
+  TaskStore() noexcept;
+
+  /**
+   * Saves the index if it has been modified.
+   */
+  ~TaskStore() noexcept;
+
+  TaskStore(const TaskStore &) = delete;
+  TaskStore &operator=(const TaskStore &) = delete;
+
   /**
    * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
    *
@@ -116,4 +135,14 @@ public:
   const OrderedTask *GetTask(unsigned index,
                              const TaskBehaviour &task_behaviour,
                              Waypoints *waypoints);
+
+  /**
+   * Return the summary of the task defined by the given index, or
+   * nullptr if it has never been loaded.
+   */
+  [[gnu::pure]]
+  const TaskIndex::Summary *GetSummary(unsigned index) const noexcept;
+
+private:
+  void SaveIndex() noexcept;
 };
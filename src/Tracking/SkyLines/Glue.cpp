@@ -54,17 +54,21 @@ SkyLinesTracking::Glue::IsConnected() const
 }
 
 inline void
-SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
+SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic,
+                                  const DerivedInfo &calculated)
 {
   assert(client.IsConnected());
 
   if (!basic.time_available) {
-    clock.Reset();
+    rate.Reset();
     return;
   }
 
+  const bool due = rate.Check(basic.time, interval, calculated.circling,
+                              basic.track_available, basic.track);
+
   if (!IsConnected()) {
-    if (clock.CheckAdvance(basic.time, interval)) {
+    if (due) {
       /* queue the packet, send it later */
       if (queue == nullptr)
         queue = new Queue();
@@ -88,9 +92,10 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
         break;
       }
     }
+  }
 
-    return;
-  } else if (clock.CheckAdvance(basic.time, interval))
+  /* the current position is not delayed by replaying the queue */
+  if (due)
     client.SendFix(basic);
 }
 
@@ -153,7 +158,7 @@ SkyLinesTracking::Glue::Tick(const NMEAInfo &basic,
     return;
 
   if (client.IsConnected()) {
-    SendFixes(basic);
+    SendFixes(basic, calculated);
 
     if (traffic_enabled &&
         traffic_clock.CheckAdvance(basic.clock, minutes(1)))
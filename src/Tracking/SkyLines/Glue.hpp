@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Client.hpp"
+#include "Rate.hpp"
 #include "time/GPSClock.hpp"
 #include "time/Stamp.hpp"
 
@@ -17,7 +18,7 @@ class Queue;
 class Glue {
   Client client;
   std::chrono::steady_clock::duration interval{};
-  GPSClock clock;
+  AdaptiveRate rate;
 
   GPSClock traffic_clock;
   GPSClock thermal_clock;
@@ -52,7 +53,7 @@ private:
   [[gnu::pure]]
   bool IsConnected() const;
 
-  void SendFixes(const NMEAInfo &basic);
+  void SendFixes(const NMEAInfo &basic, const DerivedInfo &calculated);
   void SendCloudFix(const NMEAInfo &basic, const DerivedInfo &calculated);
 };
 
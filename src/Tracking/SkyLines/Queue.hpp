@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Protocol.hpp"
+#include "util/ByteOrder.hxx"
 #include "util/OverwritingRingBuffer.hpp"
 
 #include <cstdint>
@@ -28,9 +29,13 @@ public:
   }
 
   void Push(const FixPacket &packet) {
-    if (!IsEmpty() && (packet.time > queue.last().time &&
-                       queue.last().time + MIN_PERIOD_MS < packet.time))
-      return;
+    if (!IsEmpty()) {
+      /* FixPacket::time is big-endian */
+      const uint32_t time = FromBE32(packet.time);
+      const uint32_t last_time = FromBE32(queue.last().time);
+      if (time > last_time && time < last_time + MIN_PERIOD_MS)
+        return;
+    }
 
     queue.push(packet);
   }
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Math/Angle.hpp"
+#include "time/FloatDuration.hxx"
+#include "time/Stamp.hpp"
+
+namespace SkyLinesTracking {
+
+/**
+ * Decides when the next fix shall be sent.  While circling or
+ * turning, fixes are sent at the configured interval.  On a straight
+ * cruise leg, the interval is stretched, because the intermediate
+ * fixes would be drawn on the line between their neighbours anyway.
+ */
+class AdaptiveRate {
+  /**
+   * On a straight leg, the interval is multiplied by this factor.
+   */
+  static constexpr unsigned CRUISE_FACTOR = 3;
+
+  /**
+   * A track change larger than this since the last fix ends the
+   * straight leg.
+   */
+  static constexpr Angle MAX_TRACK_CHANGE = Angle::Degrees(20);
+
+  TimeStamp last_time = TimeStamp::Undefined();
+
+  Angle last_track;
+  bool last_track_available = false;
+
+public:
+  void Reset() noexcept {
+    last_time = TimeStamp::Undefined();
+  }
+
+  /**
+   * Check whether a fix shall be sent now, and if yes, remember this
+   * fix as the last one.
+   *
+   * @param track the current track; only used if @a track_available
+   * is true
+   */
+  bool Check(TimeStamp time, FloatDuration interval, bool circling,
+             bool track_available, Angle track) noexcept {
+    if (last_time.IsDefined()) {
+      if (time < last_time) {
+        /* time warp */
+        last_time = time;
+        return false;
+      }
+
+      const auto elapsed = time - last_time;
+      if (elapsed < interval)
+        return false;
+
+      const bool straight = !circling &&
+        track_available && last_track_available &&
+        (track - last_track).AsDelta().Absolute() < MAX_TRACK_CHANGE;
+      if (straight && elapsed < interval * CRUISE_FACTOR)
+        return false;
+    }
+
+    last_time = time;
+    last_track = track;
+    last_track_available = track_available;
+    return true;
+  }
+};
+
+} /* namespace SkyLinesTracking */
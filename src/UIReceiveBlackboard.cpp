@@ -67,7 +67,11 @@ UIReceiveSensorData(OperationEnvironment &env)
    * Command::CALCULATED_UPDATE message which will update them)
    */
   if (modified || !CommonInterface::Basic().location_available) {
-    InfoBoxManager::SetDirty();
+    if (modified)
+      InfoBoxManager::SetDirty();
+    else
+      InfoBoxManager::ScheduleUpdate();
+
     InfoBoxManager::ProcessTimer();
   }
 
@@ -13,7 +13,7 @@ void
 UIReceiveSensorData(OperationEnvironment &env);
 
 /**
- * Receive new data from DeviceBlackboard::Calculated() into the
+ * Receive new data from DeviceBlackboard::calculated_snapshot into the
  * InterfaceBlackboard and propagate it.
  */
 void
@@ -98,8 +98,8 @@ WaypointFilter::CompareName(const Waypoint &waypoint) const
 }
 
 bool
-WaypointFilter::Matches(const Waypoint &waypoint, GeoPoint location,
-                        const FAITrianglePointValidator &triangle_validator) const
+WaypointFilter::MatchesExceptName(const Waypoint &waypoint, GeoPoint location,
+                                  const FAITrianglePointValidator &triangle_validator) const
 {
   // Check file_num filter for FILE type
   if (type_index == TypeFilter::FILE && file_num >= 0) {
@@ -109,6 +109,13 @@ WaypointFilter::Matches(const Waypoint &waypoint, GeoPoint location,
   }
 
   return CompareType(waypoint, triangle_validator) &&
-         (distance <= 0 || CompareName(waypoint)) &&
          CompareDirection(waypoint, location);
 }
+
+bool
+WaypointFilter::Matches(const Waypoint &waypoint, GeoPoint location,
+                        const FAITrianglePointValidator &triangle_validator) const
+{
+  return MatchesExceptName(waypoint, location, triangle_validator) &&
+         (distance <= 0 || CompareName(waypoint));
+}
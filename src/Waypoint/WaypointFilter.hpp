@@ -64,6 +64,14 @@ struct WaypointFilter
   bool Matches(const Waypoint &waypoint, GeoPoint location,
                const FAITrianglePointValidator &triangle_validator) const;
 
+  /**
+   * Like Matches(), but ignores #name.  This is used for waypoints
+   * which were found by a #WaypointNameSearch.
+   */
+  [[gnu::pure]]
+  bool MatchesExceptName(const Waypoint &waypoint, GeoPoint location,
+                         const FAITrianglePointValidator &triangle_validator) const;
+
 private:
   static bool CompareType(const Waypoint &waypoint, TypeFilter type,
                           const FAITrianglePointValidator &triangle_validator);
@@ -5,16 +5,35 @@
 #include "WaypointList.hpp"
 #include "WaypointFilter.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Waypoint/NameIndex.hpp"
 
 void
 WaypointListBuilder::Visit(const Waypoints &waypoints) noexcept
 {
+  /* not Waypoints::VisitNearest(): the list shows every match in
+     range, so there is no early stop, and the flat projection's
+     order is not exact enough to skip SortByDistance() */
   if (filter.distance > 0)
     waypoints.VisitWithinRange(location, filter.distance, *this);
   else
     waypoints.VisitNamePrefix(filter.name, *this);
 }
 
+void
+WaypointListBuilder::Visit(WaypointNameSearch &name_search) noexcept
+{
+  for (const auto &match : name_search.Update(filter.name.c_str())) {
+    const Waypoint &waypoint = *match.waypoint;
+
+    if (filter.distance > 0 &&
+        location.DistanceS(waypoint.location) > filter.distance)
+      continue;
+
+    if (filter.MatchesExceptName(waypoint, location, triangle_validator))
+      list.emplace_back(match.waypoint);
+  }
+}
+
 inline void
 WaypointListBuilder::operator()(const WaypointPtr &waypoint) noexcept
 {
@@ -10,6 +10,7 @@
 struct WaypointFilter;
 class WaypointList;
 class Waypoints;
+class WaypointNameSearch;
 
 class WaypointListBuilder final {
   const WaypointFilter &filter;
@@ -27,5 +28,12 @@ public:
 
   void Visit(const Waypoints &waypoints) noexcept;
 
+  /**
+   * Add the waypoints found by searching the filter's name, ranked
+   * by the quality of the name match.  Unlike Visit(), this finds
+   * substrings and tolerates typos.
+   */
+  void Visit(WaypointNameSearch &name_search) noexcept;
+
   void operator()(const WaypointPtr &waypoint) noexcept;
 };
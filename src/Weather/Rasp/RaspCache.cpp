@@ -8,15 +8,148 @@
 #include "Language/Language.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/StandbyThread.hpp"
+#include "util/StaticArray.hxx"
 #include "LogFile.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <span>
 #include <windef.h> // for MAX_PATH
 
+/**
+ * Load the map of one parameter at one time index.
+ *
+ * Throws on error.
+ */
+static std::unique_ptr<RasterMap>
+LoadMap(const RaspStore &store, unsigned parameter, unsigned time,
+        OperationEnvironment &operation)
+{
+  auto archive = store.OpenArchive();
+  if (!archive)
+    return nullptr;
+
+  char name[MAX_PATH];
+  store.WeatherFilename(name, Path(store.GetItemInfo(parameter).name), time);
+
+  auto map = std::make_unique<RasterMap>();
+  LoadTerrainOverview(archive->get(), name, nullptr,
+                      map->GetTileCache(),
+                      true, operation);
+  map->UpdateProjection();
+  return map;
+}
+
+/**
+ * An #OperationEnvironment which gets cancelled as soon as the
+ * given flag is set.
+ */
+class PreloadOperationEnvironment final : public QuietOperationEnvironment {
+  const std::atomic_bool &cancelled;
+
+public:
+  explicit PreloadOperationEnvironment(const std::atomic_bool &_cancelled) noexcept
+    :cancelled(_cancelled) {}
+
+  /* virtual methods from class OperationEnvironment */
+  bool IsCancelled() const noexcept override {
+    return cancelled.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * A thread which loads maps which are likely to be needed soon.
+ */
+class RaspCache::Preloader final : StandbyThread {
+  const RaspStore &store;
+  const unsigned parameter;
+
+  /**
+   * Set by Stop() to abort the JPEG2000 decoder, which runs without
+   * holding the mutex.
+   */
+  std::atomic_bool cancelled{false};
+
+  /**
+   * The time indexes to be loaded.
+   */
+  StaticArray<unsigned, 2> requests;
+
+  /**
+   * Maps which have been loaded, to be collected by
+   * RaspCache::CollectPreloaded().
+   */
+  std::list<CachedMap> loaded;
+
+public:
+  Preloader(const RaspStore &_store, unsigned _parameter) noexcept
+    :StandbyThread("RaspPreload"), store(_store), parameter(_parameter) {}
+
+  /**
+   * Stop the thread, cancelling a load which is in progress.
+   */
+  void Stop() noexcept {
+    cancelled.store(true, std::memory_order_relaxed);
+    LockStop();
+  }
+
+  /**
+   * Replace the pending requests.
+   */
+  void Request(std::span<const unsigned> times) {
+    const std::lock_guard lock{mutex};
+    requests.clear();
+    for (unsigned i : times)
+      requests.push_back(i);
+
+    if (!requests.empty())
+      Trigger();
+  }
+
+  std::list<CachedMap> TakeLoaded() noexcept {
+    const std::lock_guard lock{mutex};
+    return std::move(loaded);
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override {
+    SetIdlePriority();
+
+    while (!requests.empty() && !IsStopped()) {
+      const unsigned time = requests.front();
+      requests.remove(0);
+
+      std::unique_ptr<RasterMap> map;
+
+      {
+        const ScopeUnlock unlock(mutex);
+        PreloadOperationEnvironment operation{cancelled};
+        try {
+          map = LoadMap(store, parameter, time, operation);
+        } catch (...) {
+          if (!operation.IsCancelled())
+            LogError(std::current_exception(), "Failed to preload RASP file");
+        }
+      }
+
+      if (map && !IsStopped())
+        loaded.push_back({time, std::move(map)});
+    }
+  }
+};
+
 RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter) noexcept
   :store(_store), parameter(_parameter) {}
 
-RaspCache::~RaspCache() noexcept = default;
+RaspCache::~RaspCache() noexcept
+{
+  if (preloader)
+    preloader->Stop();
+}
 
 static constexpr unsigned
 ToQuarterHours(BrokenTime t)
@@ -60,6 +193,78 @@ RaspCache::IsInside(GeoPoint p) const
   return map != nullptr && map->IsInside(p);
 }
 
+bool
+RaspCache::IsCached(unsigned _time) const noexcept
+{
+  return std::any_of(maps.begin(), maps.end(), [_time](const auto &i){
+    return i.time == _time;
+  });
+}
+
+void
+RaspCache::Insert(unsigned _time, std::unique_ptr<RasterMap> &&new_map) noexcept
+{
+  maps.push_front({_time, std::move(new_map)});
+
+  while (maps.size() > MAX_CACHED_MAPS) {
+    assert(maps.back().map.get() != map);
+    maps.pop_back();
+  }
+}
+
+void
+RaspCache::CollectPreloaded() noexcept
+{
+  if (!preloader)
+    return;
+
+  for (auto &i : preloader->TakeLoaded()) {
+    if (IsCached(i.time))
+      continue;
+
+    /* insert behind the current map, because it has not been used
+       yet */
+    maps.insert(maps.empty() ? maps.end() : std::next(maps.begin()),
+                std::move(i));
+    if (maps.size() > MAX_CACHED_MAPS)
+      maps.pop_back();
+  }
+}
+
+void
+RaspCache::PreloadNeighbours(unsigned _time) noexcept
+{
+  StaticArray<unsigned, 2> requests;
+
+  for (unsigned i = _time + 1; i < RaspStore::MAX_WEATHER_TIMES; ++i) {
+    if (store.IsTimeAvailable(parameter, i)) {
+      if (!IsCached(i))
+        requests.push_back(i);
+      break;
+    }
+  }
+
+  for (unsigned i = _time; i-- > 0;) {
+    if (store.IsTimeAvailable(parameter, i)) {
+      if (!IsCached(i))
+        requests.push_back(i);
+      break;
+    }
+  }
+
+  if (requests.empty())
+    return;
+
+  if (!preloader)
+    preloader = std::make_unique<Preloader>(store, parameter);
+
+  try {
+    preloader->Request(requests);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to start RASP preloader");
+  }
+}
+
 void
 RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
 {
@@ -85,27 +290,33 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  map.reset();
+  CollectPreloaded();
 
-  auto archive = store.OpenArchive();
-  if (!archive)
-    return;
+  const auto i = std::find_if(maps.begin(), maps.end(),
+                              [effective_time](const auto &m){
+                                return m.time == effective_time;
+                              });
+  if (i != maps.end()) {
+    /* cache hit: make it the most recently used map */
+    maps.splice(maps.begin(), maps, i);
+    map = maps.front().map.get();
+  } else {
+    map = nullptr;
 
-  char new_name[MAX_PATH];
-  store.WeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
+    std::unique_ptr<RasterMap> new_map;
+    try {
+      new_map = LoadMap(store, parameter, effective_time, operation);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load RASP file");
+      return;
+    }
 
-  auto new_map = std::make_unique<RasterMap>();
-  try {
-    LoadTerrainOverview(archive->get(), new_name, nullptr,
-                        new_map->GetTileCache(),
-                        true, operation);
-  } catch (...) {
-    LogError(std::current_exception(), "Failed to load RASP file");
-    return;
-  }
+    if (!new_map)
+      return;
 
-  new_map->UpdateProjection();
+    map = new_map.get();
+    Insert(effective_time, std::move(new_map));
+  }
 
-  map = std::move(new_map);
+  PreloadNeighbours(effective_time);
 }
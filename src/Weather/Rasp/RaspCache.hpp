@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 
 struct BrokenTime;
@@ -14,6 +15,11 @@ class OperationEnvironment;
 /**
  * Class to manage the raster weather map, to be loaded/selected from
  * a #RaspStore instance.
+ *
+ * Recently used maps of the same parameter are kept in memory, and
+ * the neighbouring time steps of the current one are loaded in
+ * background, so stepping through the forecast does not need to
+ * decode a JPEG2000 file each time.
  */
 class RaspCache {
   const RaspStore &store;
@@ -23,7 +29,34 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  std::unique_ptr<RasterMap> map;
+  struct CachedMap {
+    /**
+     * The time index (an index which is available in the
+     * #RaspStore).
+     */
+    unsigned time;
+
+    std::unique_ptr<RasterMap> map;
+  };
+
+  /**
+   * The maximum number of maps in #maps.
+   */
+  static constexpr std::size_t MAX_CACHED_MAPS = 6;
+
+  /**
+   * Loaded maps, most recently used first.
+   */
+  std::list<CachedMap> maps;
+
+  /**
+   * The current map; if not nullptr, this is the first item of
+   * #maps.
+   */
+  const RasterMap *map = nullptr;
+
+  class Preloader;
+  std::unique_ptr<Preloader> preloader;
 
 public:
   RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
@@ -35,7 +68,7 @@ public:
 
   [[gnu::pure]]
   const RasterMap *GetMap() const {
-    return map.get();
+    return map;
   }
 
   /**
@@ -77,4 +110,25 @@ public:
    * Sets the current time index.
    */
   void SetTime(BrokenTime t);
+
+private:
+  /**
+   * Move the maps loaded by the #Preloader into #maps.
+   */
+  void CollectPreloaded() noexcept;
+
+  /**
+   * Insert a map as the most recently used one and evict the least
+   * recently used ones if there are too many.
+   */
+  void Insert(unsigned time, std::unique_ptr<RasterMap> &&new_map) noexcept;
+
+  [[gnu::pure]]
+  bool IsCached(unsigned time) const noexcept;
+
+  /**
+   * Ask the #Preloader to load the available time steps before and
+   * after the given one.
+   */
+  void PreloadNeighbours(unsigned time) noexcept;
 };
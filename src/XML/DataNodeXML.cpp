@@ -3,6 +3,7 @@
 
 #include "DataNodeXML.hpp"
 #include "Node.hpp"
+#include "Document.hpp"
 #include "util/StringAPI.hxx"
 
 const char *
@@ -20,7 +21,7 @@ WritableDataNodeXML::AppendChild(const char *name) noexcept
 std::unique_ptr<ConstDataNode>
 ConstDataNodeXML::GetChildNamed(const char *name) const noexcept
 {
-  const XMLNode *child = node.GetChildNode(name);
+  const XML::Element *child = node.GetChildNode(name);
   if (child == nullptr)
     return nullptr;
 
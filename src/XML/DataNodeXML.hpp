@@ -6,22 +6,23 @@
 #include "DataNode.hpp"
 
 class XMLNode;
+namespace XML { class Element; }
 
 /**
  * ConstDataNode implementation for XML files
  */
 class ConstDataNodeXML final : public ConstDataNode {
-  const XMLNode &node;
+  const XML::Element &node;
 
 public:
   /**
-   * Construct a node from an XMLNode
+   * Construct a node from an XML::Element
    *
-   * @param the_node XML node reflecting this node
+   * @param the_node XML element reflecting this node
    *
    * @return Initialised object
    */
-  explicit ConstDataNodeXML(const XMLNode &_node) noexcept
+  explicit ConstDataNodeXML(const XML::Element &_node) noexcept
     :node(_node) {}
 
   /* virtual methods from ConstDataNode */
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Document.hpp"
+#include "PullParser.hpp"
+#include "system/Path.hpp"
+#include "io/FileReader.hxx"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace XML {
+
+/**
+ * Files larger than this are refused by Document::ParseFile().
+ */
+static constexpr std::size_t MAX_FILE_SIZE = 1024 * 1024;
+
+const Element *
+Element::GetChildNode(const char *_name) const noexcept
+{
+  for (const auto &i : children)
+    if (StringIsEqualIgnoreCase(i.name, _name))
+      return &i;
+
+  return nullptr;
+}
+
+const char *
+Element::GetAttribute(const char *_name) const noexcept
+{
+  for (const auto &i : attributes)
+    if (StringIsEqualIgnoreCase(i.name, _name))
+      return i.value;
+
+  return nullptr;
+}
+
+Document
+Document::Parse(std::string_view src)
+{
+  Document document;
+  document.buffer.reset(new char[src.size() + 1]);
+  std::copy(src.begin(), src.end(), document.buffer.get());
+  document.buffer[src.size()] = '\0';
+
+  document.Build(src.size());
+  return document;
+}
+
+Document
+Document::ParseFile(Path path)
+{
+  FileReader reader{path};
+
+  const auto size = reader.GetSize();
+  if (size > MAX_FILE_SIZE)
+    throw std::runtime_error("File is too large");
+
+  Document document;
+  document.buffer.reset(new char[size + 1]);
+
+  const auto nbytes = reader.Read(std::as_writable_bytes(std::span{document.buffer.get(), static_cast<std::size_t>(size)}));
+  if (nbytes != size)
+    throw std::runtime_error{"Short read"};
+
+  document.buffer[size] = '\0';
+
+  document.Build(size);
+  return document;
+}
+
+void
+Document::Build(std::size_t size)
+{
+  char *const b = buffer.get();
+  const std::string_view src{b, size};
+
+  /* upper bounds; this avoids reallocating the arrays */
+  elements.reserve(std::count(src.begin(), src.end(), '<') + 1);
+  attributes.reserve(std::count(src.begin(), src.end(), '='));
+
+  /**
+   * An element which has not been closed yet.
+   */
+  struct OpenElement {
+    /**
+     * The position of the element in the "pending" array.  All
+     * items after it are its children.
+     */
+    std::size_t position;
+
+    std::string_view text;
+    bool text_in_buffer;
+  };
+
+  /* elements whose parent has not been closed yet */
+  std::vector<Element> pending;
+  std::vector<OpenElement> open;
+
+  /* the ends of all strings in the buffer; they are null-terminated
+     after parsing, because the parser still needs the characters
+     there */
+  std::vector<char *> terminators;
+
+  const auto ToMutable = [b](std::string_view s) noexcept {
+    return b + (s.data() - b);
+  };
+
+  const auto Terminate = [&](std::string_view s) -> const char * {
+    if (s.data() == nullptr)
+      return "";
+
+    char *p = ToMutable(s);
+    terminators.push_back(p + s.size());
+    return p;
+  };
+
+  const auto Decode = [&](std::string_view s) -> std::string_view {
+    if (s.find('&') == s.npos)
+      return s;
+
+    char *p = ToMutable(s);
+    return {p, DecodeEntities(s, p)};
+  };
+
+  PullParser parser{src};
+
+  while (true) {
+    const auto event = parser.Next();
+    if (event == PullParser::Event::END)
+      break;
+
+    if (event == PullParser::Event::START_ELEMENT) {
+      Element &e = pending.emplace_back();
+      e.name = Terminate(parser.GetName());
+      e.text = "";
+      e.first_child = e.n_children = 0;
+
+      e.first_attribute = attributes.size();
+      for (const auto &i : parser.GetAttributes())
+        attributes.push_back({Terminate(i.name), Terminate(Decode(i.value))});
+      e.n_attributes = attributes.size() - e.first_attribute;
+
+      open.push_back({pending.size() - 1, {}, true});
+    } else if (event == PullParser::Event::TEXT ||
+               event == PullParser::Event::CDATA) {
+      auto &o = open.back();
+      const auto text = event == PullParser::Event::TEXT
+        ? Decode(parser.GetText())
+        : parser.GetText();
+
+      if (o.text.empty()) {
+        o.text = text;
+      } else {
+        /* more than one text node: concatenate them outside of the
+           buffer */
+        auto &s = strings.emplace_front(o.text);
+        s.append(text);
+        o.text = s;
+        o.text_in_buffer = false;
+      }
+    } else {
+      /* END_ELEMENT: move the children to their final location */
+      const auto o = open.back();
+      open.pop_back();
+
+      Element &e = pending[o.position];
+      if (!o.text.empty())
+        e.text = o.text_in_buffer ? Terminate(o.text) : o.text.data();
+
+      e.first_child = elements.size();
+      e.n_children = pending.size() - o.position - 1;
+      elements.insert(elements.end(),
+                      std::next(pending.begin(), o.position + 1),
+                      pending.end());
+      pending.resize(o.position + 1);
+
+      if (open.empty()) {
+        /* the root element is complete; ignore the rest */
+        elements.push_back(e);
+        break;
+      }
+    }
+  }
+
+  if (elements.empty())
+    throw std::runtime_error("No elements found");
+
+  for (char *p : terminators)
+    *p = '\0';
+
+  for (auto &e : elements) {
+    e.children = {elements.data() + e.first_child, e.n_children};
+    e.attributes = {attributes.data() + e.first_attribute, e.n_attributes};
+  }
+}
+
+} // namespace XML
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+#include <forward_list>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Path;
+
+namespace XML {
+
+struct Attribute {
+  const char *name;
+  const char *value;
+};
+
+/**
+ * An element of a #Document.
+ */
+class Element {
+  friend class Document;
+
+  const char *name;
+
+  /**
+   * A concatenation of all text inside this element (with entities
+   * decoded); empty if there is none.
+   */
+  const char *text;
+
+  std::span<const Element> children;
+  std::span<const Attribute> attributes;
+
+  /* the positions of the children/attributes in the #Document
+     arrays; only used while building */
+  uint_least32_t first_child, n_children;
+  uint_least32_t first_attribute, n_attributes;
+
+public:
+  const char *GetName() const noexcept {
+    return name;
+  }
+
+  const char *GetText() const noexcept {
+    return text;
+  }
+
+  std::span<const Element> GetChildren() const noexcept {
+    return children;
+  }
+
+  auto begin() const noexcept {
+    return children.begin();
+  }
+
+  auto end() const noexcept {
+    return children.end();
+  }
+
+  std::span<const Attribute> GetAttributes() const noexcept {
+    return attributes;
+  }
+
+  /**
+   * @return the first child element with the specified name (case
+   * insensitive), or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const Element *GetChildNode(const char *name) const noexcept;
+
+  /**
+   * @return the value of the attribute with the specified name (case
+   * insensitive), or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const char *GetAttribute(const char *name) const noexcept;
+};
+
+/**
+ * A parsed XML document.
+ *
+ * The source is copied into one buffer, and the document is built
+ * "in place": entities are decoded inside this buffer, and names,
+ * values and text are null-terminated there.  All elements are
+ * stored in one array, with the children of each element being
+ * adjacent; all attributes are stored in another array.  This way,
+ * parsing allocates only a few large blocks instead of one per node
+ * and string.
+ */
+class Document {
+  std::unique_ptr<char[]> buffer;
+
+  std::vector<Element> elements;
+  std::vector<Attribute> attributes;
+
+  /**
+   * Strings which do not fit into #buffer (text which had to be
+   * concatenated).
+   */
+  std::forward_list<std::string> strings;
+
+  Document() noexcept = default;
+
+public:
+  Document(Document &&) noexcept = default;
+  Document &operator=(Document &&) noexcept = default;
+
+  /**
+   * Parse an XML document.  The string is copied; it does not need
+   * to stay valid after this call.
+   *
+   * Throws on error.
+   */
+  static Document Parse(std::string_view src);
+
+  /**
+   * Load and parse an XML file.
+   *
+   * Throws on error.
+   */
+  static Document ParseFile(Path path);
+
+  /**
+   * Returns the root element.
+   */
+  const Element &GetRoot() const noexcept {
+    return elements.back();
+  }
+
+private:
+  void Build(std::size_t size);
+};
+
+} // namespace XML
@@ -27,7 +27,6 @@
  */
 
 #include "Node.hpp"
-#include "util/StringAPI.hxx"
 
 XMLNode
 XMLNode::CreateRoot(const char *name) noexcept
@@ -49,24 +48,3 @@ XMLNode::AddChild(const std::string_view _name,
   children.push_back(XMLNode(_name, _is_declaration));
   return children.back();
 }
-
-const XMLNode *
-XMLNode::GetChildNode(const char *name) const noexcept
-{
-  for (const auto &i : children) {
-    if (StringIsEqualIgnoreCase(i.GetName(), name))
-      return &i;
-  }
-
-  return nullptr;
-}
-
-const char *
-XMLNode::GetAttribute(const char *name) const noexcept
-{
-  for (const auto &i : attributes)
-    if (StringIsEqualIgnoreCase(i.name.c_str(), name))
-      return i.value.c_str();
-
-  return nullptr;
-}
@@ -62,23 +62,15 @@ class XMLNode {
   std::forward_list<Attribute> attributes;
 
   /**
-   * Protected constructor: use "parse" functions to get your first
+   * Private constructor: use CreateRoot() to get your first
    * instance of XMLNode.
    */
   XMLNode(std::string_view name,
           bool is_declaration) noexcept;
 
 public:
-  static inline XMLNode Null() noexcept {
-    return XMLNode({}, false);
-  }
-
   static XMLNode CreateRoot(const char *name) noexcept;
 
-  bool IsNull() const noexcept {
-    return name.empty();
-  }
-
   /**
    * name of the node
    */
@@ -86,55 +78,10 @@ public:
     return name.c_str();
   }
 
-  using const_iterator = std::list<XMLNode>::const_iterator;
-
-  const_iterator begin() const noexcept {
-    return children.begin();
-  }
-
-  const_iterator end() const noexcept {
-    return children.end();
-  }
-
   bool HasChildren() const noexcept {
     return !children.empty() || !text.empty();
   }
 
-  /**
-   * @return the first child node, or nullptr if there is none
-   */
-  [[gnu::pure]]
-  const XMLNode *GetFirstChild() const noexcept {
-    return !children.empty()
-      ? &children.front()
-      : nullptr;
-  }
-
-  /**
-   * @return the first child node, or nullptr if there is none
-   */
-  [[gnu::pure]]
-  XMLNode *GetFirstChild() noexcept {
-    return !children.empty()
-      ? &children.front()
-      : nullptr;
-  }
-
-public:
-  /**
-   * @return ith child node with specific name (return an empty node
-   * if failing)
-   */
-  [[gnu::pure]]
-  const XMLNode *GetChildNode(const char *name) const noexcept;
-
-  /**
-   * @return ith attribute content with specific name (return a nullptr
-   * if failing)
-   */
-  [[gnu::pure]]
-  const char *GetAttribute(const char *name) const noexcept;
-
   /**
    * Create an XML file from the head element.
    *
@@ -1,49 +0,0 @@
-/**
- ****************************************************************************
- * <P> XML.c - implementation file for basic XML parser written in ANSI C++
- * for portability. It works by using recursion and a node tree for breaking
- * down the elements of an XML document.  </P>
- *
- * @version     V1.08
- *
- * @author      Frank Vanden Berghen
- * based on original implementation by Martyn C Brown
- *
- *
- * This library is free software; you can redistribute it and/or
- * modify it under the terms of the GNU Lesser General Public
- * License version 2.1 as published by the Free Software Foundation
- *
- * This library is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with this library; if not, write to the Free Software
- * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
- *
- ****************************************************************************
- */
-
-#pragma once
-
-#include <string_view>
-
-class XMLNode;
-class Path;
-
-namespace XML {
-
-/**
- * Throws on error.
- */
-XMLNode
-ParseString(std::string_view xml_string);
-
-/**
- * Throws on error.
- */
-XMLNode ParseFile(Path path);
-
-} // namespace XML
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PullParser.hpp"
+#include "util/CharUtil.hxx"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+#include "util/StringStrip.hxx"
+#include "util/UTF8.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <string.h>
+
+namespace XML {
+
+static constexpr bool
+IsNameEnd(char ch) noexcept
+{
+  return IsWhitespaceOrNull(ch) || ch == '/' || ch == '>' || ch == '=' ||
+    ch == '<';
+}
+
+static const char *
+SkipWhitespace(const char *p, const char *end) noexcept
+{
+  while (p < end && IsWhitespaceOrNull(*p))
+    ++p;
+  return p;
+}
+
+static const char *
+SkipName(const char *p, const char *end) noexcept
+{
+  while (p < end && !IsNameEnd(*p))
+    ++p;
+  return p;
+}
+
+PullParser::Event
+PullParser::Next()
+{
+  if (pending_end) {
+    pending_end = false;
+    stack.pop_back();
+    return Event::END_ELEMENT;
+  }
+
+  while (true) {
+    if (p == end) {
+      if (!stack.empty())
+        throw std::runtime_error("Unexpected end of file");
+
+      return Event::END;
+    }
+
+    if (*p != '<') {
+      const char *start = p;
+      p = std::find(p, end, '<');
+
+      const auto s = Strip(std::string_view{start, p});
+      if (s.empty() || stack.empty())
+        /* ignore whitespace and text outside of the root element
+           (e.g. a byte order mark) */
+        continue;
+
+      text = s;
+      return Event::TEXT;
+    }
+
+    if (p + 1 == end)
+      throw std::runtime_error("Unexpected end of file");
+
+    switch (p[1]) {
+    case '!':
+      if (std::string_view{p, end}.starts_with("<![CDATA[")) {
+        ParseCData();
+        if (text.empty() || stack.empty())
+          continue;
+
+        return Event::CDATA;
+      }
+
+      [[fallthrough]];
+
+    case '?':
+      SkipMarkup();
+      break;
+
+    case '/':
+      ParseEndTag();
+      return Event::END_ELEMENT;
+
+    default:
+      ParseStartTag();
+      return Event::START_ELEMENT;
+    }
+  }
+}
+
+void
+PullParser::SkipMarkup()
+{
+  const std::string_view rest{p, end};
+
+  std::string_view terminator = ">";
+  if (rest.starts_with("<!--"))
+    terminator = "-->";
+  else if (rest.starts_with("<?"))
+    terminator = "?>";
+
+  const auto i = rest.find(terminator, 2);
+  if (i == rest.npos)
+    throw std::runtime_error("Unexpected end of file");
+
+  p += i + terminator.size();
+}
+
+void
+PullParser::ParseCData()
+{
+  static constexpr std::string_view prefix = "<![CDATA[";
+  const std::string_view rest{p + prefix.size(), end};
+
+  const auto i = rest.find("]]>");
+  if (i == rest.npos)
+    throw std::runtime_error("Unexpected end of file");
+
+  text = rest.substr(0, i);
+  p = rest.data() + i + 3;
+}
+
+void
+PullParser::ParseStartTag()
+{
+  ++p;
+
+  const char *name_begin = p;
+  p = SkipName(p, end);
+  if (p == name_begin)
+    throw std::runtime_error("Missing start tag name");
+
+  name = {name_begin, p};
+  attributes.clear();
+
+  while (true) {
+    p = SkipWhitespace(p, end);
+    if (p == end)
+      throw std::runtime_error("Unexpected end of file");
+
+    if (*p == '>') {
+      ++p;
+      break;
+    }
+
+    if (*p == '/') {
+      if (p + 1 == end || p[1] != '>')
+        throw std::runtime_error("Unexpected token found");
+
+      p += 2;
+      pending_end = true;
+      break;
+    }
+
+    const char *attribute_begin = p;
+    p = SkipName(p, end);
+    if (p == attribute_begin)
+      throw std::runtime_error("Unexpected token found");
+
+    Attribute attribute{{attribute_begin, p}, {}};
+
+    p = SkipWhitespace(p, end);
+    if (p < end && *p == '=') {
+      p = SkipWhitespace(p + 1, end);
+      if (p == end)
+        throw std::runtime_error("Unexpected end of file");
+
+      if (*p == '"' || *p == '\'') {
+        const char quote = *p++;
+        const char *value_begin = p;
+        p = std::find(p, end, quote);
+        if (p == end)
+          throw std::runtime_error("Unterminated attribute value");
+
+        attribute.value = {value_begin, p};
+        ++p;
+      } else {
+        /* unquoted value */
+        const char *value_begin = p;
+        while (p < end && !IsWhitespaceOrNull(*p) && *p != '>' &&
+               (*p != '/' || p + 1 == end || p[1] != '>'))
+          ++p;
+
+        attribute.value = {value_begin, p};
+      }
+    }
+
+    attributes.push_back(attribute);
+  }
+
+  stack.push_back(name);
+}
+
+void
+PullParser::ParseEndTag()
+{
+  p += 2;
+
+  const char *name_begin = p;
+  p = SkipName(p, end);
+  name = {name_begin, p};
+
+  p = SkipWhitespace(p, end);
+  if (name.empty() || p == end || *p != '>')
+    throw std::runtime_error("Malformed end tag");
+
+  ++p;
+
+  if (stack.empty() || !StringIsEqualIgnoreCase(stack.back(), name))
+    throw std::runtime_error("Unmatched end tag");
+
+  stack.pop_back();
+}
+
+std::size_t
+DecodeEntities(std::string_view src, char *dest)
+{
+  const char *s = src.data();
+  const char *const end = s + src.size();
+  char *d = dest;
+
+  while (s < end) {
+    const char *amp = std::find(s, end, '&');
+
+    /* copy everything up to the next entity; memmove() because
+       decoding may happen in place */
+    const std::size_t length = amp - s;
+    memmove(d, s, length);
+    d += length;
+    s = amp;
+
+    if (s == end)
+      break;
+
+    const std::string_view rest{s + 1, end};
+    const auto semicolon = rest.find(';');
+    if (semicolon == rest.npos)
+      throw std::runtime_error("Malformed entity");
+
+    const std::string_view entity = rest.substr(0, semicolon);
+    s += 2 + semicolon;
+
+    /* case-insensitive, like the old XMLNode parser, because some
+       programs write "&AMP;" */
+    if (StringIsEqualIgnoreCase(entity, "lt"))
+      *d++ = '<';
+    else if (StringIsEqualIgnoreCase(entity, "gt"))
+      *d++ = '>';
+    else if (StringIsEqualIgnoreCase(entity, "amp"))
+      *d++ = '&';
+    else if (StringIsEqualIgnoreCase(entity, "apos"))
+      *d++ = '\'';
+    else if (StringIsEqualIgnoreCase(entity, "quot"))
+      *d++ = '"';
+    else if (entity.starts_with('#') && entity.size() > 1) {
+      const bool hex = entity[1] == 'x' || entity[1] == 'X';
+      const char *digits = entity.data() + (hex ? 2 : 1);
+      char *endptr;
+      unsigned ch = ParseUnsigned(digits, &endptr, hex ? 16 : 10);
+      if (endptr == digits || endptr != entity.data() + entity.size())
+        throw std::runtime_error("Malformed entity");
+
+      if (ch == 0)
+        ch = ' ';
+
+      /* the shortest entity for a multi-byte character is longer
+         than its UTF-8 encoding, so this never overwrites the
+         source */
+      char buffer[8];
+      const std::size_t n = UnicodeToUTF8(ch, buffer) - buffer;
+      d = std::copy_n(buffer, n, d);
+    } else
+      throw std::runtime_error("Malformed entity");
+  }
+
+  return d - dest;
+}
+
+} // namespace XML
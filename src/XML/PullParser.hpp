@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace XML {
+
+/**
+ * A non-validating XML tokenizer which works directly on a buffer
+ * (e.g. a #FileMapping).  All strings returned by it point into
+ * this buffer; entities are not decoded (see DecodeEntities()).
+ *
+ * XML declarations, processing instructions, comments and
+ * "<!DOCTYPE>" are skipped.  Whitespace around text is stripped,
+ * and whitespace-only text is not reported at all.  CDATA sections
+ * are reported verbatim.
+ */
+class PullParser {
+public:
+  enum class Event {
+    /**
+     * An element was opened.  Its name and attributes are available
+     * until the next Next() call.
+     */
+    START_ELEMENT,
+
+    /**
+     * An element was closed.  For an empty-element tag ("<a/>"),
+     * this event immediately follows #START_ELEMENT.
+     */
+    END_ELEMENT,
+
+    /**
+     * Text inside an element.
+     */
+    TEXT,
+
+    /**
+     * The contents of a CDATA section inside an element.  Unlike
+     * #TEXT, it must not be passed to DecodeEntities().
+     */
+    CDATA,
+
+    /**
+     * The end of the input was reached.
+     */
+    END,
+  };
+
+  struct Attribute {
+    std::string_view name;
+
+    /**
+     * The raw value (without quotes); empty if the attribute has no
+     * value.
+     */
+    std::string_view value;
+  };
+
+private:
+  const char *p;
+  const char *const end;
+
+  /**
+   * The names of all open elements; used to check the end tags.
+   */
+  std::vector<std::string_view> stack;
+
+  /**
+   * The attributes of the current element.  This vector is reused,
+   * therefore parsing does not allocate memory once it has grown
+   * large enough.
+   */
+  std::vector<Attribute> attributes;
+
+  std::string_view name, text;
+
+  /**
+   * Was the current element an empty-element tag?  Then the next
+   * event is #END_ELEMENT.
+   */
+  bool pending_end = false;
+
+public:
+  explicit PullParser(std::string_view src) noexcept
+    :p(src.data()), end(p + src.size()) {}
+
+  /**
+   * Read the next event.
+   *
+   * Throws std::runtime_error on syntax error.
+   */
+  Event Next();
+
+  /**
+   * The name of the element (#START_ELEMENT and #END_ELEMENT).
+   */
+  std::string_view GetName() const noexcept {
+    return name;
+  }
+
+  /**
+   * The raw text (#TEXT and #CDATA).
+   */
+  std::string_view GetText() const noexcept {
+    return text;
+  }
+
+  /**
+   * The attributes of the current element (#START_ELEMENT).
+   */
+  std::span<const Attribute> GetAttributes() const noexcept {
+    return attributes;
+  }
+
+  /**
+   * The nesting depth of the current position; 1 after the
+   * #START_ELEMENT of the root element.
+   */
+  std::size_t GetDepth() const noexcept {
+    return stack.size();
+  }
+
+private:
+  /**
+   * Skip a comment, a declaration or a "<!DOCTYPE>".
+   */
+  void SkipMarkup();
+
+  /**
+   * Parse a CDATA section into #text.
+   */
+  void ParseCData();
+
+  void ParseStartTag();
+  void ParseEndTag();
+};
+
+/**
+ * Decode the entities "&amp;", "&lt;", "&gt;", "&apos;", "&quot;"
+ * (case-insensitive) and numeric character references in the given
+ * string.  This can
+ * be done in place (@a dest == src.data()) because the result is
+ * never longer than the source.
+ *
+ * Throws std::runtime_error on a malformed entity.
+ *
+ * @param dest a buffer at least as large as the source
+ * @return the length of the decoded string
+ */
+std::size_t
+DecodeEntities(std::string_view src, char *dest);
+
+} // namespace XML
@@ -68,6 +68,7 @@ public:
 private:
 	void OnDeferredError() noexcept;
 
+protected:
 	/* virtual methods from CurlResponseHandler */
 	void OnHeaders(unsigned status, Headers &&headers) override;
 	void OnData(std::span<const std::byte> data) override;
@@ -21,7 +21,7 @@ public:
 	CoStreamRequest(CurlGlobal &global, CurlEasy &&easy, OutputStream &_os)
 		:CoRequest(global, std::move(easy)), os(_os) {}
 
-private:
+protected:
 	/* virtual methods from CurlResponseHandler */
 	void OnData(std::span<const std::byte> data) override;
 };
@@ -9,6 +9,10 @@
 #include "util/StringAPI.hxx"
 #include "Interface.hpp"
 
+extern "C" {
+#include <lauxlib.h>
+}
+
 namespace Lua {
 
 static void
@@ -41,70 +45,143 @@ static void PushOptional(lua_State *L, bool available, V &&value) {
 
 }
 
-static int
-l_blackboard_index(lua_State *L)
-{
-  const auto &basic = CommonInterface::Basic();
-  const auto &calculated = CommonInterface::Calculated();
+/**
+ * An attribute of "xcsoar.blackboard".
+ */
+struct BlackboardField {
+  const char *name;
 
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
-    return 0;
-  else if (StringIsEqual(name, "clock"))
+  void (*push)(lua_State *L, const MoreData &basic,
+               const DerivedInfo &calculated);
+};
+
+static constexpr BlackboardField blackboard_fields[] = {
+  {"clock", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::Push(L, basic.clock);
-  else if (StringIsEqual(name, "time"))
+  }},
+  {"time", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.time_available, basic.time);
-  else if (StringIsEqual(name, "date_time_utc"))
+  }},
+  {"date_time_utc", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.time_available, basic.date_time_utc);
-  else if (StringIsEqual(name, "location"))
+  }},
+  {"location", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.location_available, basic.location);
-  else if (StringIsEqual(name, "altitude"))
+  }},
+  {"altitude", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.NavAltitudeAvailable(), basic.nav_altitude);
-  else if (StringIsEqual(name, "altitude_agl"))
+  }},
+  {"altitude_agl", [](lua_State *L, const MoreData &, const DerivedInfo &calculated){
     Lua::PushOptional(L, calculated.altitude_agl_valid, calculated.altitude_agl);
-  else if (StringIsEqual(name, "track"))
+  }},
+  {"track", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.track_available, basic.track);
-  else if (StringIsEqual(name, "ground_speed"))
+  }},
+  {"ground_speed", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.ground_speed_available, basic.ground_speed);
-  else if (StringIsEqual(name, "air_speed"))
+  }},
+  {"air_speed", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.airspeed_available, basic.true_airspeed);
-  else if (StringIsEqual(name, "bank_angle"))
+  }},
+  {"bank_angle", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.attitude.bank_angle_available,
                       basic.attitude.bank_angle);
-  else if (StringIsEqual(name, "pitch_angle"))
+  }},
+  {"pitch_angle", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.attitude.pitch_angle_available,
                       basic.attitude.pitch_angle);
-  else if (StringIsEqual(name, "heading"))
+  }},
+  {"heading", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.attitude.heading_available, basic.attitude.heading);
-  else if (StringIsEqual(name, "g_load"))
+  }},
+  {"g_load", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.acceleration.available, basic.acceleration.g_load);
-  else if (StringIsEqual(name, "static_pressure"))
+  }},
+  {"static_pressure", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.static_pressure_available, basic.static_pressure.GetPascal());
-  else if (StringIsEqual(name, "pitot_pressure"))
+  }},
+  {"pitot_pressure", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.pitot_pressure_available, basic.pitot_pressure.GetPascal());
-  else if (StringIsEqual(name, "dynamic_pressure"))
+  }},
+  {"dynamic_pressure", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.dyn_pressure_available, basic.dyn_pressure.GetPascal());
-  else if (StringIsEqual(name, "temperature"))
+  }},
+  {"temperature", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.temperature_available,
                       basic.temperature.ToKelvin());
-  else if (StringIsEqual(name, "humidity"))
+  }},
+  {"humidity", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.humidity_available, basic.humidity);
-  else if (StringIsEqual(name, "voltage"))
+  }},
+  {"voltage", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.voltage_available, basic.voltage);
-  else if (StringIsEqual(name, "battery_level"))
+  }},
+  {"battery_level", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.battery_level_available, basic.battery_level);
-  else if (StringIsEqual(name, "noncomp_vario"))
+  }},
+  {"noncomp_vario", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.noncomp_vario_available, basic.noncomp_vario);
-  else if (StringIsEqual(name, "total_energy_vario"))
+  }},
+  {"total_energy_vario", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.total_energy_vario_available, basic.total_energy_vario);
-  else if (StringIsEqual(name, "netto_vario"))
+  }},
+  {"netto_vario", [](lua_State *L, const MoreData &basic, const DerivedInfo &){
     Lua::PushOptional(L, basic.netto_vario_available, basic.netto_vario);
-  else
+  }},
+};
+
+[[gnu::pure]]
+static const BlackboardField *
+FindBlackboardField(const char *name) noexcept
+{
+  for (const auto &i : blackboard_fields)
+    if (StringIsEqual(i.name, name))
+      return &i;
+
+  return nullptr;
+}
+
+static int
+l_blackboard_index(lua_State *L)
+{
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr)
     return 0;
 
+  const auto *field = FindBlackboardField(name);
+  if (field == nullptr)
+    return 0;
+
+  field->push(L, CommonInterface::Basic(), CommonInterface::Calculated());
   return 1;
 }
 
+/**
+ * xcsoar.blackboard.get(name, ...): return the values of all given
+ * attributes at once, which is cheaper than indexing the blackboard
+ * once per attribute.
+ */
+static int
+l_blackboard_get(lua_State *L)
+{
+  const auto &basic = CommonInterface::Basic();
+  const auto &calculated = CommonInterface::Calculated();
+
+  const int n = lua_gettop(L);
+  luaL_checkstack(L, n + LUA_MINSTACK, "Too many blackboard attributes");
+
+  for (int i = 1; i <= n; ++i) {
+    const char *name = luaL_checkstring(L, i);
+    const auto *field = FindBlackboardField(name);
+    if (field == nullptr)
+      return luaL_argerror(L, i, "Unknown blackboard attribute");
+
+    field->push(L, basic, calculated);
+  }
+
+  return n;
+}
+
 void
 Lua::InitBlackboard(lua_State *L)
 {
@@ -112,6 +189,8 @@ Lua::InitBlackboard(lua_State *L)
 
   lua_newtable(L);
 
+  SetField(L, RelativeStackIndex{-1}, "get", l_blackboard_get);
+
   MakeIndexMetaTableFor(L, RelativeStackIndex{-1}, l_blackboard_index);
 
   lua_setfield(L, -2, "blackboard");
@@ -11,6 +11,7 @@
 #include "Persistent.hpp"
 #include "ui/event/PeriodicTimer.hpp"
 #include "time/FloatDuration.hxx"
+#include "LogFile.hpp"
 
 extern "C" {
 #include <lauxlib.h>
@@ -28,6 +29,19 @@ class LuaTimer final {
    */
   Lua::Value timer;
 
+  /**
+   * A callback which runs longer than this blocks the user interface
+   * noticeably; it gets logged.
+   */
+  static constexpr std::chrono::steady_clock::duration CPU_BUDGET =
+    std::chrono::milliseconds{20};
+
+  /**
+   * The longest callback duration which has been logged so far; only
+   * new maxima are logged, to avoid flooding the log.
+   */
+  std::chrono::steady_clock::duration logged_duration{};
+
 public:
   explicit LuaTimer(lua_State *L, int callback_idx)
     :callback(L, Lua::StackIndex(callback_idx)), timer(L) {}
@@ -58,11 +72,26 @@ protected:
     const auto L = GetLuaState();
     const Lua::ScopeCheckStack check_stack(L);
 
+    const auto start_time = std::chrono::steady_clock::now();
+    const int start_kb = lua_gc(L, LUA_GCCOUNT, 0);
+
     callback.Push();
     timer.Push();
     if (lua_pcall(L, 1, 0, 0))
       Lua::ThrowError(L, Lua::PopError(L));
 
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+    if (duration > CPU_BUDGET && duration > logged_duration) {
+      logged_duration = duration;
+
+      /* the difference of the heap size is only an estimate of the
+         allocations, because the garbage collector may have run in
+         between */
+      LogFmt("Lua timer callback took {} ms, heap grew by {} kB",
+             std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(),
+             lua_gc(L, LUA_GCCOUNT, 0) - start_kb);
+    }
+
     Lua::CheckPersistent(L);
   }
 
@@ -7,8 +7,7 @@
 #include "Task/Ordered/OrderedTask.hpp"
 #include "Task/Deserialiser.hpp"
 #include "XML/DataNodeXML.hpp"
-#include "XML/Node.hpp"
-#include "XML/Parser.hpp"
+#include "XML/Document.hpp"
 #include "net/http/Progress.hpp"
 #include "lib/curl/CoStreamRequest.hxx"
 #include "lib/curl/Easy.hxx"
@@ -59,8 +58,8 @@ DownloadTask(CurlGlobal &curl, CurlEasy easy,
      eventually, so let's just ignore the Content-Type for now and
      hope the XML parser catches syntax errors */
 
-  const auto xml_node = XML::ParseString(sos.GetValue());
-  const ConstDataNodeXML data_node{xml_node};
+  const auto xml = XML::Document::Parse(sos.GetValue());
+  const ConstDataNodeXML data_node{xml.GetRoot()};
 
   auto task = std::make_unique<OrderedTask>(task_behaviour);
   LoadTask(*task, data_node, waypoints);
@@ -5,13 +5,18 @@
 #include "Progress.hpp"
 #include "lib/curl/Setup.hxx"
 #include "lib/curl/CoStreamRequest.hxx"
+#include "lib/curl/Error.hxx"
 #include "io/DigestOutputStream.hxx"
 #include "io/FileOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
 #include "system/Path.hpp"
 #include "lib/sodium/SHA256.hxx"
 
 #include <cassert>
 #include <optional>
+#include <stdexcept>
+#include <string>
 
 namespace Net {
 
@@ -50,4 +55,158 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
   co_return response;
 }
 
+AllocatedPath
+GetPartialDownloadPath(Path path) noexcept
+{
+  return path + ".part";
+}
+
+/**
+ * Feed the contents of a file into the digest.
+ */
+static void
+UpdateDigestFromFile(DigestOutputStream<SHA256State> &digest, Path path)
+{
+  FileReader reader{path};
+
+  std::byte buffer[16384];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer)) > 0)
+    digest.UpdateDigest(std::span{buffer, nbytes});
+}
+
+/**
+ * Did the server ignore the range request (see ResumeRequest)?
+ */
+[[gnu::pure]]
+static bool
+IsRangeError(std::exception_ptr e) noexcept
+{
+  try {
+    std::rethrow_exception(e);
+  } catch (const std::system_error &error) {
+    return error.code().category() == Curl::error_category &&
+      error.code().value() == CURLE_RANGE_ERROR;
+  } catch (...) {
+    return false;
+  }
+}
+
+/**
+ * A #Curl::CoStreamRequest which checks the HTTP status itself
+ * instead of relying on CURLOPT_FAILONERROR and
+ * CURLOPT_RESUME_FROM_LARGE: libcurl versions disagree on whether
+ * "416 Range Not Satisfiable" is an error, and libcurl's own range
+ * check hides the status of error responses.  The body of a 416
+ * response is discarded.
+ */
+class ResumeRequest final : public Curl::CoStreamRequest {
+  const uint64_t offset;
+
+  unsigned status = 0;
+
+public:
+  ResumeRequest(CurlGlobal &curl, CurlEasy &&easy, OutputStream &os,
+                uint64_t _offset)
+    :CoStreamRequest(curl, std::move(easy), os), offset(_offset) {}
+
+protected:
+  /* virtual methods from CurlResponseHandler */
+  void OnHeaders(unsigned _status, Curl::Headers &&headers) override {
+    status = _status;
+
+    if (offset > 0 && status == 200)
+      throw Curl::MakeError(CURLE_RANGE_ERROR,
+                            "Server ignored the range request");
+
+    if ((status < 200 || status >= 300) &&
+        (status != 416 || offset == 0))
+      throw Curl::MakeError(CURLE_HTTP_RETURNED_ERROR,
+                            "HTTP request failed");
+
+    CoStreamRequest::OnHeaders(status, std::move(headers));
+  }
+
+  void OnData(std::span<const std::byte> data) override {
+    if (status != 416)
+      CoStreamRequest::OnData(data);
+  }
+};
+
+Co::EagerTask<Curl::CoResponse>
+CoResumableDownloadToFile(CurlGlobal &curl, const char *url, Path path,
+                          const std::array<std::byte, 32> *expected_sha256,
+                          ProgressListener &progress)
+{
+  assert(url != nullptr);
+  assert(path != nullptr);
+
+  const auto partial_path = GetPartialDownloadPath(path);
+  const uint64_t offset = File::Exists(partial_path)
+    ? File::GetSize(partial_path)
+    : 0;
+
+  FileOutputStream file(partial_path,
+                        FileOutputStream::Mode::APPEND_OR_CREATE);
+  OutputStream *os = &file;
+
+  std::optional<DigestOutputStream<SHA256State>> digest;
+  if (expected_sha256 != nullptr) {
+    os = &digest.emplace(*os);
+
+    if (offset > 0)
+      UpdateDigestFromFile(*digest, partial_path);
+  }
+
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  const Net::ProgressAdapter progress_adapter{easy, progress,
+                                              (curl_off_t)offset};
+
+  if (offset > 0) {
+    /* not CURLOPT_RESUME_FROM_LARGE, see ResumeRequest */
+    const auto range = std::to_string(offset) + "-";
+    easy.SetOption(CURLOPT_RANGE, range.c_str());
+  }
+
+  std::exception_ptr error;
+  Curl::CoResponse response;
+  try {
+    response = co_await ResumeRequest(curl, std::move(easy), *os, offset);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  file.Commit();
+
+  if (error) {
+    if (offset > 0 && IsRangeError(error))
+      File::Delete(partial_path);
+
+    std::rethrow_exception(error);
+  }
+
+  if (response.status == 416 && expected_sha256 == nullptr) {
+    /* "Range Not Satisfiable": the partial file may already be
+       complete, but without a checksum, that can't be verified, so
+       start over */
+    File::Delete(partial_path);
+    throw std::runtime_error("Server rejected the resume offset");
+  }
+
+  if (expected_sha256 != nullptr) {
+    std::array<std::byte, 32> sha256;
+    digest->Final(std::span{sha256});
+    if (sha256 != *expected_sha256) {
+      File::Delete(partial_path);
+      throw std::runtime_error("SHA-256 mismatch");
+    }
+  }
+
+  if (!File::Replace(partial_path, path))
+    throw std::runtime_error("Failed to rename downloaded file");
+
+  co_return response;
+}
+
 } // namespace Net
@@ -10,6 +10,7 @@
 #include <cstddef> // for std::byte
 
 class Path;
+class AllocatedPath;
 class ProgressListener;
 
 namespace Net {
@@ -25,4 +26,37 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
                  Path path, std::array<std::byte, 32> *sha256,
                  ProgressListener &progress);
 
+/**
+ * Returns the path of the file which CoResumableDownloadToFile()
+ * writes to while the download is in progress.
+ */
+[[gnu::pure]]
+AllocatedPath
+GetPartialDownloadPath(Path path) noexcept;
+
+/**
+ * Like CoDownloadToFile(), but the data is appended to a partial
+ * file (see GetPartialDownloadPath()) which is kept if the transfer
+ * fails.  The next call continues at its end with a HTTP range
+ * request instead of starting from zero.  After the download has
+ * completed, the partial file is renamed to @a path.
+ *
+ * If the server ignores the range request or answers it with HTTP
+ * 416, the partial file is deleted, so the next call starts from the
+ * beginning.  Other errors keep the partial file.  (With
+ * @a expected_sha256, a 416 response is accepted if the partial file
+ * is already complete and matches the checksum.)
+ *
+ * Throws on error.
+ *
+ * @param expected_sha256 if not nullptr, then the contents are
+ * verified while being received (only a resumed prefix is read back
+ * from disk); on mismatch, the partial file is deleted and an
+ * exception is thrown
+ */
+Co::EagerTask<Curl::CoResponse>
+CoResumableDownloadToFile(CurlGlobal &curl, const char *url, Path path,
+                          const std::array<std::byte, 32> *expected_sha256,
+                          ProgressListener &progress);
+
 } // namespace Net
@@ -12,49 +12,133 @@
 #include "thread/Mutex.hxx"
 #include "thread/SafeList.hxx"
 #include "co/InjectTask.hxx"
+#include "system/FileUtil.hpp"
+#include "ui/event/Notify.hpp"
 
 #include <string>
 #include <list>
+#include <optional>
 #include <algorithm>
 
 #include <string.h>
 
-class DownloadManagerThread final
-  : ProgressListener {
-  struct Item {
+/**
+ * Manages the download queue.  All public methods must be called
+ * from the main thread, and the queue is only modified there; the
+ * downloads run in the CURL I/O thread, which reports completion via
+ * #notify.
+ */
+class DownloadManagerThread final {
+  /**
+   * The maximum number of downloads running at the same time.
+   */
+  static constexpr std::size_t MAX_PARALLEL = 3;
+
+  /**
+   * How often is a failed download attempted?  Each retry resumes
+   * where the previous attempt stopped.
+   */
+  static constexpr unsigned MAX_ATTEMPTS = 3;
+
+  struct Item final : ProgressListener {
+    DownloadManagerThread &parent;
+
     std::string uri;
     AllocatedPath path_relative;
 
+    std::optional<std::array<std::byte, 32>> sha256;
+
+    /**
+     * The coroutine performing this download.
+     */
+    Co::InjectTask task{Net::curl->GetEventLoop()};
+
+    /**
+     * Is this download currently running?  It remains set after
+     * the coroutine has finished until the main thread has handled
+     * the completion.
+     */
+    bool active = false;
+
+    unsigned attempts = 0;
+
+    /**
+     * Information about this download.  Protected by
+     * DownloadManagerThread::mutex.
+     */
+    int64_t size = -1, position = -1;
+
+    /**
+     * Set by OnCompletion() in the I/O thread, to be handled by
+     * DownloadManagerThread::OnNotification() in the main thread.
+     * Protected by DownloadManagerThread::mutex.
+     */
+    bool finished = false;
+    std::exception_ptr error;
+
+    Item(DownloadManagerThread &_parent,
+         const char *_uri, Path _path_relative,
+         const std::array<std::byte, 32> *_sha256) noexcept
+      :parent(_parent), uri(_uri), path_relative(_path_relative)
+    {
+      if (_sha256 != nullptr)
+        sha256 = *_sha256;
+    }
+
     Item(const Item &other) = delete;
+    Item &operator=(const Item &other) = delete;
 
-    Item(Item &&other) noexcept = default;
+    bool IsActive() const noexcept {
+      return active;
+    }
 
-    Item(const char *_uri, Path _path_relative) noexcept
-      :uri(_uri), path_relative(_path_relative) {}
+    /**
+     * Called by #task in the I/O thread.
+     */
+    void OnCompletion(std::exception_ptr _error) noexcept {
+      {
+        const std::lock_guard lock{parent.mutex};
+        finished = true;
+        error = std::move(_error);
+      }
 
-    Item &operator=(const Item &other) = delete;
+      parent.notify.SendNotification();
+    }
 
     [[gnu::pure]]
     bool operator==(Path other) const noexcept {
       return path_relative == other;
     }
-  };
 
-  /**
-   * The coroutine performing the current download.
-   */
-  Co::InjectTask task{Net::curl->GetEventLoop()};
+    /* methods from class ProgressListener */
+    void SetProgressRange(unsigned range) noexcept override {
+      const std::lock_guard lock{parent.mutex};
+      size = range;
+    }
+
+    void SetProgressPosition(unsigned _position) noexcept override {
+      const std::lock_guard lock{parent.mutex};
+      position = _position;
+    }
+  };
 
   Mutex mutex;
 
   /**
-   * Information about the current download, i.e. queue.front().
-   * Protected by #mutex.
+   * Sent by Item::OnCompletion().  Declared before #queue, because
+   * the destruction of #queue cancels the tasks, after which no
+   * notification can be sent anymore.
    */
-  int64_t current_size = -1, current_position = -1;
+  UI::Notify notify{[this]{ OnNotification(); }};
 
+  /**
+   * All downloads; the active ones and the queued ones in the order
+   * they were added.
+   */
   std::list<Item> queue;
 
+  std::size_t n_active = 0;
+
   ThreadSafeList<Net::DownloadListener *> listeners;
 
 public:
@@ -67,29 +151,38 @@ public:
   }
 
   void Enumerate(Net::DownloadListener &listener) noexcept {
-    for (auto i = queue.begin(), end = queue.end(); i != end; ++i) {
-      const Item &item = *i;
+    for (const Item &item : queue) {
+      int64_t size, position;
 
-      int64_t size = -1, position = -1;
-      if (i == queue.begin()) {
+      {
         const std::lock_guard lock{mutex};
-        size = current_size;
-        position = current_position;
+        size = item.size;
+        position = item.position;
       }
 
       listener.OnDownloadAdded(item.path_relative, size, position);
     }
   }
 
-  void Enqueue(const char *uri, Path path_relative) noexcept {
-    queue.emplace_back(uri, path_relative);
+  void Enqueue(const char *uri, Path path_relative,
+               const std::array<std::byte, 32> *sha256) noexcept {
+    if (std::find(queue.begin(), queue.end(), path_relative) != queue.end())
+      /* already queued; two downloads of the same file would
+         write to the same partial file */
+      return;
+
+    /* a partial file left over from an earlier session may belong
+       to an older version of the file on the server; only resume
+       downloads started in this session */
+    File::Delete(Net::GetPartialDownloadPath(LocalPath(path_relative)));
+
+    queue.emplace_back(*this, uri, path_relative, sha256);
 
     listeners.ForEach([path_relative](auto *listener){
       listener->OnDownloadAdded(path_relative, -1, -1);
     });
 
-    if (!task)
-      Start();
+    StartQueued();
   }
 
   void Cancel(Path relative_path) noexcept {
@@ -97,79 +190,148 @@ public:
     if (i == queue.end())
       return;
 
-    if (i == queue.begin()) {
-      /* current download; stop the thread to cancel the current file
-         and restart the thread to continue downloading the following
-         files */
-
-      task.Cancel();
-      current_size = current_position = -1;
-
-      if (!queue.empty())
-        Start();
-    } else {
-      /* queued download; simply remove it from the list */
-      queue.erase(i);
+    if (i->IsActive()) {
+      /* after this, Item::OnCompletion() is not running and
+         will not be called anymore; a completion which has not
+         yet been handled by OnNotification() is discarded with
+         the item */
+      i->task.Cancel();
+      --n_active;
+
+      /* the user does not want this file; don't keep the partial
+         download */
+      File::Delete(Net::GetPartialDownloadPath(LocalPath(relative_path)));
     }
 
+    queue.erase(i);
+
     listeners.ForEach([relative_path](auto *listener){
       listener->OnDownloadError(relative_path, {});
     });
+
+    StartQueued();
   }
 
 private:
-  void Start() noexcept;
-  void OnCompletion(std::exception_ptr error) noexcept;
-
-  /* methods from class ProgressListener */
-  void SetProgressRange(unsigned range) noexcept override {
-    const std::lock_guard lock{mutex};
-    current_size = range;
+  std::list<Item>::iterator Find(const Item &item) noexcept {
+    return std::find_if(queue.begin(), queue.end(), [&item](const Item &i){
+      return &i == &item;
+    });
   }
 
-  void SetProgressPosition(unsigned position) noexcept override {
-    const std::lock_guard lock{mutex};
-    current_position = position;
-  }
+  /**
+   * Start queued downloads until #MAX_PARALLEL are running.
+   */
+  void StartQueued() noexcept;
+
+  void Start(Item &item) noexcept;
+
+  /**
+   * Handle the downloads which have finished.
+   */
+  void OnNotification() noexcept;
+
+  void OnCompletion(Item &item, std::exception_ptr error) noexcept;
 };
 
 static Co::InvokeTask
 DownloadToFile(CurlGlobal &curl,
                const char *url, AllocatedPath path,
-               std::array<std::byte, 32> *sha256,
+               const std::array<std::byte, 32> *sha256,
                ProgressListener &progress)
 {
   const auto ignored_response = co_await
-    Net::CoDownloadToFile(curl, url, nullptr, nullptr,
-                          path, sha256, progress);
+    Net::CoResumableDownloadToFile(curl, url, path, sha256, progress);
 }
 
 void
-DownloadManagerThread::Start() noexcept
+DownloadManagerThread::StartQueued() noexcept
 {
-  assert(!queue.empty());
-  assert(!task);
-  assert(current_size == -1);
-  assert(current_position == -1);
-
-  const Item &item = queue.front();
-  current_position = 0;
-
-  task.Start(DownloadToFile(*Net::curl, item.uri.c_str(),
-                            LocalPath(item.path_relative.c_str()),
-                            nullptr, *this),
-             BIND_THIS_METHOD(OnCompletion));
+  for (auto &item : queue) {
+    if (n_active >= MAX_PARALLEL)
+      break;
+
+    if (!item.IsActive())
+      Start(item);
+  }
 }
 
 void
-DownloadManagerThread::OnCompletion(std::exception_ptr error) noexcept
+DownloadManagerThread::Start(Item &item) noexcept
 {
-  assert(!queue.empty());
+  assert(!item.IsActive());
+  assert(n_active < MAX_PARALLEL);
+
+  ++n_active;
+  ++item.attempts;
 
-  const AllocatedPath path_relative = std::move(queue.front().path_relative);
-  queue.pop_front();
+  {
+    const std::lock_guard lock{mutex};
+    item.size = -1;
+    item.position = 0;
+    item.finished = false;
+    item.error = {};
+  }
+
+  item.active = true;
+  item.task.Start(DownloadToFile(*Net::curl, item.uri.c_str(),
+                                 LocalPath(item.path_relative.c_str()),
+                                 item.sha256 ? &*item.sha256 : nullptr,
+                                 item),
+                  BIND_METHOD(item, &Item::OnCompletion));
+}
+
+void
+DownloadManagerThread::OnNotification() noexcept
+{
+  /* search from the beginning after each completion, because the
+     listeners may modify the queue */
+  while (true) {
+    Item *item = nullptr;
+    std::exception_ptr error;
+
+    {
+      const std::lock_guard lock{mutex};
+      for (auto &i : queue) {
+        if (i.finished) {
+          i.finished = false;
+          error = std::move(i.error);
+          item = &i;
+          break;
+        }
+      }
+    }
+
+    if (item == nullptr)
+      break;
+
+    OnCompletion(*item, std::move(error));
+  }
+}
+
+void
+DownloadManagerThread::OnCompletion(Item &item,
+                                    std::exception_ptr error) noexcept
+{
+  assert(item.IsActive());
+  assert(n_active > 0);
+
+  --n_active;
+  item.active = false;
+
+  if (error && item.attempts < MAX_ATTEMPTS) {
+    LogError(error, "Download failed, retrying");
+
+    /* move it to the end of the queue to give the other files a
+       chance */
+    queue.splice(queue.end(), queue, Find(item));
+    StartQueued();
+    return;
+  }
 
-  current_size = current_position = -1;
+  const auto i = Find(item);
+  const AllocatedPath path_relative = std::move(item.path_relative);
+  queue.erase(i);
 
   if (error) {
     LogError(error);
@@ -183,8 +345,7 @@ DownloadManagerThread::OnCompletion(std::exception_ptr error) noexcept
   }
 
   // start the next download
-  if (!queue.empty())
-    Start();
+  StartQueued();
 }
 
 static DownloadManagerThread *thread;
@@ -244,11 +405,12 @@ Net::DownloadManager::Enumerate(DownloadListener &listener) noexcept
 }
 
 void
-Net::DownloadManager::Enqueue(const char *uri, Path relative_path) noexcept
+Net::DownloadManager::Enqueue(const char *uri, Path relative_path,
+                              const std::array<std::byte, 32> *sha256) noexcept
 {
   assert(thread != nullptr);
 
-  thread->Enqueue(uri, relative_path);
+  thread->Enqueue(uri, relative_path, sha256);
 }
 
 void
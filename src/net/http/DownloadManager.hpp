@@ -5,6 +5,8 @@
 
 #include "Features.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 
@@ -59,7 +61,16 @@ void RemoveListener(DownloadListener &listener) noexcept;
  */
 void Enumerate(DownloadListener &listener) noexcept;
 
-void Enqueue(const char *uri, Path relative_path) noexcept;
+/**
+ * Add a download to the queue.  Up to three files are downloaded at
+ * the same time; a failed transfer is retried, continuing where it
+ * stopped.
+ *
+ * @param sha256 if not nullptr, the download fails if the contents
+ * do not match this SHA-256 digest
+ */
+void Enqueue(const char *uri, Path relative_path,
+             const std::array<std::byte, 32> *sha256=nullptr) noexcept;
 
 /**
  * Cancel the download.  The download may however be already
@@ -9,8 +9,9 @@
 
 namespace Net {
 
-ProgressAdapter::ProgressAdapter(CurlEasy &curl, ProgressListener &_listener)
-  :listener(_listener)
+ProgressAdapter::ProgressAdapter(CurlEasy &curl, ProgressListener &_listener,
+                                 curl_off_t _offset)
+  :listener(_listener), offset(_offset)
 {
   curl.SetXferInfoFunction(_Callback, this);
 }
@@ -25,6 +26,11 @@ ProgressAdapter::Callback(curl_off_t dltotal, curl_off_t dlnow,
   if (ultotal == 0)
     ulnow = 0;
 
+  if (dltotal > 0) {
+    dltotal += offset;
+    dlnow += offset;
+  }
+
   const auto range = dltotal + ultotal;
   if (range == 0 || range > UINT_MAX)
     /* no useful information at all (or overflow) */
@@ -17,12 +17,20 @@ namespace Net {
 class ProgressAdapter {
   ProgressListener &listener;
 
+  /**
+   * The number of bytes which were already present before this
+   * transfer started (when resuming a download).  It is added to
+   * the download position and range.
+   */
+  const curl_off_t offset;
+
 public:
   /**
    * Register as "xferinfo" callback with the given #CurlEasy and keep
    * reporting progress to the #OperationEnvironment instance.
    */
-  ProgressAdapter(CurlEasy &curl, ProgressListener &listener);
+  ProgressAdapter(CurlEasy &curl, ProgressListener &listener,
+                  curl_off_t _offset=0);
 
 private:
   void Callback(curl_off_t dltotal, curl_off_t dlnow,
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Mutex.hxx"
+#include "util/Serial.hpp"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * Passes immutable versions of a value from one producer thread to
+ * any number of consumer threads.  The producer copies its value into
+ * a new version and publishes it; consumers obtain a reference to the
+ * latest version and may read it as long as they like, without
+ * holding a lock and without blocking the producer.
+ *
+ * The mutex only protects the pointer to the latest version, i.e. it
+ * is held for a few instructions, never while copying the value.
+ * Versions which are no longer referenced by any consumer are
+ * recycled, so publishing does not allocate memory in the steady
+ * state.
+ */
+template<typename T>
+class SnapshotBuffer {
+public:
+  using Pointer = std::shared_ptr<const T>;
+
+private:
+  mutable Mutex mutex;
+
+  /**
+   * The latest version.  Protected by #mutex.
+   */
+  std::shared_ptr<T> latest;
+
+  /**
+   * Incremented by each Publish().  Protected by #mutex.
+   */
+  Serial serial;
+
+  /**
+   * An old version which is not referenced by anybody else; it will
+   * be overwritten by the next Publish().  Only accessed by the
+   * producer.
+   */
+  std::shared_ptr<T> spare;
+
+public:
+  /**
+   * Returns a version which is not visible to consumers.  The
+   * producer may fill it and pass it to PublishAllocated(); this
+   * avoids an extra copy if the producer needs its own copy of the
+   * value anyway.  Only the producer thread may call this method.
+   */
+  std::shared_ptr<T> Allocate() noexcept {
+    if (spare)
+      return std::move(spare);
+
+    return std::make_shared<T>();
+  }
+
+  /**
+   * Publish a copy of the given value.  Only the producer thread may
+   * call this method.
+   */
+  void Publish(const T &value) noexcept {
+    std::shared_ptr<T> next = Allocate();
+    *next = value;
+    PublishAllocated(std::move(next));
+  }
+
+  /**
+   * Publish a version obtained from Allocate().  The producer may
+   * keep a reference to it, but must not modify it anymore, and
+   * should drop the reference before publishing the next version, or
+   * else that version cannot be recycled.
+   */
+  void PublishAllocated(std::shared_ptr<T> next) noexcept {
+    {
+      const std::lock_guard lock{mutex};
+      next.swap(latest);
+      ++serial;
+    }
+
+    /* after the swap, no consumer can obtain a new reference to the
+       old version; if we hold the only one, it can be reused */
+    if (next && next.use_count() == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      spare = std::move(next);
+    }
+  }
+
+  /**
+   * Returns the latest version, or nullptr if nothing has been
+   * published yet.
+   */
+  Pointer Get() const noexcept {
+    const std::lock_guard lock{mutex};
+    return latest;
+  }
+
+  /**
+   * Like Get(), but returns nullptr if no new version has been
+   * published since the last call with the same #last_serial.
+   */
+  Pointer GetModified(Serial &last_serial) const noexcept {
+    const std::lock_guard lock{mutex};
+    if (serial == last_serial)
+      return nullptr;
+
+    last_serial = serial;
+    return latest;
+  }
+};
@@ -42,6 +42,16 @@ public:
     }
   }
 
+  /**
+   * Has Trigger() been called since the current Tick() began?  This
+   * allows Tick() to postpone low-priority work while new input is
+   * waiting.
+   */
+  bool IsTriggered() noexcept {
+    const std::lock_guard lock{mutex};
+    return trigger_flag;
+  }
+
   /**
    * Suspend execution until Resume() is called.
    */
@@ -23,6 +23,8 @@ class GLTexture;
 
 #ifdef USE_FREETYPE
 typedef struct FT_FaceRec_ *FT_Face;
+class GlyphCache;
+struct FreeTypeGlyph;
 #endif
 
 class FontDescription;
@@ -104,6 +106,27 @@ public:
   [[gnu::pure]]
   PixelSize TextSize(std::string_view text) const noexcept;
 
+#ifdef USE_FREETYPE
+  [[gnu::pure]]
+  bool HasKerning() const noexcept;
+
+  /**
+   * Look up the glyph for the given character, rasterising it into
+   * the cache on the first call.
+   *
+   * @return nullptr if the font has no glyph for this character
+   */
+  const FreeTypeGlyph *GetGlyph(GlyphCache &cache,
+                                unsigned ch) const noexcept;
+
+  /**
+   * Returns the horizontal kerning adjustment between two glyphs
+   * (by their FreeType glyph index).
+   */
+  int GetKerning(GlyphCache &cache,
+                 unsigned left, unsigned right) const noexcept;
+#endif
+
 #if defined(USE_FREETYPE) || defined(USE_APPKIT) || defined(USE_UIKIT)
   static constexpr std::size_t BufferSize(const PixelSize size) noexcept {
     return std::size_t(size.width) * std::size_t(size.height);
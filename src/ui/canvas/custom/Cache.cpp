@@ -7,12 +7,8 @@
 #include "util/StringCompare.hxx"
 #include "util/StringAPI.hxx"
 
-#ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Texture.hpp"
 #include "ui/canvas/opengl/Debug.hpp"
-#else
-#include "thread/Mutex.hxx"
-#endif
 
 #include <string_view>
 #include <cassert>
@@ -94,16 +90,10 @@ struct TextCacheKey {
 };
 
 struct RenderedText {
-#ifdef ENABLE_OPENGL
   std::unique_ptr<GLTexture> texture;
-#else
-  std::unique_ptr<uint8_t[]> data;
-  PixelSize size;
-#endif
 
   RenderedText(const RenderedText &other) = delete;
 
-#ifdef ENABLE_OPENGL
 #if defined(USE_FREETYPE) || defined(USE_APPKIT) || defined(USE_UIKIT)
   RenderedText(PixelSize size, const uint8_t *buffer) noexcept
     :texture(new GLTexture(GL_ALPHA, size,
@@ -115,10 +105,6 @@ struct RenderedText {
   RenderedText(std::unique_ptr<GLTexture> &&_texture) noexcept
     :texture(std::move(_texture)) {}
 #endif
-#else
-  RenderedText(PixelSize _size, std::unique_ptr<uint8_t[]> &&_data) noexcept
-    :data(std::move(_data)), size(_size) {}
-#endif
 
   RenderedText &operator=(const RenderedText &other) = delete;
 
@@ -126,41 +112,21 @@ struct RenderedText {
   RenderedText &operator=(RenderedText &&other) noexcept = default;
 
   operator TextCache::Result() const noexcept {
-#ifdef ENABLE_OPENGL
     return texture.get();
-#else
-    return { data.get(), size.width, size };
-#endif
   }
 
   [[gnu::pure]]
   PixelSize GetSize() const noexcept {
-#ifdef ENABLE_OPENGL
     return texture->GetSize();
-#else
-    return size;
-#endif
   }
 };
 
-#ifndef ENABLE_OPENGL
-/**
- * Without OpenGL, this library is accessed from DrawThread and UI
- * thread, therefore we need to protect it.
- */
-static Mutex text_cache_mutex;
-#endif
-
 static StaticCache<TextCacheKey, PixelSize, 1024u, 701u, TextCacheKey::Hash> size_cache;
 static StaticCache<TextCacheKey, RenderedText, 256u, 211u, TextCacheKey::Hash> text_cache;
 
 PixelSize
 TextCache::GetSize(const Font &font, std::string_view text) noexcept
 {
-#ifndef ENABLE_OPENGL
-  const std::lock_guard lock{text_cache_mutex};
-#endif
-
   TextCacheKey key(font, text);
   if (const PixelSize *cached = size_cache.Get(key))
     return *cached;
@@ -175,10 +141,6 @@ TextCache::GetSize(const Font &font, std::string_view text) noexcept
 PixelSize
 TextCache::LookupSize(const Font &font, std::string_view text) noexcept
 {
-#ifndef ENABLE_OPENGL
-  const std::lock_guard lock{text_cache_mutex};
-#endif
-
   if (text.empty())
     return {};
 
@@ -193,9 +155,7 @@ TextCache::LookupSize(const Font &font, std::string_view text) noexcept
 TextCache::Result
 TextCache::Get(const Font &font, std::string_view text) noexcept
 {
-#ifdef ENABLE_OPENGL
   assert(pthread_equal(pthread_self(), OpenGL::thread));
-#endif
   assert(font.IsDefined());
 
   if (text.empty())
@@ -205,10 +165,6 @@ TextCache::Get(const Font &font, std::string_view text) noexcept
 
   /* look it up */
 
-#ifndef ENABLE_OPENGL
-  const std::lock_guard lock{text_cache_mutex};
-#endif
-
   if (const RenderedText *cached = text_cache.Get(key))
     return *cached;
 
@@ -224,12 +180,8 @@ TextCache::Get(const Font &font, std::string_view text) noexcept
   std::unique_ptr<uint8_t[]> buffer{new uint8_t[buffer_size]};
 
   font.Render(text2, size, buffer.get());
-#ifdef ENABLE_OPENGL
   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
   RenderedText rt(size, buffer.get());
-#else
-  RenderedText rt(size, std::move(buffer));
-#endif
 
 #elif defined(ANDROID)
   auto texture = font.TextTextureGL(text);
@@ -254,13 +206,7 @@ TextCache::Get(const Font &font, std::string_view text) noexcept
 void
 TextCache::Flush() noexcept
 {
-#ifdef ENABLE_OPENGL
   assert(pthread_equal(pthread_self(), OpenGL::thread));
-#endif
-
-#ifndef ENABLE_OPENGL
-  const std::lock_guard lock{text_cache_mutex};
-#endif
 
   size_cache.Clear();
   text_cache.Clear();
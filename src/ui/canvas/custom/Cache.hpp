@@ -8,32 +8,14 @@
 #include <string_view>
 
 class Font;
-
-#ifdef ENABLE_OPENGL
 class GLTexture;
-#endif
 
+/**
+ * Caches rendered strings in OpenGL textures.
+ */
 namespace TextCache {
 
-#ifdef ENABLE_OPENGL
 typedef GLTexture *Result;
-#else
-struct Result {
-  const void *data;
-  unsigned pitch;
-  PixelSize size;
-
-  constexpr Result(const void *_data, unsigned _pitch, PixelSize _size) noexcept
-    :data(_data), pitch(_pitch), size(_size) {}
-
-  constexpr Result(std::nullptr_t) noexcept
-    :data{}, pitch{}, size{} {}
-
-  constexpr operator bool() const noexcept {
-    return data != nullptr;
-  }
-};
-#endif
 
 [[gnu::pure]]
 PixelSize
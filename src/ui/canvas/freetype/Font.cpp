@@ -6,6 +6,7 @@
 #include "ui/canvas/custom/Files.hpp"
 #include "Look/FontDescription.hpp"
 #include "Init.hpp"
+#include "GlyphCache.hpp"
 #include "Asset.hpp"
 #include "lib/fmt/RuntimeError.hxx"
 #include "system/Path.hpp"
@@ -14,8 +15,6 @@
 #include "thread/Mutex.hxx"
 #endif
 
-#include "util/UTF8.hpp"
-
 #if defined(__clang__) && defined(__arm__)
 /* work around warning: 'register' storage class specifier is
    deprecated */
@@ -28,7 +27,6 @@
 #include <algorithm>
 
 #include <cassert>
-#include <concepts>
 #include <cstdint>
 
 #ifndef ENABLE_OPENGL
@@ -73,16 +71,6 @@ FT_CEIL(FT_Long x) noexcept
   return FT_FLOOR(x + 63);
 }
 
-static unsigned
-NextChar(std::string_view &s) noexcept
-{
-  assert(!s.empty());
-
-  auto n = NextUTF8(s.data());
-  s.remove_prefix(n.second - s.data());
-  return n.first;
-}
-
 void
 Font::Initialise()
 {
@@ -199,64 +187,111 @@ Font::Destroy() noexcept
 
   ::FT_Done_Face(face);
   face = nullptr;
+
+  GlyphCache::Invalidate();
 }
 
 static void
-ForEachChar(std::string_view text, std::invocable<unsigned> auto f)
+ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
 {
-  assert(ValidateUTF8(text));
-
-  while (!text.empty()) {
-    const unsigned ch = NextChar(text);
-    f(ch);
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
   }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
 }
 
-template<typename T>
 static void
-ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
-             std::invocable<int, int, FT_GlyphSlot> auto f) noexcept
+ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
 {
-  const bool use_kerning = FT_HAS_KERNING(face);
+  dest = src;
+  dest.pitch = dest.width;
+  dest.buffer = new unsigned char[dest.pitch * dest.rows];
 
-  int x = 0;
-  unsigned prev_index = 0;
+  unsigned char *d = dest.buffer, *s = src.buffer;
+  for (unsigned y = 0; y < unsigned(dest.rows);
+       ++y, d += dest.pitch, s += src.pitch)
+    ConvertMono(d, s, dest.width);
+}
+
+bool
+Font::HasKerning() const noexcept
+{
+  return FT_HAS_KERNING(face);
+}
+
+const FreeTypeGlyph *
+Font::GetGlyph(GlyphCache &cache, unsigned ch) const noexcept
+{
+  assert(IsDefined());
+
+  if (const auto *glyph = cache.FindGlyph(face, ch))
+    return glyph->index != 0 ? glyph : nullptr;
+
+  FreeTypeGlyph glyph{};
 
 #ifndef ENABLE_OPENGL
   const std::lock_guard lock{freetype_mutex};
 #endif
 
-  ForEachChar(std::forward<T>(text),
-              [face, ascent_height, &f, use_kerning,
-               &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
-      if (i == 0)
-        return;
+  const FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0 || FT_Load_Glyph(face, i, load_flags) != 0) {
+    /* remember that this font cannot render this character */
+    cache.AddGlyph(face, ch, glyph, nullptr, 0);
+    return nullptr;
+  }
 
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
-        return;
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
 
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
+  glyph.index = i;
+  glyph.left = FT_FLOOR(metrics.horiBearingX);
+  glyph.top = int(ascent_height) - FT_FLOOR(metrics.horiBearingY);
+  glyph.right = glyph.left + FT_CEIL(metrics.width);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
 
-      if (use_kerning) {
-        if (prev_index != 0 && i != 0) {
-          FT_Vector delta;
-          FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
-                         &delta);
-          x += delta.x >> 6;
-        }
+  if (FT_Render_Glyph(slot, render_mode) != 0)
+    return &cache.AddGlyph(face, ch, glyph, nullptr, 0);
 
-        prev_index = i;
-      }
+  glyph.size = {slot->bitmap.width, slot->bitmap.rows};
 
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
-        glyph);
+  if (IsMono()) {
+    /* with anti-aliasing disabled, FreeType writes each pixel in one
+       bit; convert it to 1 byte per pixel */
+    FT_Bitmap bitmap;
+    ConvertMono(bitmap, slot->bitmap);
+    const auto &result = cache.AddGlyph(face, ch, glyph,
+                                        bitmap.buffer, bitmap.pitch);
+    delete[] bitmap.buffer;
+    return &result;
+  } else
+    return &cache.AddGlyph(face, ch, glyph,
+                           slot->bitmap.buffer, slot->bitmap.pitch);
+}
 
-      x += FT_CEIL(metrics.horiAdvance);
-    });
+int
+Font::GetKerning(GlyphCache &cache,
+                 unsigned left, unsigned right) const noexcept
+{
+  if (const int *kerning = cache.FindKerning(face, left, right))
+    return *kerning;
+
+  FT_Vector delta;
+
+  {
+#ifndef ENABLE_OPENGL
+    const std::lock_guard lock{freetype_mutex};
+#endif
+
+    if (FT_Get_Kerning(face, left, right, ft_kerning_default, &delta) != 0)
+      delta.x = 0;
+  }
+
+  const int kerning = delta.x >> 6;
+  cache.AddKerning(face, left, right, kerning);
+  return kerning;
 }
 
 PixelSize
@@ -265,18 +300,13 @@ Font::TextSize(std::string_view text) const noexcept
   int maxx = 0;
   int max_advance = 0;
 
-  ForEachGlyph(face, ascent_height, text,
-               [&maxx, &max_advance](int x, [[maybe_unused]] int y,
-                                     const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
-
-      int z = x + glyph_maxx;
+  ForEachGlyph(*this, text,
+               [&maxx, &max_advance](int x, const FreeTypeGlyph &glyph){
+      int z = x + glyph.right;
       if (z > maxx)
         maxx = z;
 
-      max_advance = x + FT_CEIL(metrics.horiAdvance);
+      max_advance = x + glyph.advance;
     });
 
   /* Use the wider of the visual bounding box (maxx) and the total
@@ -296,11 +326,11 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y) noexcept
+            const FreeTypeGlyph &glyph, int x, int y) noexcept
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
+  const uint8_t *src = glyph.data;
+  int width = glyph.size.width, height = glyph.size.height;
+  const int pitch = glyph.size.width;
 
   if (x < 0) {
     src -= x;
@@ -332,50 +362,6 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     MixLine(buffer, src, width);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y) noexcept
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(std::string_view text, const PixelSize size,
              void *_buffer) const noexcept
@@ -383,9 +369,10 @@ Font::Render(std::string_view text, const PixelSize size,
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.width, size.height, glyph,
-                  x, y);
+  ForEachGlyph(*this, text,
+               [size, buffer](int x, const FreeTypeGlyph &glyph){
+      if (glyph.data != nullptr)
+        RenderGlyph(buffer, size.width, size.height, glyph,
+                    x + glyph.left, glyph.top);
     });
 }
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "GlyphCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+/**
+ * Incremented by GlyphCache::Invalidate().
+ */
+static std::atomic_uint glyph_cache_generation{0};
+
+GlyphCache &
+GlyphCache::Get() noexcept
+{
+  thread_local GlyphCache instance;
+
+  const unsigned generation = glyph_cache_generation.load(std::memory_order_acquire);
+  if (instance.generation != generation || instance.IsFull()) {
+    instance.Clear();
+    instance.generation = generation;
+  }
+
+  return instance;
+}
+
+void
+GlyphCache::Invalidate() noexcept
+{
+  glyph_cache_generation.fetch_add(1, std::memory_order_release);
+}
+
+void
+GlyphCache::Clear() noexcept
+{
+  glyphs.clear();
+  kernings.clear();
+  pages.clear();
+  page_pointer = nullptr;
+  page_available = 0;
+}
+
+uint8_t *
+GlyphCache::Allocate(std::size_t size) noexcept
+{
+  if (size > PAGE_SIZE / 4)
+    /* huge glyphs get a page of their own */
+    return pages.emplace_back(new uint8_t[size]).get();
+
+  if (size > page_available) {
+    page_pointer = pages.emplace_back(new uint8_t[PAGE_SIZE]).get();
+    page_available = PAGE_SIZE;
+  }
+
+  uint8_t *p = page_pointer;
+  page_pointer += size;
+  page_available -= size;
+  return p;
+}
+
+const FreeTypeGlyph &
+GlyphCache::AddGlyph(const void *face, unsigned ch, FreeTypeGlyph glyph,
+                     const uint8_t *src, std::ptrdiff_t src_pitch) noexcept
+{
+  const std::size_t width = glyph.size.width, height = glyph.size.height;
+
+  if (src != nullptr && width > 0 && height > 0) {
+    uint8_t *dest = Allocate(width * height);
+    glyph.data = dest;
+
+    for (std::size_t y = 0; y < height; ++y, src += src_pitch, dest += width)
+      std::copy_n(src, width, dest);
+  } else {
+    glyph.size = {0, 0};
+    glyph.data = nullptr;
+  }
+
+  return glyphs.emplace(Key{face, ch, 0}, glyph).first->second;
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/canvas/Font.hpp"
+#include "ui/dim/Size.hpp"
+#include "util/UTF8.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A glyph rasterised by FreeType, stored in a #GlyphCache.
+ */
+struct FreeTypeGlyph {
+  /**
+   * The FreeType glyph index (for kerning); 0 if the font does not
+   * have a glyph for this character.
+   */
+  unsigned index;
+
+  /**
+   * The position of the bitmap's top left corner relative to the
+   * pen position at the top of the line.
+   */
+  int left, top;
+
+  /**
+   * The right edge of the glyph's bounding box relative to the pen
+   * position.
+   */
+  int right;
+
+  /**
+   * The horizontal distance to the next pen position.
+   */
+  int advance;
+
+  PixelSize size;
+
+  /**
+   * The 8 bit alpha bitmap with a pitch of #size.width; nullptr if
+   * the glyph is blank.
+   */
+  const uint8_t *data;
+};
+
+/**
+ * A cache of rasterised glyphs and kerning pairs.  Each thread has
+ * its own instance (see Get()), so lookups need no locking; only a
+ * miss needs to lock libfreetype.  The bitmaps are packed into large
+ * pages which are never moved, so the returned pointers remain
+ * valid until the cache is cleared.
+ *
+ * The cache is cleared by Get() when it has grown beyond one of the
+ * limits below; this is rare, because the set of fonts and
+ * characters in use is small.
+ */
+class GlyphCache {
+  static constexpr std::size_t PAGE_SIZE = 64 * 1024;
+
+  static constexpr std::size_t MAX_PAGES = 32;
+  static constexpr std::size_t MAX_GLYPHS = 4096;
+  static constexpr std::size_t MAX_KERNINGS = 16384;
+
+  struct Key {
+    const void *face;
+    unsigned a, b;
+
+    constexpr bool operator==(const Key &) const noexcept = default;
+
+    struct Hash {
+      [[gnu::pure]]
+      std::size_t operator()(const Key &key) const noexcept {
+        return std::hash<const void *>{}(key.face) ^
+          (std::size_t(key.a) * 31 + key.b);
+      }
+    };
+  };
+
+  std::unordered_map<Key, FreeTypeGlyph, Key::Hash> glyphs;
+  std::unordered_map<Key, int, Key::Hash> kernings;
+
+  std::vector<std::unique_ptr<uint8_t[]>> pages;
+
+  /**
+   * The free space in the most recently allocated page.
+   */
+  uint8_t *page_pointer = nullptr;
+  std::size_t page_available = 0;
+
+  /**
+   * The value of the global generation counter when this instance
+   * was last cleared.
+   */
+  unsigned generation = 0;
+
+public:
+  /**
+   * Returns the calling thread's instance.  If Invalidate() has been
+   * called since this thread's last call, or if the cache is full,
+   * it is cleared first.  Pointers obtained earlier are therefore
+   * only valid until the next call.
+   */
+  static GlyphCache &Get() noexcept;
+
+  /**
+   * Discard the contents of all threads' caches.  This must be
+   * called when a font is destroyed, because a new font may reuse
+   * its address.
+   */
+  static void Invalidate() noexcept;
+
+  [[gnu::pure]]
+  const FreeTypeGlyph *FindGlyph(const void *face,
+                                 unsigned ch) const noexcept {
+    auto i = glyphs.find({face, ch, 0});
+    return i != glyphs.end() ? &i->second : nullptr;
+  }
+
+  /**
+   * Add a glyph, copying its bitmap into the cache.
+   *
+   * @param src the source bitmap (1 byte per pixel) with the size
+   * #FreeTypeGlyph::size; may be nullptr
+   */
+  const FreeTypeGlyph &AddGlyph(const void *face, unsigned ch,
+                                FreeTypeGlyph glyph,
+                                const uint8_t *src,
+                                std::ptrdiff_t src_pitch) noexcept;
+
+  [[gnu::pure]]
+  const int *FindKerning(const void *face, unsigned left,
+                         unsigned right) const noexcept {
+    auto i = kernings.find({face, left, right});
+    return i != kernings.end() ? &i->second : nullptr;
+  }
+
+  void AddKerning(const void *face, unsigned left, unsigned right,
+                  int kerning) noexcept {
+    kernings.emplace(Key{face, left, right}, kerning);
+  }
+
+private:
+  [[gnu::pure]]
+  bool IsFull() const noexcept {
+    return pages.size() >= MAX_PAGES || glyphs.size() >= MAX_GLYPHS ||
+      kernings.size() >= MAX_KERNINGS;
+  }
+
+  void Clear() noexcept;
+
+  uint8_t *Allocate(std::size_t size) noexcept;
+};
+
+/**
+ * Lay out the given text and invoke the function for each glyph with
+ * the pen position and the glyph.  The glyph reference is only valid
+ * during the call.
+ */
+template<typename F>
+void
+ForEachGlyph(const Font &font, std::string_view text, F &&f) noexcept
+{
+  assert(ValidateUTF8(text));
+
+  /* obtain the cache only once, because Get() may clear it */
+  GlyphCache &cache = GlyphCache::Get();
+  const bool use_kerning = font.HasKerning();
+
+  int x = 0;
+  unsigned prev_index = 0;
+
+  while (!text.empty()) {
+    const auto n = NextUTF8(text.data());
+    text.remove_prefix(n.second - text.data());
+
+    const FreeTypeGlyph *glyph = font.GetGlyph(cache, n.first);
+    if (glyph == nullptr)
+      continue;
+
+    if (use_kerning) {
+      if (prev_index != 0)
+        x += font.GetKerning(cache, prev_index, glyph->index);
+
+      prev_index = glyph->index;
+    }
+
+    f(x, *glyph);
+
+    x += glyph->advance;
+  }
+}
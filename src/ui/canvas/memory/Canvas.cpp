@@ -6,7 +6,7 @@
 #include "ui/canvas/Util.hpp"
 #include "Optimised.hpp"
 #include "RasterCanvas.hpp"
-#include "ui/canvas/custom/Cache.hpp"
+#include "ui/canvas/freetype/GlyphCache.hpp"
 #include "Math/Angle.hpp"
 
 #ifdef __ARM_NEON__
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <string.h>
 
 class SDLRasterCanvas : public RasterCanvas<ActivePixelTraits> {
@@ -198,61 +199,42 @@ Canvas::DrawArc(PixelPoint center, unsigned radius,
 const PixelSize
 Canvas::CalcTextSize(std::string_view text) const noexcept
 {
-  const std::string_view text2 = text;
   assert(ValidateUTF8(text));
 
-  PixelSize size = { 0, 0 };
-
   if (font == nullptr)
-    return size;
-
-  /* see if the TextCache can handle this request */
-  size = TextCache::LookupSize(*font, text2);
-  if (size.height > 0)
-    return size;
+    return { 0, 0 };
 
-  return TextCache::GetSize(*font, text2);
+  return font->TextSize(text);
 }
 
-static TextCache::Result
-RenderText(const Font *font, std::string_view text) noexcept
+/**
+ * Blit the glyphs of the text directly from the #GlyphCache.
+ *
+ * @param max_width clip the text at this width (relative to p.x)
+ */
+static void
+DrawGlyphs(SDLRasterCanvas &canvas, PixelPoint p, int max_width,
+           const Font &font, std::string_view text, Color text_color)
 {
-  if (font == nullptr)
-    return nullptr;
+  ColoredAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
+    transparent(canvas.Import(text_color));
 
-  assert(font->IsDefined());
+  ForEachGlyph(font, text, [&](int x, const FreeTypeGlyph &glyph){
+    if (glyph.data == nullptr)
+      return;
 
-  return TextCache::Get(*font, text);
-}
+    x += glyph.left;
+    if (x >= max_width)
+      return;
 
-template<typename Operations>
-static void
-CopyTextRectangle(SDLRasterCanvas &canvas, int x, int y,
-                  unsigned width, unsigned height,
-                  Operations o, TextCache::Result s)
-{
-  typedef typename Operations::SourcePixelTraits SourcePixelTraits;
-  canvas.CopyRectangle<decltype(o), SourcePixelTraits>
-    (x, y, width, height,
-     typename SourcePixelTraits::const_pointer(s.data),
-     s.pitch, o);
-}
+    const unsigned width = std::min(glyph.size.width,
+                                    unsigned(max_width - x));
 
-static void
-CopyTextRectangle(SDLRasterCanvas &canvas, int x, int y,
-                  unsigned width, unsigned height,
-                  TextCache::Result s,
-                  Color text_color, Color background_color, bool opaque)
-{
-  if (opaque) {
-    OpaqueAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
-      opaque(canvas.Import(background_color), canvas.Import(text_color));
-    CopyTextRectangle(canvas, x, y, width, height, opaque, s);
-  } else {
-    ColoredAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
-      transparent(canvas.Import(text_color));
-    CopyTextRectangle(canvas, x, y, width, height, transparent, s);
-  }
+    canvas.CopyRectangle<decltype(transparent), GreyscalePixelTraits>
+      (p.x + x, p.y + glyph.top, width, glyph.size.height,
+       GreyscalePixelTraits::const_pointer(glyph.data),
+       glyph.size.width, transparent);
+  });
 }
 
 void
@@ -260,14 +242,14 @@ Canvas::DrawText(PixelPoint p, std::string_view text) noexcept
 {
   assert(ValidateUTF8(text));
 
-  auto s = RenderText(font, text);
-  if (!s)
+  if (font == nullptr)
     return;
 
+  if (background_mode == OPAQUE)
+    DrawFilledRectangle({p, font->TextSize(text)}, background_color);
+
   SDLRasterCanvas canvas(buffer);
-  CopyTextRectangle(canvas, p.x, p.y, s.size.width, s.size.height, s,
-                    text_color, background_color,
-                    background_mode == OPAQUE);
+  DrawGlyphs(canvas, p, std::numeric_limits<int>::max(), *font, text, text_color);
 }
 
 void
@@ -275,14 +257,11 @@ Canvas::DrawTransparentText(PixelPoint p, std::string_view text) noexcept
 {
   assert(ValidateUTF8(text));
 
-  auto s = RenderText(font, text);
-  if (s.data == nullptr)
+  if (font == nullptr)
     return;
 
   SDLRasterCanvas canvas(buffer);
-  ColoredAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
-    transparent(canvas.Import(text_color));
-  CopyTextRectangle(canvas, p.x, p.y, s.size.width, s.size.height, transparent, s);
+  DrawGlyphs(canvas, p, std::numeric_limits<int>::max(), *font, text, text_color);
 }
 
 void
@@ -300,18 +279,18 @@ Canvas::DrawClippedText(PixelPoint p, unsigned width,
 {
   assert(ValidateUTF8(text));
 
-  auto s = RenderText(font, text);
-  if (s.data == nullptr)
+  if (font == nullptr)
     return;
 
-  if (width > s.size.width)
-    width = s.size.width;
+  if (background_mode == OPAQUE) {
+    PixelSize size = font->TextSize(text);
+    if (width < size.width)
+      size.width = width;
+    DrawFilledRectangle({p, size}, background_color);
+  }
 
   SDLRasterCanvas canvas(buffer);
-  CopyTextRectangle(canvas, p.x, p.y, width, s.size.height, s,
-                    text_color, background_color,
-                    background_mode == OPAQUE);
-
+  DrawGlyphs(canvas, p, int(width), *font, text, text_color);
 }
 
 static bool
@@ -3,8 +3,6 @@
 
 #pragma once
 
-#define HAVE_TEXT_CACHE
-
 #define HAVE_ALPHA_BLEND
 
 #if defined(USE_FB) && !defined(KOBO)
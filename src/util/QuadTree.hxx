@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <limits>
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include <cassert>
 
@@ -1383,4 +1386,98 @@ public:
 			      V &visitor) const {
 		VisitWithinRange(GetPosition(value), range, visitor);
 	}
+
+	/**
+	 * Invoke the visitor for all values within the range which
+	 * match the predicate, in ascending order of distance, until
+	 * the visitor returns false.
+	 *
+	 * This is a best-first traversal: buckets are examined in the
+	 * order of their minimum distance to the location, so a query
+	 * for the k nearest values only touches the buckets around the
+	 * location instead of all buckets within the range.
+	 *
+	 * @param visitor a callable receiving the value and its square
+	 * distance, returning false to stop
+	 */
+	template<class P, class V>
+	void VisitNearestIf(const Point location, distance_type range,
+			    const P &predicate, V &&visitor) const {
+		if (IsEmpty())
+			return;
+
+		/* a bucket (with its bounds) or a single value, ordered
+		   by the minimum distance */
+		struct Item {
+			distance_type square_distance;
+			const Bucket *bucket;
+			const Leaf *leaf;
+			Rectangle bounds;
+
+			constexpr bool operator>(const Item &other) const noexcept {
+				return square_distance > other.square_distance;
+			}
+		};
+
+		std::priority_queue<Item, std::vector<Item>,
+				    std::greater<Item>> queue;
+
+		const distance_type square_range = Square(range);
+
+		/* the root bounds may be empty in a "flat" tree, so the
+		   root is always examined */
+		queue.push({0, &root, nullptr, bounds});
+
+		while (!queue.empty()) {
+			const Item item = queue.top();
+			queue.pop();
+
+			if (item.leaf != nullptr) {
+				if (!visitor(item.leaf->value,
+					     item.square_distance))
+					return;
+
+				continue;
+			}
+
+			const Bucket &bucket = *item.bucket;
+			if (bucket.IsSplitted()) {
+				const Point middle = item.bounds.GetMiddle();
+				const Rectangle child_bounds[QuadBucket::N] = {
+					QuadBucket::GetTopLeft(item.bounds, middle),
+					QuadBucket::GetTopRight(item.bounds, middle),
+					QuadBucket::GetBottomLeft(item.bounds, middle),
+					QuadBucket::GetBottomRight(item.bounds, middle),
+				};
+
+				for (unsigned i = 0; i < QuadBucket::N; ++i) {
+					const Bucket &child = bucket.children->buckets[i];
+					if (child.IsEmpty())
+						continue;
+
+					const distance_type d =
+						child_bounds[i].SquareDistanceTo(location);
+					if (d <= square_range)
+						queue.push({d, &child, nullptr, child_bounds[i]});
+				}
+			} else {
+				for (const Leaf *leaf = bucket.leaves.head;
+				     leaf != nullptr; leaf = leaf->next) {
+					if (!predicate(leaf->value))
+						continue;
+
+					const distance_type d = leaf->SquareDistanceTo(location);
+					if (d <= square_range)
+						queue.push({d, nullptr, leaf, Rectangle{}});
+				}
+			}
+		}
+	}
+
+	template<class V>
+	void VisitNearest(const Point location, distance_type range,
+			  V &&visitor) const {
+		VisitNearestIf(location, range, AlwaysTrue(),
+			       std::forward<V>(visitor));
+	}
 };
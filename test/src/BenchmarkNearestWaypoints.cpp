@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compares the k-nearest waypoint query with a range query followed
+ * by sorting.  Without arguments, a synthetic waypoint set is used;
+ * optionally, a waypoint file may be specified.
+ */
+
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "system/Args.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr unsigned N_SYNTHETIC = 20000;
+static constexpr unsigned N_QUERIES = 4096;
+static constexpr unsigned K = 10;
+static constexpr double RANGE = 100000;
+
+static void
+AddSyntheticWaypoints(Waypoints &waypoints, std::mt19937 &random)
+{
+  std::uniform_real_distribution<double> latitude(45, 55);
+  std::uniform_real_distribution<double> longitude(0, 15);
+
+  for (unsigned i = 0; i < N_SYNTHETIC; ++i) {
+    Waypoint waypoint{GeoPoint(Angle::Degrees(longitude(random)),
+                               Angle::Degrees(latitude(random)))};
+    waypoint.original_id = i;
+    waypoint.name = "Waypoint";
+
+    if (i % 11 == 0)
+      waypoint.type = Waypoint::Type::AIRFIELD;
+    else if (i % 5 == 0)
+      waypoint.type = Waypoint::Type::OUTLANDING;
+
+    waypoints.Append(std::move(waypoint));
+  }
+}
+
+static bool
+IsLandable(const Waypoint &waypoint)
+{
+  return waypoint.IsLandable();
+}
+
+/**
+ * The traditional approach: collect everything within range, then
+ * sort.  This sorts by the spherical distance while the QuadTree uses
+ * the flat-earth projection, so near ties may be resolved
+ * differently.
+ */
+static unsigned
+FindNearestSorted(const Waypoints &waypoints, const GeoPoint &location,
+                  bool (*predicate)(const Waypoint &))
+{
+  std::vector<std::pair<double, WaypointPtr>> found;
+  waypoints.VisitWithinRange(location, RANGE, [&](const WaypointPtr &wp){
+    if (predicate == nullptr || predicate(*wp))
+      found.emplace_back(location.DistanceS(wp->location), wp);
+  });
+
+  const auto n = std::min<std::size_t>(found.size(), K);
+  std::partial_sort(found.begin(), found.begin() + n, found.end(),
+                    [](const auto &a, const auto &b){
+                      return a.first < b.first;
+                    });
+
+  return n > 0 ? found.front().second->original_id : 0;
+}
+
+static unsigned
+FindNearestBestFirst(const Waypoints &waypoints, const GeoPoint &location,
+                     bool (*predicate)(const Waypoint &))
+{
+  unsigned n = 0, first = 0;
+  waypoints.VisitNearest(location, RANGE, predicate,
+                         [&](const WaypointPtr &wp){
+                           if (n == 0)
+                             first = wp->original_id;
+                           return ++n < K;
+                         });
+  return first;
+}
+
+template<typename F>
+static void
+Run(const char *name, const std::vector<GeoPoint> &queries, F &&f)
+{
+  /* prevent gcc from optimizing the loop away */
+  unsigned long sum = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto &location : queries)
+    sum += f(location);
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  const double seconds = std::chrono::duration<double>(duration).count();
+  printf("%s: %.1f us per query (checksum %lu)\n", name,
+         seconds * 1e6 / queries.size(), sum);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[PATH]");
+
+  std::mt19937 random(42);
+
+  Waypoints waypoints;
+  if (args.IsEmpty()) {
+    AddSyntheticWaypoints(waypoints, random);
+  } else {
+    const auto path = args.ExpectNextPath();
+    args.ExpectEnd();
+
+    ConsoleOperationEnvironment operation;
+    ReadWaypointFile(path, waypoints,
+                     WaypointFactory(WaypointOrigin::NONE),
+                     operation);
+  }
+
+  waypoints.Optimise();
+
+  if (waypoints.IsEmpty()) {
+    fprintf(stderr, "No waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  /* query around randomly chosen waypoints */
+  std::vector<WaypointPtr> all(waypoints.begin(), waypoints.end());
+  std::uniform_int_distribution<std::size_t> pick(0, all.size() - 1);
+  std::vector<GeoPoint> queries;
+  queries.reserve(N_QUERIES);
+  for (unsigned i = 0; i < N_QUERIES; ++i)
+    queries.push_back(all[pick(random)]->location);
+
+  printf("%zu waypoints, %u nearest within %.0f km\n",
+         all.size(), K, RANGE / 1000);
+
+  Run("all, range+sort", queries, [&](const GeoPoint &location){
+    return FindNearestSorted(waypoints, location, nullptr);
+  });
+
+  Run("all, best-first", queries, [&](const GeoPoint &location){
+    return FindNearestBestFirst(waypoints, location, nullptr);
+  });
+
+  Run("landable, range+sort", queries, [&](const GeoPoint &location){
+    return FindNearestSorted(waypoints, location, IsLandable);
+  });
+
+  Run("landable, best-first", queries, [&](const GeoPoint &location){
+    return FindNearestBestFirst(waypoints, location, IsLandable);
+  });
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
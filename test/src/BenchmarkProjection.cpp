@@ -4,6 +4,10 @@
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
 
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
 unsigned Layout::scale_1024 = 1024;
 
 class TestProjection : public Projection {
@@ -16,20 +20,54 @@ public:
   }
 };
 
+static constexpr unsigned N_POINTS = 4096;
+static constexpr unsigned N_ROUNDS = 16 * 1024;
+
+static void
+Report(const char *name, std::chrono::steady_clock::duration duration)
+{
+  const double seconds = std::chrono::duration<double>(duration).count();
+  printf("%s: %.1f million points per second\n", name,
+         double(N_POINTS) * N_ROUNDS / seconds / 1e6);
+}
+
 int main()
 {
   TestProjection projection;
 
-  GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
-                         Angle::Degrees(51.051944444444445));
+  std::vector<GeoPoint> points;
+  std::vector<Angle> latitudes, longitudes;
+  for (unsigned i = 0; i < N_POINTS; ++i) {
+    const GeoPoint gp(Angle::Degrees(7.7061111111111114 + (i % 64) * 0.001),
+                      Angle::Degrees(51.051944444444445 + (i / 64) * 0.001));
+    points.push_back(gp);
+    latitudes.push_back(gp.latitude);
+    longitudes.push_back(gp.longitude);
+  }
+
+  std::vector<PixelPoint> dest(N_POINTS);
+
+  /* prevent gcc from optimizing the loops away */
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
-    auto rp = projection.GeoToScreen(gp);
 
-    /* prevent gcc from optimizing this loop away */
-    x += rp.x;
-    y += rp.y;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < N_ROUNDS; ++round) {
+    for (unsigned i = 0; i < N_POINTS; ++i)
+      dest[i] = projection.GeoToScreen(points[i]);
+
+    x += dest[round % N_POINTS].x;
   }
 
-  return x + y;
+  Report("scalar", std::chrono::steady_clock::now() - start);
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < N_ROUNDS; ++round) {
+    projection.GeoToScreen(latitudes, longitudes, dest);
+
+    y += dest[round % N_POINTS].y;
+  }
+
+  Report("batch", std::chrono::steady_clock::now() - start);
+
+  return (x + y) == 42;
 }
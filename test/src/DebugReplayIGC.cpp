@@ -2,17 +2,18 @@
 // Copyright The XCSoar Project
 
 #include "DebugReplayIGC.hpp"
-#include "io/FileLineReader.hpp"
-#include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
 #include "Units/System.hpp"
 #include "system/Path.hpp"
 
+#include <memory>
+
 DebugReplay*
 DebugReplayIGC::Create(Path input_file)
 {
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
-  return new DebugReplayIGC(reader);
+  std::unique_ptr<DebugReplayIGC> replay{new DebugReplayIGC()};
+  replay->fixes.Load(input_file);
+  return replay.release();
 }
 
 bool
@@ -20,26 +21,19 @@ DebugReplayIGC::Next()
 {
   last_basic = computed_basic;
 
-  const char *line;
-  while ((line = reader->ReadLine()) != NULL) {
-    if (line[0] == 'B') {
-      IGCFix fix;
-      if (IGCParseFix(line, extensions, fix)) {
-        CopyFromFix(fix);
-
-        Compute();
-        return true;
-      }
-    } else if (line[0] == 'H') {
-      BrokenDate date;
-      if (memcmp(line, "HFDTE", 5) == 0 &&
-          IGCParseDateRecord(line, date)) {
-        (BrokenDate &)raw_basic.date_time_utc = date;
-        raw_basic.time_available.Clear();
-      }
-    } else if (line[0] == 'I') {
-      IGCParseExtensions(line, extensions);
+  if (next < fixes.size()) {
+    /* apply the "HFDTE" records preceding this fix */
+    for (const auto dates = fixes.GetDateRecords();
+         next_date < dates.size() && dates[next_date].fix_index <= next;
+         ++next_date) {
+      (BrokenDate &)raw_basic.date_time_utc = dates[next_date].date;
+      raw_basic.time_available.Clear();
     }
+
+    CopyFromFix(fixes.GetFix(next++));
+
+    Compute();
+    return true;
   }
 
   if (computed_basic.time_available)
@@ -3,20 +3,31 @@
 
 #pragma once
 
-#include "DebugReplayFile.hpp"
-#include "IGC/IGCExtensions.hpp"
-#include "io/FileLineReader.hpp"
+#include "DebugReplay.hpp"
+#include "IGC/IGCFixTable.hpp"
 
+class Path;
 struct IGCFix;
 
-class DebugReplayIGC : public DebugReplayFile {
-  IGCExtensions extensions;
-
-private:
-  DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
-    extensions.clear();
-  }
+/**
+ * Replays an IGC file.  The whole file is decoded into an
+ * #IGCFixTable up front, which is much faster than parsing it line
+ * by line.
+ */
+class DebugReplayIGC : public DebugReplay {
+  IGCFixTable fixes;
+
+  /**
+   * The index of the next fix in #fixes.
+   */
+  std::size_t next = 0;
+
+  /**
+   * The index of the next record in IGCFixTable::GetDateRecords().
+   */
+  std::size_t next_date = 0;
+
+  DebugReplayIGC() = default;
 
 public:
   virtual bool Next();
@@ -16,14 +16,12 @@ int main(int argc, char **argv)
   FlarmNetDatabase database;
   FlarmNetReader::LoadFile(path, database);
 
-  for (auto i = database.begin(), end = database.end(); i != end; ++i) {
-    const FlarmNetRecord &record = i->second;
-
+  database.ForEach([](const FlarmNetRecord &record){
     char id_buf[16];
     printf("%s\t%s\t%s\t%s\n",
              record.id.Format(id_buf), record.pilot.c_str(),
              record.registration.c_str(), record.callsign.c_str());
-  }
+  });
 
   return EXIT_SUCCESS;
 }
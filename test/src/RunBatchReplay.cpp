@@ -0,0 +1,589 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replay a corpus of IGC/NMEA files through the complete
+ * #GlideComputer stack, as fast as the CPU allows, on several worker
+ * threads.  Each flight gets its own isolated computer, task manager
+ * and airspace database.  The results are written to stdout as JSON.
+ */
+
+#include "DebugReplay.hpp"
+#include "DebugReplayIGC.hpp"
+#include "DebugReplayNMEA.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "thread/Thread.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarning.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Contest/Solvers/Contests.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/TaskFile.hpp"
+#include "Formatter/TimeFormatter.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/StdioOutputStream.hxx"
+#include "json/Serialize.hxx"
+#include "util/Exception.hxx"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/string.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+static const char *const gce_names[] = {
+#include "InputEvents_Text2GCE.cpp"
+  nullptr
+};
+
+struct FlightEvent {
+  BrokenDateTime time;
+  std::string name;
+  std::string detail;
+};
+
+struct FlightResult {
+  AllocatedPath path;
+
+  /**
+   * A non-empty string if the flight could not be replayed.
+   */
+  std::string error;
+
+  unsigned n_fixes = 0;
+
+  /**
+   * The CPU time spent by the worker thread on this flight
+   * (excluding loading the task and airspace files).
+   */
+  std::chrono::duration<double> cpu_time{};
+
+  BrokenDateTime takeoff_time = BrokenDateTime::Invalid();
+  BrokenDateTime landing_time = BrokenDateTime::Invalid();
+
+  ContestStatistics contest_stats;
+
+  bool have_task = false;
+  TaskStats task_stats;
+
+  std::vector<FlightEvent> events;
+
+  explicit FlightResult(Path _path) noexcept
+    :path(_path) {
+    contest_stats.Reset();
+  }
+};
+
+/**
+ * The flight being replayed by the current thread.  This allows the
+ * fake event handlers below to attribute glide computer events to
+ * the right flight.
+ */
+static thread_local FlightResult *current_result;
+static thread_local const MoreData *current_basic;
+
+static void
+AddEvent(const char *name, std::string detail={}) noexcept
+{
+  if (current_result == nullptr)
+    return;
+
+  BrokenDateTime time = BrokenDateTime::Invalid();
+  if (current_basic != nullptr && current_basic->time_available &&
+      current_basic->date_time_utc.IsPlausible())
+    time = current_basic->date_time_utc;
+
+  current_result->events.push_back({time, name, std::move(detail)});
+}
+
+void
+ConditionMonitors::Update([[maybe_unused]] const NMEAInfo &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated,
+                          [[maybe_unused]] const ComputerSettings &settings) noexcept
+{
+}
+
+bool
+InputEvents::processGlideComputer(unsigned gce_id)
+{
+  if (gce_id < GCE_COUNT)
+    AddEvent(gce_names[gce_id]);
+  return false;
+}
+
+void Logger::LogStartEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogPoint([[maybe_unused]] const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+struct BatchConfig {
+  AllocatedPath task_path = nullptr;
+  AllocatedPath airspace_path = nullptr;
+  std::string driver_name;
+  Contest contest = Contest::OLC_PLUS;
+};
+
+static std::chrono::duration<double>
+GetThreadCPUTime() noexcept
+{
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) < 0)
+    return {};
+
+  return std::chrono::seconds{ts.tv_sec} +
+    std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+static const char *
+ToString(AirspaceWarning::State state) noexcept
+{
+  switch (state) {
+  case AirspaceWarning::WARNING_CLEAR:
+    return "clear";
+
+  case AirspaceWarning::WARNING_TASK:
+    return "task";
+
+  case AirspaceWarning::WARNING_FILTER:
+    return "filter";
+
+  case AirspaceWarning::WARNING_GLIDE:
+    return "glide";
+
+  case AirspaceWarning::WARNING_INSIDE:
+    return "inside";
+  }
+
+  return "unknown";
+}
+
+/**
+ * Keeps track of the last reported state of each airspace warning,
+ * and emits an event whenever one of them changes.
+ */
+class AirspaceWarningTracker {
+  std::map<const AbstractAirspace *, AirspaceWarning::State> states;
+
+public:
+  void Update(const AirspaceWarningManager &warnings) noexcept {
+    for (auto &i : states)
+      i.second = AirspaceWarning::WARNING_CLEAR;
+
+    for (const AirspaceWarning &warning : warnings) {
+      const auto state = warning.GetWarningState();
+      auto &last = states[&warning.GetAirspace()];
+      if (state > last) {
+        std::string detail = warning.GetAirspace().GetName();
+        detail += ": ";
+        detail += ToString(state);
+        AddEvent("AIRSPACE_WARNING", std::move(detail));
+      }
+
+      last = state;
+    }
+  }
+};
+
+static std::unique_ptr<DebugReplay>
+OpenReplay(const BatchConfig &config, Path path)
+{
+  if (path.EndsWithIgnoreCase(".igc"))
+    return std::unique_ptr<DebugReplay>(DebugReplayIGC::Create(path));
+
+  if (config.driver_name.empty())
+    throw std::runtime_error("No driver for NMEA file specified");
+
+  return std::unique_ptr<DebugReplay>(DebugReplayNMEA::Create(path,
+                                                              config.driver_name));
+}
+
+static void
+LoadAirspaces(Airspaces &airspaces, Path path)
+{
+  FileReader file_reader{path};
+  BufferedReader buffered_reader{file_reader};
+  ParseAirspaceFile(airspaces, buffered_reader);
+  airspaces.Optimise();
+}
+
+static void
+UpdateFlightTimes(const MoreData &basic, const FlyingState &flight,
+                  FlightResult &result) noexcept
+{
+  if (!basic.time_available || !basic.date_time_utc.IsDatePlausible())
+    return;
+
+  if (flight.flying && !result.takeoff_time.IsPlausible())
+    result.takeoff_time = basic.GetDateTimeAt(flight.takeoff_time);
+
+  if (!flight.flying && result.takeoff_time.IsPlausible() &&
+      !result.landing_time.IsPlausible())
+    result.landing_time = basic.GetDateTimeAt(flight.landing_time);
+}
+
+static void
+ReplayFlight(const BatchConfig &config, FlightResult &result)
+{
+  auto replay = OpenReplay(config, result.path);
+  if (replay == nullptr)
+    throw std::runtime_error("Failed to open replay file");
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+  settings.contest.contest = config.contest;
+
+  const Waypoints waypoints;
+
+  TaskManager task_manager(settings.task, waypoints);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  if (config.task_path != nullptr) {
+    auto task = TaskFile::GetTask(config.task_path, settings.task,
+                                  nullptr, 0);
+    if (task == nullptr)
+      throw std::runtime_error("Failed to load task");
+
+    protected_task_manager.TaskCommit(*task);
+    result.have_task = true;
+  }
+
+  Airspaces airspaces;
+  if (config.airspace_path != nullptr)
+    LoadAirspaces(airspaces, config.airspace_path);
+
+  GlideComputer glide_computer(settings, waypoints, airspaces,
+                               protected_task_manager, task_events);
+  glide_computer.SetTerrain(nullptr);
+  glide_computer.SetContestIncremental(false);
+  glide_computer.Initialise();
+
+  AirspaceWarningTracker warning_tracker;
+  Validity last_warning;
+  last_warning.Clear();
+
+  current_result = &result;
+  current_basic = &glide_computer.Basic();
+
+  const auto start_time = GetThreadCPUTime();
+
+  unsigned i = 0;
+  while (replay->Next()) {
+    ++result.n_fixes;
+
+    glide_computer.ReadBlackboard(replay->Basic());
+    glide_computer.ProcessGPS();
+
+    if (++i == 8) {
+      i = 0;
+      glide_computer.ProcessIdle();
+    }
+
+    const DerivedInfo &calculated = glide_computer.Calculated();
+    UpdateFlightTimes(glide_computer.Basic(), calculated.flight, result);
+
+    if (calculated.airspace_warnings.latest.Modified(last_warning)) {
+      last_warning = calculated.airspace_warnings.latest;
+
+      const ProtectedAirspaceWarningManager::Lease
+        lease(glide_computer.GetAirspaceWarnings());
+      warning_tracker.Update(lease);
+    }
+  }
+
+  glide_computer.ProcessExhaustive();
+
+  result.cpu_time = GetThreadCPUTime() - start_time;
+
+  current_basic = nullptr;
+  current_result = nullptr;
+
+  const MoreData &basic = glide_computer.Basic();
+  if (result.takeoff_time.IsPlausible() &&
+      !result.landing_time.IsPlausible() &&
+      basic.time_available && basic.date_time_utc.IsDatePlausible())
+    /* the log ends in flight */
+    result.landing_time = basic.date_time_utc;
+
+  result.contest_stats = glide_computer.Calculated().contest_stats;
+  result.task_stats = glide_computer.Calculated().ordered_task_stats;
+}
+
+/**
+ * Hands out the indices of the flights to be replayed to the worker
+ * threads.
+ */
+class BatchQueue {
+  std::vector<FlightResult> &flights;
+  std::atomic_size_t next{0};
+
+public:
+  explicit BatchQueue(std::vector<FlightResult> &_flights) noexcept
+    :flights(_flights) {}
+
+  FlightResult *Pop() noexcept {
+    const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+    return i < flights.size() ? &flights[i] : nullptr;
+  }
+};
+
+class BatchWorker final : public Thread {
+  const BatchConfig &config;
+  BatchQueue &queue;
+
+public:
+  BatchWorker(const BatchConfig &_config, BatchQueue &_queue) noexcept
+    :Thread("BatchReplay"), config(_config), queue(_queue) {}
+
+protected:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    FlightResult *result;
+    while ((result = queue.Pop()) != nullptr) {
+      try {
+        ReplayFlight(config, *result);
+      } catch (...) {
+        current_basic = nullptr;
+        current_result = nullptr;
+        result->error = GetFullMessage(std::current_exception());
+      }
+    }
+  }
+};
+
+static boost::json::value
+WriteTime(const BrokenDateTime &time) noexcept
+{
+  if (!time.IsPlausible())
+    return nullptr;
+
+  char buffer[64];
+  FormatISO8601(buffer, time);
+  return boost::json::string{buffer};
+}
+
+static boost::json::array
+WriteContest(const ContestStatistics &stats) noexcept
+{
+  boost::json::array array;
+
+  for (const ContestResult &result : stats.result) {
+    if (!result.IsDefined())
+      continue;
+
+    array.emplace_back(boost::json::object{
+        {"score", result.score},
+        {"distance", result.distance},
+        {"duration", result.time.count()},
+        {"speed", result.GetSpeed()},
+      });
+  }
+
+  return array;
+}
+
+static boost::json::object
+WriteTask(const TaskStats &stats) noexcept
+{
+  boost::json::object object;
+
+  object.emplace("started", stats.start.HasStarted());
+  object.emplace("finished", stats.task_finished);
+  object.emplace("elapsed", stats.total.time_elapsed.count());
+  object.emplace("travelled_distance", stats.total.travelled.GetDistance());
+  object.emplace("scored_distance", stats.distance_scored);
+
+  if (stats.total.time_elapsed.count() > 0)
+    object.emplace("scored_speed",
+                   stats.distance_scored / stats.total.time_elapsed.count());
+
+  return object;
+}
+
+static boost::json::array
+WriteEvents(const std::vector<FlightEvent> &events) noexcept
+{
+  boost::json::array array;
+
+  for (const auto &event : events) {
+    boost::json::object object;
+    object.emplace("time", WriteTime(event.time));
+    object.emplace("event", event.name);
+    if (!event.detail.empty())
+      object.emplace("detail", event.detail);
+    array.emplace_back(std::move(object));
+  }
+
+  return array;
+}
+
+static boost::json::object
+WriteFlight(const FlightResult &result, Contest contest) noexcept
+{
+  boost::json::object object;
+
+  object.emplace("file", result.path.c_str());
+
+  if (!result.error.empty()) {
+    object.emplace("error", result.error);
+    return object;
+  }
+
+  object.emplace("fixes", result.n_fixes);
+  object.emplace("cpu_time", result.cpu_time.count());
+  object.emplace("takeoff", WriteTime(result.takeoff_time));
+  object.emplace("landing", WriteTime(result.landing_time));
+
+  boost::json::object contest_object;
+  contest_object.emplace("name", ContestToString(contest));
+  contest_object.emplace("results", WriteContest(result.contest_stats));
+  object.emplace("contest", std::move(contest_object));
+
+  if (result.have_task)
+    object.emplace("task", WriteTask(result.task_stats));
+
+  object.emplace("events", WriteEvents(result.events));
+
+  return object;
+}
+
+[[gnu::pure]]
+static int
+ParseContest(const char *name) noexcept
+{
+  for (unsigned i = 0; i < unsigned(Contest::NONE); ++i)
+    if (StringIsEqualIgnoreCase(name, ContestToString(Contest(i))))
+      return i;
+
+  return -1;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] FILE...\n"
+            "Options:\n"
+            "  --jobs=N            Number of worker threads (default = 1)\n"
+            "  --task=FILE         Fly this task in every flight\n"
+            "  --airspace=FILE     Check airspace warnings against this file\n"
+            "  --driver=NAME       Device driver for NMEA files\n"
+            "  --contest=NAME      Contest to be scored (default = OLC Plus)");
+
+  BatchConfig config;
+  unsigned n_jobs = 1;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      char *endptr;
+      n_jobs = strtoul(value, &endptr, 10);
+      if (endptr == value || *endptr != 0 || n_jobs == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      config.task_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      config.airspace_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--driver=")) != nullptr) {
+      config.driver_name = value;
+    } else if ((value = StringAfterPrefix(arg, "--contest=")) != nullptr) {
+      const int contest = ParseContest(value);
+      if (contest < 0)
+        args.UsageError();
+      config.contest = Contest(contest);
+    } else {
+      args.UsageError();
+    }
+  }
+
+  if (args.IsEmpty())
+    args.UsageError();
+
+  std::vector<FlightResult> flights;
+  while (!args.IsEmpty())
+    flights.emplace_back(args.ExpectNextPath());
+
+  if (n_jobs > flights.size())
+    n_jobs = flights.size();
+
+  const auto start_time = std::chrono::steady_clock::now();
+
+  BatchQueue queue(flights);
+  std::vector<std::unique_ptr<BatchWorker>> workers;
+  workers.reserve(n_jobs);
+  for (unsigned i = 0; i < n_jobs; ++i) {
+    workers.emplace_back(std::make_unique<BatchWorker>(config, queue));
+    workers.back()->Start();
+  }
+
+  for (auto &worker : workers)
+    worker->Join();
+
+  const std::chrono::duration<double> wall_time =
+    std::chrono::steady_clock::now() - start_time;
+
+  std::chrono::duration<double> total_cpu_time{};
+  unsigned n_errors = 0;
+
+  boost::json::array flights_array;
+  for (const auto &flight : flights) {
+    total_cpu_time += flight.cpu_time;
+    if (!flight.error.empty())
+      ++n_errors;
+
+    flights_array.emplace_back(WriteFlight(flight, config.contest));
+  }
+
+  boost::json::object root;
+  root.emplace("jobs", n_jobs);
+  root.emplace("wall_time", wall_time.count());
+  root.emplace("cpu_time", total_cpu_time.count());
+  root.emplace("errors", n_errors);
+  root.emplace("flights", std::move(flights_array));
+
+  StdioOutputStream os(stdout);
+  Json::Serialize(os, root);
+
+  return n_errors > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
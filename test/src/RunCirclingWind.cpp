@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <memory>
+#include <chrono>
 
 int main(int argc, char **argv)
 {
@@ -31,6 +32,10 @@ int main(int argc, char **argv)
   CirclingWind circling_wind;
   circling_wind.Reset();
 
+  /* the time spent in CirclingWind::NewSample(), for benchmarking */
+  std::chrono::steady_clock::duration duration{};
+  unsigned n_samples = 0;
+
   while (replay->Next()) {
     circling_computer.TurnRate(replay->SetCalculated(),
                                replay->Basic(),
@@ -40,8 +45,12 @@ int main(int argc, char **argv)
                               replay->Calculated().flight,
                               circling_settings);
 
+    const auto start = std::chrono::steady_clock::now();
     CirclingWind::Result result = circling_wind.NewSample(replay->Basic(),
                                                           replay->Calculated());
+    duration += std::chrono::steady_clock::now() - start;
+    ++n_samples;
+
     if (result.quality > 0) {
       char time_buffer[32];
       FormatTime(time_buffer, replay->Basic().time);
@@ -52,5 +61,7 @@ int main(int argc, char **argv)
                (double)result.wind.norm);
     }
   }
-}
 
+  fprintf(stderr, "%u samples, %.3f ms in CirclingWind\n", n_samples,
+          std::chrono::duration<double, std::milli>(duration).count());
+}
@@ -8,6 +8,8 @@
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
 
+#include <chrono>
+
 #include <stdio.h>
 
 int main(int argc, char **argv)
@@ -37,6 +39,10 @@ int main(int argc, char **argv)
   Validity last;
   last.Clear();
 
+  /* the time spent in WindComputer::Compute(), for benchmarking */
+  std::chrono::steady_clock::duration duration{};
+  unsigned n_samples = 0;
+
   while (replay->Next()) {
     const MoreData &basic = replay->Basic();
     const DerivedInfo &calculated = replay->Calculated();
@@ -48,8 +54,11 @@ int main(int argc, char **argv)
                               calculated.flight,
                               circling_settings);
 
+    const auto start = std::chrono::steady_clock::now();
     wind_computer.Compute(wind_settings, glide_polar, basic,
                           replay->SetCalculated());
+    duration += std::chrono::steady_clock::now() - start;
+    ++n_samples;
 
     if (calculated.estimated_wind_available.Modified(last)) {
       char time_buffer[32];
@@ -64,4 +73,7 @@ int main(int argc, char **argv)
   }
 
   delete replay;
+
+  fprintf(stderr, "%u samples, %.3f ms in WindComputer\n", n_samples,
+          std::chrono::duration<double, std::milli>(duration).count());
 }
@@ -1,28 +1,36 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright The XCSoar Project
 
-#include "XML/Node.hpp"
-#include "XML/Parser.hpp"
-#include "io/StdioOutputStream.hxx"
-#include "io/BufferedOutputStream.hxx"
+#include "XML/Document.hpp"
 #include "system/Args.hpp"
 #include "util/PrintException.hxx"
 
 #include <stdio.h>
 #include <stdlib.h>
 
+static void
+Dump(const XML::Element &element, unsigned indent)
+{
+  printf("%*s<%s", indent, "", element.GetName());
+  for (const auto &i : element.GetAttributes())
+    printf(" %s=\"%s\"", i.name, i.value);
+  printf(">\n");
+
+  if (*element.GetText() != '\0')
+    printf("%*s%s\n", indent + 2, "", element.GetText());
+
+  for (const auto &i : element)
+    Dump(i, indent + 2);
+}
+
 int main(int argc, char **argv)
 try {
   Args args(argc, argv, "FILE");
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
-  const auto node = XML::ParseFile(path);
-
-  StdioOutputStream out(stdout);
-  BufferedOutputStream bos(out);
-  node.Serialise(bos, true);
-  bos.Flush();
+  const auto document = XML::Document::ParseFile(path);
+  Dump(document.GetRoot(), 0);
 
   return EXIT_SUCCESS;
 } catch (...) {
@@ -8,19 +8,18 @@
 #include "system/Path.hpp"
 #include "TestUtil.hpp"
 
-int main()
-{
-  plan_tests(16);
+#include <utility>
+#include <vector>
 
-  FlarmNetDatabase db;
-  int count = FlarmNetReader::LoadFile(Path("test/data/flarmnet/data.fln"),
-                                       db);
-  ok1(count == 6);
+#include <stdio.h>
 
+static void
+TestDatabase(const FlarmNetDatabase &db)
+{
   FlarmId id = FlarmId::Parse("DDA85C", NULL);
 
-  const FlarmNetRecord *record = db.FindRecordById(id);
-  ok1(record != NULL);
+  const auto record = db.FindRecordById(id);
+  ok1(record.has_value());
 
   ok1(record->id == id);
   ok1(StringIsEqual(record->pilot, "Tobias Bieniek"));
@@ -31,19 +30,9 @@ int main()
   ok1(record->frequency.IsDefined());
   ok1(record->frequency.GetKiloHertz() == 130625);
 
-  const FlarmNetRecord *array[3];
-  ok1(db.FindRecordsByCallSign("TH", array, 3) == 2);
-
-  bool found4449 = false, found5799 = false;
-  for (unsigned i = 0; i < 2; i++) {
-    record = array[i];
-    if (StringIsEqual(record->registration, "D-4449"))
-      found4449 = true;
-    if (StringIsEqual(record->registration, "D-5799"))
-      found5799 = true;
-  }
-  ok1(found4449);
-  ok1(found5799);
+  ok1(StringIsEqual(db.FindCallSignById(id), "TH"));
+  ok1(db.FindCallSignById(FlarmId::Parse("123456", NULL)) == nullptr);
+  ok1(!db.FindRecordById(FlarmId::Parse("123456", NULL)).has_value());
 
   FlarmId ids[3];
   ok1(db.FindIdsByCallSign("TH", ids, 3) == 2);
@@ -51,14 +40,110 @@ int main()
   id = FlarmId::Parse("DDA85C", NULL);
   FlarmId id2 = FlarmId::Parse("DDA896", NULL);
   bool foundDDA85C = false, foundDDA896 = false;
+  bool found4449 = false, found5799 = false;
   for (unsigned i = 0; i < 2; i++) {
     if (ids[i] == id)
       foundDDA85C = true;
     if (ids[i] == id2)
       foundDDA896 = true;
+
+    const auto r = db.FindRecordById(ids[i]);
+    if (r && StringIsEqual(r->registration, "D-4449"))
+      found4449 = true;
+    if (r && StringIsEqual(r->registration, "D-5799"))
+      found5799 = true;
   }
   ok1(foundDDA85C);
   ok1(foundDDA896);
+  ok1(found4449);
+  ok1(found5799);
+
+  /* the buffer size is honoured */
+  ok1(db.FindIdsByCallSign("TH", ids, 1) == 1);
+
+  const FlarmId first = db.FindFirstIdByCallSign("TH");
+  ok1(first == id || first == id2);
+  ok1(!db.FindFirstIdByCallSign("XX").IsDefined());
+}
+
+/**
+ * Swap two entries of the call sign index in the given compiled
+ * file and check whether Load() rejects the result.
+ */
+static bool
+IsRejected(Path path, std::size_t a, std::size_t b)
+{
+  std::vector<std::byte> image;
+  FILE *file = fopen(path.c_str(), "rb");
+  std::byte buffer[4096];
+  std::size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    image.insert(image.end(), buffer, buffer + nbytes);
+  fclose(file);
+
+  const auto &header =
+    *reinterpret_cast<const FlarmNetFileHeader *>(image.data());
+  const std::size_t index_offset = sizeof(header) +
+    header.n_records * sizeof(FlarmNetFileRecord);
+  auto *index = reinterpret_cast<PackedLE32 *>(image.data() + index_offset);
+  std::swap(index[a], index[b]);
+
+  const Path corrupt_path("output/test/flarmnet-corrupt.bin");
+  file = fopen(corrupt_path.c_str(), "wb");
+  fwrite(image.data(), 1, image.size(), file);
+  fclose(file);
+
+  FlarmNetDatabase db;
+  try {
+    db.Load(corrupt_path);
+    return false;
+  } catch (...) {
+    return true;
+  }
+}
+
+int main()
+{
+  plan_tests(1 + 20 + 3 + 20 + 3);
+
+  FlarmNetDatabase db;
+  int count = FlarmNetReader::LoadFile(Path("test/data/flarmnet/data.fln"),
+                                       db);
+  ok1(count == 6);
+
+  TestDatabase(db);
+
+  /* duplicate ids are ignored, the first record wins */
+  FlarmNetRecord duplicate{};
+  duplicate.id = FlarmId::Parse("DDA85C", NULL);
+  duplicate.callsign = "XY";
+  db.Insert(duplicate);
+  db.Compile();
+  ok1(db.size() == 6);
+  ok1(StringIsEqual(db.FindCallSignById(duplicate.id), "TH"));
+
+  /* save the compiled database and map it again */
+  const Path path("output/test/flarmnet.bin");
+  const FlarmNetFileSource source{12345, 1700000000000000};
+  db.Save(path, source);
+
+  FlarmNetDatabase loaded;
+  loaded.Load(path);
+  ok1(loaded.size() == 6);
+  ok1(loaded.GetSource() == source);
+  TestDatabase(loaded);
+
+  /* a truncated file is rejected */
+  bool rejected = false;
+  try {
+    loaded.Load(Path("test/data/flarmnet/data.fln"));
+  } catch (...) {
+    rejected = true;
+  }
+  ok1(rejected);
+
+  /* an unsorted call sign index is rejected */
+  ok1(IsRejected(path, 0, 5));
 
   return exit_status();
 }
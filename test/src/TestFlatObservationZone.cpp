@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Task/ObservationZones/FlatObservationZone.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/KeyholeZone.hpp"
+#include "Engine/Task/ObservationZones/AnnularSectorZone.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <random>
+
+static std::mt19937 rng(42);
+
+/**
+ * Compare FlatObservationZone::Classify() with the exact
+ * ObservationZone::IsInSector() for random locations around the
+ * zone.
+ *
+ * @return true if no decided classification contradicts the exact
+ * test and at least 90% of all locations were decided
+ */
+static bool
+TestZone(const ObservationZonePoint &oz, double radius)
+{
+  FlatObservationZone flat;
+  flat.Update(oz);
+
+  std::uniform_real_distribution<double> distance_dist(0, 2 * radius);
+  std::uniform_real_distribution<double> bearing_dist(0, 360);
+
+  constexpr unsigned n = 2000;
+  unsigned unknown = 0;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoVector v(distance_dist(rng),
+                      Angle::Degrees(bearing_dist(rng)));
+    const GeoPoint location = v.EndPoint(oz.GetReference());
+
+    const bool exact = oz.IsInSector(location);
+
+    switch (flat.Classify(location)) {
+    case FlatObservationZone::Result::OUTSIDE:
+      if (exact)
+        return false;
+      break;
+
+    case FlatObservationZone::Result::INSIDE:
+      if (!exact)
+        return false;
+      break;
+
+    case FlatObservationZone::Result::UNKNOWN:
+      ++unknown;
+      break;
+    }
+  }
+
+  return unknown * 10 < n;
+}
+
+static void
+TestAt(const GeoPoint &center)
+{
+  const GeoPoint previous =
+    GeoVector(50000, Angle::Degrees(200)).EndPoint(center);
+  const GeoPoint next =
+    GeoVector(80000, Angle::Degrees(70)).EndPoint(center);
+
+  ok1(TestZone(CylinderZone(center, 500), 500));
+  ok1(TestZone(CylinderZone(center, 20000), 20000));
+
+  ok1(TestZone(SectorZone(center, 10000, Angle::Degrees(30),
+                          Angle::Degrees(120)), 10000));
+  ok1(TestZone(SectorZone(center, 10000, Angle::Degrees(300),
+                          Angle::Degrees(10)), 10000));
+  /* reflex sector */
+  ok1(TestZone(SectorZone(center, 10000, Angle::Degrees(100),
+                          Angle::Degrees(20)), 10000));
+  /* full circle */
+  ok1(TestZone(SectorZone(center, 5000), 5000));
+
+  LineSectorZone line(center, 2000);
+  line.SetLegs(&previous, &next);
+  ok1(TestZone(line, 1000));
+
+  auto keyhole = KeyholeZone::CreateDAeCKeyholeZone(center);
+  keyhole->SetLegs(&previous, &next);
+  ok1(TestZone(*keyhole, 10000));
+
+  auto enhanced = KeyholeZone::CreateBGAEnhancedOptionZone(center);
+  enhanced->SetLegs(&previous, &next);
+  ok1(TestZone(*enhanced, 10000));
+
+  ok1(TestZone(AnnularSectorZone(center, 15000, Angle::Degrees(250),
+                                 Angle::Degrees(80), 3000), 15000));
+}
+
+int main()
+{
+  static constexpr GeoPoint centers[] = {
+    {Angle::Degrees(7.7), Angle::Degrees(51.05)},
+    {Angle::Degrees(-120.3), Angle::Degrees(36.2)},
+    {Angle::Degrees(147.1), Angle::Degrees(-33.8)},
+    {Angle::Degrees(179.95), Angle::Degrees(-45.0)},
+    {Angle::Degrees(-179.95), Angle::Degrees(12.0)},
+    {Angle::Degrees(25.0), Angle::Degrees(0.0)},
+    {Angle::Degrees(18.9), Angle::Degrees(69.6)},
+    {Angle::Degrees(-68.3), Angle::Degrees(-75.0)},
+  };
+
+  plan_tests(std::size(centers) * 10);
+
+  for (const auto &center : centers)
+    TestAt(center);
+
+  return exit_status();
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlightHistory.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <vector>
+
+using Duration = FlightHistory::Duration;
+
+static FlightHistory::Sample
+MakeSample(unsigned time) noexcept
+{
+  FlightHistory::Sample sample;
+  sample.time = Duration(time);
+  sample.altitude = 1000 + 800 * std::sin(time / 600.) + (time % 7) * 0.3;
+  sample.vario = 3 * std::cos(time / 40.);
+  sample.speed = 25 + 10 * std::sin(time / 90.);
+  sample.location = time % 1000 < 20
+    ? GeoPoint::Invalid()
+    : GeoPoint(Angle::Degrees(179.99 + time * 1e-5),
+               Angle::Degrees(-45 + time * 1e-5)).Normalize();
+  return sample;
+}
+
+/**
+ * Generate samples with a gap between 3000 and 4000 seconds.
+ */
+static std::vector<FlightHistory::Sample>
+MakeFlight(unsigned n)
+{
+  std::vector<FlightHistory::Sample> samples;
+  for (unsigned time = 100; samples.size() < n; ++time)
+    if (time < 3000 || time >= 4000)
+      samples.push_back(MakeSample(time));
+  return samples;
+}
+
+static FlightHistory::Envelope
+BruteForceEnvelope(const std::vector<FlightHistory::Sample> &samples,
+                   Duration begin, Duration end) noexcept
+{
+  auto result = FlightHistory::Envelope::Empty();
+  for (const auto &sample : samples) {
+    if (sample.time < begin || sample.time > end)
+      continue;
+
+    /* apply the same rounding as FlightHistory */
+    result.altitude.Include(std::lround(sample.altitude * 10) / 10.);
+    result.vario.Include(std::lround(sample.vario * 100) / 100.);
+    result.speed.Include(std::lround(sample.speed * 100) / 100.);
+  }
+
+  return result;
+}
+
+static bool
+Equals(const FlightHistory::Range &a, const FlightHistory::Range &b) noexcept
+{
+  return a.min == b.min && a.max == b.max;
+}
+
+static bool
+Equals(const FlightHistory::Envelope &a,
+       const FlightHistory::Envelope &b) noexcept
+{
+  return Equals(a.altitude, b.altitude) && Equals(a.vario, b.vario) &&
+    Equals(a.speed, b.speed);
+}
+
+static void
+TestRoundTrip(const FlightHistory &history,
+              const std::vector<FlightHistory::Sample> &samples)
+{
+  std::size_t i = 0;
+  bool accurate = true, invalid_preserved = true;
+  history.ForEach(Duration(0), Duration(1000000),
+                  [&](const FlightHistory::Sample &sample){
+    if (i >= samples.size()) {
+      accurate = false;
+      return;
+    }
+
+    const auto &expected = samples[i++];
+    if (sample.time != expected.time ||
+        std::abs(sample.altitude - expected.altitude) > 0.051 ||
+        std::abs(sample.vario - expected.vario) > 0.0051 ||
+        std::abs(sample.speed - expected.speed) > 0.0051)
+      accurate = false;
+
+    if (sample.location.IsValid() != expected.location.IsValid())
+      invalid_preserved = false;
+    else if (expected.location.IsValid() &&
+             sample.location.Distance(expected.location) > 0.2)
+      accurate = false;
+  });
+
+  ok1(i == samples.size());
+  ok1(accurate);
+  ok1(invalid_preserved);
+}
+
+static void
+TestEnvelopes(const FlightHistory &history,
+              const std::vector<FlightHistory::Sample> &samples)
+{
+  const unsigned first = samples.front().time.count();
+  const unsigned last = samples.back().time.count();
+
+  /* the whole flight */
+  ok1(Equals(history.GetEnvelope(Duration(0), Duration(last + 100)),
+             BruteForceEnvelope(samples, Duration(0), Duration(last + 100))));
+
+  /* single samples */
+  ok1(Equals(history.GetEnvelope(Duration(first), Duration(first)),
+             BruteForceEnvelope(samples, Duration(first), Duration(first))));
+  ok1(Equals(history.GetEnvelope(Duration(last), Duration(last)),
+             BruteForceEnvelope(samples, Duration(last), Duration(last))));
+
+  /* inside the gap */
+  ok1(!history.GetEnvelope(Duration(3100), Duration(3900)).IsDefined());
+
+  /* pseudo-random ranges */
+  bool all_equal = true;
+  unsigned seed = 12345;
+  for (unsigned n = 0; n < 500; ++n) {
+    seed = seed * 1103515245 + 12345;
+    const unsigned a = first + (seed >> 8) % (last - first + 1);
+    seed = seed * 1103515245 + 12345;
+    const unsigned b = first + (seed >> 8) % (last - first + 1);
+    const Duration begin(std::min(a, b)), end(std::max(a, b));
+
+    if (!Equals(history.GetEnvelope(begin, end),
+                BruteForceEnvelope(samples, begin, end)))
+      all_equal = false;
+  }
+
+  ok1(all_equal);
+}
+
+static void
+TestFlight(unsigned n)
+{
+  const auto samples = MakeFlight(n);
+
+  FlightHistory history;
+  for (const auto &sample : samples)
+    history.Append(sample);
+
+  /* duplicate and older samples are ignored */
+  history.Append(samples.back());
+  history.Append(samples.front());
+
+  ok1(history.size() == n);
+  ok1(history.GetFirstTime() == samples.front().time);
+  ok1(history.GetLastTime() == samples.back().time);
+
+  TestRoundTrip(history, samples);
+  TestEnvelopes(history, samples);
+}
+
+static void
+TestCompression()
+{
+  const auto samples = MakeFlight(8 * 3600);
+
+  FlightHistory history;
+  for (const auto &sample : samples)
+    history.Append(sample);
+
+  /* less than half of the 24 bytes per uncompressed sample,
+     including vector slack */
+  ok1(history.GetMemoryUsage() < samples.size() * 12);
+
+  history.Clear();
+  ok1(history.empty());
+  ok1(history.size() == 0);
+}
+
+int main()
+{
+  plan_tests(4 * 11 + 3);
+
+  /* less than one block, exactly one block, odd and even numbers of
+     blocks with a partial block */
+  TestFlight(100);
+  TestFlight(FlightHistory::BLOCK_SIZE);
+  TestFlight(FlightHistory::BLOCK_SIZE * 13 + 17);
+  TestFlight(FlightHistory::BLOCK_SIZE * 32);
+
+  TestCompression();
+
+  return exit_status();
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IGC/IGCFixTable.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+static bool
+operator==(const IGCFix &a, const IGCFix &b) noexcept
+{
+  return a.time == b.time && a.location == b.location &&
+    a.gps_valid == b.gps_valid &&
+    a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm &&
+    a.hdm == b.hdm && a.hdt == b.hdt &&
+    a.trm == b.trm && a.trt == b.trt &&
+    a.gsp == b.gsp && a.ias == b.ias && a.tas == b.tas &&
+    a.siu == b.siu;
+}
+
+static void
+TestParse()
+{
+  IGCFixTable table;
+  table.Parse("ALXNJD0FLIGHT:1\r\n"
+              "HFDTE281010\r\n"
+              "I033638FXA3941ENL4244TAS\r\n"
+              "B0948513556963S14634123EA0030600306000002123\r\n"
+              "LXXX comment\r\n"
+              "B0948553556963S14634123EX0030600306000002123\r\n"
+              "B0948573556963S14634123EV-001000306000\r\n"
+              "HFDTE291010\r\n"
+              "B2359593556963S14634123EA0030600306000002123");
+
+  ok1(table.GetDate() == BrokenDate(2010, 10, 28));
+
+  /* each date record is kept with the index of the following fix */
+  const auto dates = table.GetDateRecords();
+  ok1(dates.size() == 2 &&
+      dates[0].fix_index == 0 && dates[0].date == BrokenDate(2010, 10, 28) &&
+      dates[1].fix_index == 2 && dates[1].date == BrokenDate(2010, 10, 29));
+
+  /* the second "B" record has an invalid validity character */
+  ok1(table.size() == 3);
+
+  const auto times = table.GetTimes();
+  ok1(times[0] == 9 * 3600 + 48 * 60 + 51);
+  ok1(times[2] == 23 * 3600 + 59 * 60 + 59);
+
+  ok1(table.IsGPSValid(0));
+  ok1(!table.IsGPSValid(1));
+  ok1(table.GetPressureAltitudes()[1] == -10);
+
+  const auto enl = table.GetExtension(IGCFixTable::Extension::ENL);
+  const auto tas = table.GetExtension(IGCFixTable::Extension::TAS);
+  const auto siu = table.GetExtension(IGCFixTable::Extension::SIU);
+  ok1(enl[0] == 2 && tas[0] == 123);
+
+  /* the third record is too short for the extensions */
+  ok1(enl[1] == -1 && tas[1] == -1);
+  ok1(siu[0] == -1);
+
+  const IGCFix fix = table.GetFix(0);
+  ok1(fix.time == BrokenTime(9, 48, 51));
+  ok1(fix.gps_altitude == 306);
+  ok1(fix.tas == 123 && fix.enl == 2 && fix.rpm == -1);
+}
+
+/**
+ * Compare IGCFixTable::Load() with parsing the file line by line.
+ */
+static bool
+CompareWithLineParser(Path path)
+{
+  IGCFixTable table;
+  table.Load(path);
+
+  FileLineReaderA reader(path);
+  IGCExtensions extensions;
+  extensions.clear();
+
+  std::size_t i = 0;
+  const char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] == 'I') {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix))
+      continue;
+
+    if (i >= table.size() || !(table.GetFix(i) == fix))
+      return false;
+
+    ++i;
+  }
+
+  return i == table.size() && i > 0;
+}
+
+int main()
+{
+  plan_tests(14 + 4);
+
+  TestParse();
+
+  ok1(CompareWithLineParser(Path("test/data/01lz1hq1.igc")));
+  ok1(CompareWithLineParser(Path("test/data/0asljd01.igc")));
+  ok1(CompareWithLineParser(Path("test/data/9crx3101.igc")));
+  ok1(CompareWithLineParser(Path("test/data/apf-bug554.igc")));
+
+  return exit_status();
+}
@@ -169,6 +169,10 @@ TestFix()
   ok1(equals(fix.location, -51.05195, -7.70611667));
   ok1(fix.pressure_altitude == 10490);
   ok1(fix.gps_altitude == 7);
+
+  /* negative pressure altitude */
+  ok1(IGCParseFix("B1122535103117N00742367EA-001200487", extensions, fix));
+  ok1(fix.pressure_altitude == -12);
 }
 
 static void
@@ -251,7 +255,7 @@ TestDeclarationTurnpoint()
 
 int main()
 {
-  plan_tests(148);
+  plan_tests(150);
 
   TestHeader();
   TestDate();
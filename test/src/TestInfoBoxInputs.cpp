@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "InfoBoxes/Inputs.hpp"
+#include "NMEA/Info.hpp"
+#include "TestUtil.hpp"
+
+using namespace InfoBoxInputs;
+
+static const AtmosphericPressure qnh = AtmosphericPressure::HectoPascal(1013);
+
+static Mask
+Compare(const NMEAInfo &a, const NMEAInfo &b,
+        AtmosphericPressure qnh_b = qnh) noexcept
+{
+  return InfoBoxInputSnapshot::Make(b, qnh_b)
+    .Compare(InfoBoxInputSnapshot::Make(a, qnh));
+}
+
+int main()
+{
+  plan_tests(10);
+
+  NMEAInfo basic;
+  basic.Reset();
+  basic.clock = TimeStamp{FloatDuration{10}};
+  basic.alive.Update(basic.clock);
+  basic.gps_altitude = 500;
+  basic.gps_altitude_available.Update(basic.clock);
+  basic.ProvideBothAirspeeds(30, 32);
+
+  NMEAInfo next = basic;
+  ok1(Compare(basic, next) == 0);
+
+  /* the device sends the same values again: nothing has changed */
+  next.clock = TimeStamp{FloatDuration{11}};
+  next.gps_altitude_available.Update(next.clock);
+  next.ProvideBothAirspeeds(30, 32);
+  ok1(Compare(basic, next) == 0);
+
+  next.gps_altitude = 501;
+  ok1(Compare(basic, next) == GPS_ALTITUDE);
+
+  next = basic;
+  next.ProvideBothAirspeeds(30, 33);
+  ok1(Compare(basic, next) == AIRSPEED);
+
+  /* losing a value is a change, too */
+  next = basic;
+  next.airspeed_available.Clear();
+  ok1(Compare(basic, next) == AIRSPEED);
+
+  /* the GPS altitude determines "2D/3D fix" */
+  next = basic;
+  next.gps_altitude_available.Clear();
+  ok1(Compare(basic, next) == (GPS_ALTITUDE | GPS_STATUS));
+
+  next = basic;
+  next.ProvidePressureAltitude(1000);
+  ok1(Compare(basic, next) == BARO);
+
+  /* the QNH setting is a baro input */
+  ok1(Compare(basic, basic, AtmosphericPressure::HectoPascal(1020)) == BARO);
+
+  next = basic;
+  next.heart_rate = 90;
+  next.heart_rate_available.Update(next.clock);
+  next.acceleration.ProvideGLoad(1.5);
+  ok1(Compare(basic, next) == (HEART_RATE | ACCELERATION));
+
+  ok1((Compare(basic, next) & OTHER) == 0);
+
+  return exit_status();
+}
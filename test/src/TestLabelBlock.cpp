@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Renderer/LabelBlock.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+/**
+ * The reference implementation: compare with all claimed
+ * rectangles.
+ */
+class BruteForceLabelBlock {
+  std::vector<PixelRect> rects;
+
+public:
+  bool check(const PixelRect rc) noexcept {
+    for (const auto &i : rects)
+      if (i.OverlapsWith(rc))
+        return false;
+
+    rects.push_back(rc);
+    return true;
+  }
+};
+
+static void
+TestBasic()
+{
+  LabelBlock lb;
+  lb.reset({640, 480});
+
+  ok1(lb.check({10, 10, 100, 30}));
+  ok1(!lb.check({50, 20, 150, 40}));
+  ok1(lb.check({200, 10, 300, 30}));
+
+  /* touching edges count as overlap, like PixelRect::OverlapsWith() */
+  ok1(!lb.check({100, 10, 150, 30}));
+
+  /* partially or completely outside of the screen */
+  ok1(lb.check({-50, -20, 20, 5}));
+  ok1(!lb.check({-60, -30, -40, -10}));
+  ok1(lb.check({600, 470, 700, 500}));
+  ok1(!lb.check({650, 490, 660, 495}));
+
+  lb.reset({640, 480});
+  ok1(lb.check({50, 20, 150, 40}));
+}
+
+static void
+TestRandom(PixelSize screen_size)
+{
+  LabelBlock lb;
+  lb.reset(screen_size);
+
+  BruteForceLabelBlock reference;
+
+  unsigned seed = 42, n_accepted = 0;
+  bool all_equal = true;
+  for (unsigned n = 0; n < 2000; ++n) {
+    seed = seed * 1103515245 + 12345;
+    const int x = int((seed >> 8) % (screen_size.width + 100)) - 50;
+    seed = seed * 1103515245 + 12345;
+    const int y = int((seed >> 8) % (screen_size.height + 100)) - 50;
+    seed = seed * 1103515245 + 12345;
+    const int width = 10 + (seed >> 8) % 150;
+    const int height = 8 + (seed >> 20) % 20;
+
+    const PixelRect rc{x, y, x + width, y + height};
+    const bool result = lb.check(rc);
+    if (result != reference.check(rc))
+      all_equal = false;
+    if (result)
+      ++n_accepted;
+  }
+
+  ok1(all_equal);
+  ok1(n_accepted > 20);
+}
+
+int main()
+{
+  plan_tests(9 + 3 * 2);
+
+  TestBasic();
+  TestRandom({640, 480});
+  TestRandom({1920, 1080});
+  TestRandom({100, 4000});
+
+  return exit_status();
+}
@@ -61,6 +61,26 @@ TestMap()
     ok1(Profile::Get("key5", value));
     ok1(equals(value, 1.337));
   }
+
+  {
+    /* the parsed numeric value must follow modifications */
+    int value;
+    Profile::Set("key6", "abc");
+    ok1(!Profile::Get("key6", value));
+    Profile::Set("key6", 7);
+    ok1(Profile::Get("key6", value));
+    ok1(value == 7);
+    Profile::Set("key6", "0x10");
+    ok1(Profile::Get("key6", value));
+    ok1(value == 16);
+
+    /* reading the same value as a different type */
+    double d;
+    Profile::Set("key6", "2.5");
+    ok1(Profile::Get("key6", value) && value == 2);
+    ok1(Profile::Get("key6", d) && equals(d, 2.5));
+    ok1(Profile::Get("key6", value) && value == 2);
+  }
 }
 
 static void
@@ -164,7 +184,7 @@ TestMigration()
 
 int main()
 try {
-  plan_tests(44);
+  plan_tests(52);
 
   TestMap();
   TestWriter();
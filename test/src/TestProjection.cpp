@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright The XCSoar Project
 
-#include "Projection/Projection.hpp"
+#include "Projection/WindowProjection.hpp"
 #include "TestUtil.hpp"
 
+#include <vector>
+
 static void
 TestGeoScreenCouple(const Projection prj, const GeoPoint geo,
                     int x, int y)
@@ -27,11 +29,59 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+/**
+ * Compare the batch conversion with the scalar one.
+ */
+static void
+TestBatch(const GeoPoint center, Angle screen_angle, double radius)
+{
+  WindowProjection prj;
+  prj.SetScreenSize({640, 480});
+  prj.SetScreenOrigin(320, 240);
+  prj.SetGeoLocation(center);
+  prj.SetScreenAngle(screen_angle);
+  prj.SetScaleFromRadius(radius);
+
+  std::vector<Angle> latitudes, longitudes;
+  unsigned seed = 1;
+  for (unsigned i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const double dx = ((seed >> 8) % 2001 - 1000) / 1000.;
+    seed = seed * 1103515245 + 12345;
+    const double dy = ((seed >> 8) % 2001 - 1000) / 1000.;
+
+    GeoPoint p(center.longitude + Angle::Degrees(dx * radius / 50000),
+               center.latitude + Angle::Degrees(dy * radius / 100000));
+    p.Normalize();
+    latitudes.push_back(p.latitude);
+    longitudes.push_back(p.longitude);
+  }
+
+  std::vector<PixelPoint> batch(latitudes.size());
+  prj.GeoToScreen(latitudes, longitudes, batch);
+
+  bool equal = true;
+  for (std::size_t i = 0; i < latitudes.size(); ++i)
+    if (prj.GeoToScreen(GeoPoint(longitudes[i], latitudes[i])) != batch[i])
+      equal = false;
+
+  ok1(equal);
+}
+
 int main()
 {
-  plan_tests(4);
+  plan_tests(4 + 4);
 
   test_simple();
 
+  TestBatch(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)),
+            Angle::Zero(), 20000);
+  TestBatch(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)),
+            Angle::Degrees(123), 200000);
+  TestBatch(GeoPoint(Angle::Degrees(179.99), Angle::Degrees(-45)),
+            Angle::Degrees(-30), 50000);
+  TestBatch(GeoPoint(Angle::Degrees(-179.99), Angle::Degrees(69.6)),
+            Angle::Degrees(270), 5000);
+
   return exit_status();
 }
@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "CoInstance.hpp"
+#include "TestUtil.hpp"
+#include "net/http/CoDownloadToFile.hpp"
+#include "net/http/Init.hpp"
+#include "net/IPv4Address.hxx"
+#include "net/StaticSocketAddress.hxx"
+#include "net/UniqueSocketDescriptor.hxx"
+#include "lib/sodium/SHA256.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "Operation/Operation.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+
+struct Instance : CoInstance {
+  const Net::ScopeInit net_init{GetEventLoop()};
+};
+
+static constexpr std::size_t BODY_SIZE = 10000;
+
+static std::array<std::byte, BODY_SIZE> body;
+
+enum class ServerMode {
+  /**
+   * Answer range requests with "206 Partial Content".
+   */
+  RANGE,
+
+  /**
+   * Ignore the "Range" header and send the whole body.
+   */
+  IGNORE_RANGE,
+
+  /**
+   * Answer range requests with "416 Range Not Satisfiable".
+   */
+  REJECT_RANGE,
+
+  /**
+   * Answer all requests with "503 Service Unavailable".
+   */
+  FAIL,
+};
+
+/**
+ * A minimal HTTP server on the loopback interface which answers
+ * exactly one request in a separate thread.
+ */
+class TestServer {
+  const ServerMode mode;
+
+  UniqueSocketDescriptor listener;
+
+  std::thread thread;
+
+  /**
+   * The request header received from the client.  Only valid after
+   * Join().
+   */
+  std::string request;
+
+public:
+  explicit TestServer(ServerMode _mode):mode(_mode) {
+    if (!listener.Create(AF_INET, SOCK_STREAM, 0) ||
+        !listener.Bind(IPv4Address{IPv4Address::Loopback(), 0}) ||
+        !listener.Listen(1))
+      abort();
+
+    thread = std::thread{[this]{ Serve(); }};
+  }
+
+  ~TestServer() noexcept {
+    Join();
+  }
+
+  std::string GetURL() const {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "http://127.0.0.1:%u/file",
+             listener.GetLocalAddress().GetPort());
+    return buffer;
+  }
+
+  const std::string &Join() noexcept {
+    if (thread.joinable())
+      thread.join();
+    return request;
+  }
+
+private:
+  /**
+   * Parse the start offset of the "Range" request header.
+   */
+  std::size_t GetRangeOffset() const noexcept {
+    const auto i = request.find("Range: bytes=");
+    return i != std::string::npos
+      ? strtoul(request.c_str() + i + 13, nullptr, 10)
+      : 0;
+  }
+
+  void Send(SocketDescriptor s, std::span<const std::byte> src) noexcept {
+    while (!src.empty()) {
+      const auto nbytes = s.Send(src);
+      if (nbytes <= 0)
+        return;
+      src = src.subspan(nbytes);
+    }
+  }
+
+  void Send(SocketDescriptor s, const char *header,
+            std::span<const std::byte> src) noexcept {
+    Send(s, std::as_bytes(std::span{header, strlen(header)}));
+    Send(s, src);
+  }
+
+  void Serve() noexcept {
+    UniqueSocketDescriptor s{listener.Accept()};
+    if (!s.IsDefined())
+      return;
+
+    while (request.find("\r\n\r\n") == std::string::npos) {
+      char buffer[1024];
+      const auto nbytes = s.Receive(std::as_writable_bytes(std::span{buffer}));
+      if (nbytes <= 0)
+        return;
+      request.append(buffer, nbytes);
+    }
+
+    const std::size_t offset = GetRangeOffset();
+    char header[256];
+
+    if (mode == ServerMode::FAIL) {
+      static constexpr char message[] = "Try again later";
+      snprintf(header, sizeof(header),
+               "HTTP/1.1 503 Service Unavailable\r\n"
+               "Content-Length: %zu\r\n"
+               "Connection: close\r\n\r\n",
+               sizeof(message) - 1);
+      Send(s, header,
+           std::as_bytes(std::span{message, sizeof(message) - 1}));
+    } else if (offset == 0 || mode == ServerMode::IGNORE_RANGE) {
+      snprintf(header, sizeof(header),
+               "HTTP/1.1 200 OK\r\n"
+               "Content-Length: %zu\r\n"
+               "Connection: close\r\n\r\n",
+               BODY_SIZE);
+      Send(s, header, body);
+    } else if (mode == ServerMode::REJECT_RANGE) {
+      snprintf(header, sizeof(header),
+               "HTTP/1.1 416 Range Not Satisfiable\r\n"
+               "Content-Range: bytes */%zu\r\n"
+               "Content-Length: 0\r\n"
+               "Connection: close\r\n\r\n",
+               BODY_SIZE);
+      Send(s, header, {});
+    } else {
+      snprintf(header, sizeof(header),
+               "HTTP/1.1 206 Partial Content\r\n"
+               "Content-Range: bytes %zu-%zu/%zu\r\n"
+               "Content-Length: %zu\r\n"
+               "Connection: close\r\n\r\n",
+               offset, BODY_SIZE - 1, BODY_SIZE, BODY_SIZE - offset);
+      Send(s, header, std::span{body}.subspan(offset));
+    }
+  }
+};
+
+static const Path path("output/test/download.dat");
+
+static AllocatedPath
+GetPartialPath() noexcept
+{
+  return Net::GetPartialDownloadPath(path);
+}
+
+/**
+ * Create a partial download file with the first @a size bytes of
+ * the body.
+ */
+static void
+WritePartial(std::size_t size)
+{
+  FileOutputStream file(GetPartialPath());
+  file.Write(std::span{body}.first(size));
+  file.Commit();
+}
+
+static bool
+EqualsBody(Path p)
+{
+  if (!File::Exists(p))
+    return false;
+
+  std::vector<std::byte> data;
+  FileReader reader{p};
+
+  std::byte buffer[4096];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer)) > 0)
+    data.insert(data.end(), buffer, buffer + nbytes);
+
+  return std::equal(data.begin(), data.end(), body.begin(), body.end());
+}
+
+static Co::Task<bool>
+Download(CurlGlobal &curl, std::string url,
+         const std::array<std::byte, 32> *sha256)
+{
+  NullOperationEnvironment progress;
+
+  try {
+    const auto response = co_await
+      Net::CoResumableDownloadToFile(curl, url.c_str(), path,
+                                     sha256, progress);
+    co_return true;
+  } catch (...) {
+    co_return false;
+  }
+}
+
+static void
+Reset() noexcept
+{
+  File::Delete(path);
+  File::Delete(GetPartialPath());
+}
+
+static Co::Task<void>
+TestResume(CurlGlobal &curl, const std::array<std::byte, 32> &sha256)
+{
+  Reset();
+  WritePartial(4000);
+
+  TestServer server{ServerMode::RANGE};
+  ok1(co_await Download(curl, server.GetURL(), &sha256));
+  ok1(server.Join().find("Range: bytes=4000-") != std::string::npos);
+  ok1(EqualsBody(path));
+  ok1(!File::Exists(GetPartialPath()));
+}
+
+static Co::Task<void>
+TestIgnoredRange(CurlGlobal &curl)
+{
+  Reset();
+  WritePartial(4000);
+
+  {
+    /* libcurl fails with CURLE_RANGE_ERROR; the partial file must
+       be deleted, or all retries would fail the same way */
+    TestServer server{ServerMode::IGNORE_RANGE};
+    ok1(!co_await Download(curl, server.GetURL(), nullptr));
+    ok1(!File::Exists(GetPartialPath()));
+  }
+
+  /* the next attempt starts from the beginning */
+  TestServer server{ServerMode::IGNORE_RANGE};
+  ok1(co_await Download(curl, server.GetURL(), nullptr) &&
+      EqualsBody(path));
+}
+
+static Co::Task<void>
+TestRangeNotSatisfiable(CurlGlobal &curl,
+                        const std::array<std::byte, 32> &sha256)
+{
+  Reset();
+  WritePartial(4000);
+
+  {
+    /* without a checksum, the partial file can't be trusted */
+    TestServer server{ServerMode::REJECT_RANGE};
+    ok1(!co_await Download(curl, server.GetURL(), nullptr));
+    ok1(!File::Exists(GetPartialPath()));
+    ok1(!File::Exists(path));
+  }
+
+  /* a complete partial file which matches the checksum is
+     accepted */
+  WritePartial(BODY_SIZE);
+
+  TestServer server{ServerMode::REJECT_RANGE};
+  ok1(co_await Download(curl, server.GetURL(), &sha256));
+  ok1(EqualsBody(path));
+}
+
+static Co::Task<void>
+TestServerError(CurlGlobal &curl)
+{
+  Reset();
+  WritePartial(4000);
+
+  /* the partial file is kept for the next attempt, and the error
+     response body is not appended to it */
+  TestServer server{ServerMode::FAIL};
+  ok1(!co_await Download(curl, server.GetURL(), nullptr));
+  ok1(File::Exists(GetPartialPath()));
+  ok1(File::GetSize(GetPartialPath()) == 4000);
+}
+
+static Co::Task<void>
+TestChecksumMismatch(CurlGlobal &curl,
+                     const std::array<std::byte, 32> &sha256)
+{
+  Reset();
+
+  auto wrong = sha256;
+  wrong[0] ^= std::byte{0x01};
+
+  TestServer server{ServerMode::RANGE};
+  ok1(!co_await Download(curl, server.GetURL(), &wrong));
+  ok1(!File::Exists(GetPartialPath()));
+  ok1(!File::Exists(path));
+}
+
+/**
+ * Run all tests in one coroutine, because the #EventLoop can be run
+ * only once.
+ */
+static Co::InvokeTask
+RunTests(CurlGlobal &curl, std::array<std::byte, 32> sha256)
+{
+  co_await TestResume(curl, sha256);
+  co_await TestIgnoredRange(curl);
+  co_await TestRangeNotSatisfiable(curl, sha256);
+  co_await TestServerError(curl);
+  co_await TestChecksumMismatch(curl, sha256);
+}
+
+int
+main()
+{
+  plan_tests(4 + 3 + 5 + 3 + 3);
+
+  for (std::size_t i = 0; i < BODY_SIZE; ++i)
+    body[i] = static_cast<std::byte>(i * 7 + i / 256);
+
+  Instance instance;
+  instance.Run(RunTests(*Net::curl, SHA256(body)));
+
+  Reset();
+
+  return exit_status();
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Tracking/SkyLines/Rate.hpp"
+#include "Tracking/SkyLines/Queue.hpp"
+#include "util/ByteOrder.hxx"
+#include "TestUtil.hpp"
+
+#include <chrono>
+
+using namespace std::chrono;
+using SkyLinesTracking::AdaptiveRate;
+
+static constexpr FloatDuration interval = seconds{5};
+
+/**
+ * Simulate one hour of flight (sampled once per second): 30 minutes
+ * on a straight leg, then 30 minutes of circling.
+ *
+ * @return the number of fixes sent
+ */
+static unsigned
+SimulateHour(bool adaptive)
+{
+  AdaptiveRate rate;
+  unsigned n = 0;
+
+  for (unsigned t = 0; t < 3600; ++t) {
+    const bool circling = t >= 1800;
+    const Angle track = circling
+      ? Angle::Degrees(t * 10.)
+      : Angle::Degrees(90);
+
+    const TimeStamp time{FloatDuration{t}};
+    if (adaptive
+        ? rate.Check(time, interval, circling, true, track)
+        : rate.Check(time, interval, true, false, Angle::Zero()))
+      ++n;
+  }
+
+  return n;
+}
+
+static void
+TestRate()
+{
+  const unsigned fixed = SimulateHour(false);
+  const unsigned adaptive = SimulateHour(true);
+
+  ok1(fixed == 720);
+
+  /* 1800/15 fixes on the straight leg, 1800/5 while circling */
+  ok1(adaptive == 480);
+
+  const unsigned bytes_per_hour =
+    adaptive * sizeof(SkyLinesTracking::FixPacket);
+  printf("# bytes per hour: %u (fixed interval: %u)\n",
+         bytes_per_hour,
+         unsigned(fixed * sizeof(SkyLinesTracking::FixPacket)));
+  ok1(bytes_per_hour < fixed * sizeof(SkyLinesTracking::FixPacket));
+
+  /* a turn ends the straight leg immediately */
+  AdaptiveRate rate;
+  ok1(rate.Check(TimeStamp{FloatDuration{0}}, interval, false,
+                 true, Angle::Degrees(90)));
+  ok1(!rate.Check(TimeStamp{FloatDuration{5}}, interval, false,
+                  true, Angle::Degrees(95)));
+  ok1(rate.Check(TimeStamp{FloatDuration{6}}, interval, false,
+                 true, Angle::Degrees(150)));
+
+  /* the latency of a fix on a straight leg is bounded */
+  ok1(!rate.Check(TimeStamp{FloatDuration{20}}, interval, false,
+                  true, Angle::Degrees(150)));
+  ok1(rate.Check(TimeStamp{FloatDuration{21}}, interval, false,
+                 true, Angle::Degrees(150)));
+
+  /* time warp */
+  ok1(!rate.Check(TimeStamp{FloatDuration{10}}, interval, false,
+                  true, Angle::Degrees(150)));
+}
+
+static SkyLinesTracking::FixPacket
+MakeFix(uint32_t time_ms)
+{
+  SkyLinesTracking::FixPacket packet{};
+  packet.time = ToBE32(time_ms);
+  return packet;
+}
+
+static void
+TestQueue()
+{
+  SkyLinesTracking::Queue queue;
+  ok1(queue.IsEmpty());
+
+  queue.Push(MakeFix(1000));
+
+  /* too soon after the previous fix */
+  queue.Push(MakeFix(11000));
+
+  /* more than 25 seconds later; the big-endian encoding would make
+     a naive comparison fail here */
+  queue.Push(MakeFix(27000));
+
+  ok1(FromBE32(queue.Pop().time) == 1000);
+  ok1(FromBE32(queue.Pop().time) == 27000);
+  ok1(queue.IsEmpty());
+}
+
+int main()
+{
+  plan_tests(9 + 4);
+
+  TestRate();
+  TestQueue();
+
+  return exit_status();
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/SnapshotBuffer.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+struct Value {
+  unsigned a, b;
+};
+
+/**
+ * One thread publishes consistent values while another reads them;
+ * a reader must never see a partially written value.
+ */
+static bool
+TestConcurrent()
+{
+  SnapshotBuffer<Value> buffer;
+  buffer.Publish({0, ~0u});
+
+  std::thread producer([&buffer]{
+    for (unsigned i = 1; i <= 100000; ++i)
+      buffer.Publish({i, ~i});
+  });
+
+  bool consistent = true;
+  unsigned last = 0;
+  while (last < 100000) {
+    const auto value = buffer.Get();
+    if (value->b != ~value->a || value->a < last)
+      consistent = false;
+    last = value->a;
+  }
+
+  producer.join();
+  return consistent;
+}
+
+int main()
+{
+  plan_tests(13);
+
+  SnapshotBuffer<Value> buffer;
+  ok1(buffer.Get() == nullptr);
+
+  Serial serial;
+  ok1(buffer.GetModified(serial) == nullptr);
+
+  buffer.Publish({1, 2});
+  const auto first = buffer.Get();
+  ok1(first != nullptr && first->a == 1 && first->b == 2);
+
+  /* the version can be retrieved only once */
+  ok1(buffer.GetModified(serial) == first);
+  ok1(buffer.GetModified(serial) == nullptr);
+
+  /* a version held by a consumer is never modified */
+  buffer.Publish({3, 4});
+  ok1(first->a == 1 && first->b == 2);
+  const auto second = buffer.GetModified(serial);
+  ok1(second != nullptr && second != first && second->a == 3);
+
+  /* a version still referenced is not recycled, unreferenced
+     versions are */
+  buffer.Publish({5, 6});
+  buffer.Publish({7, 8});
+  ok1(second->a == 3 && buffer.Get()->a == 7);
+
+  const Value *const address = buffer.Get().get();
+  buffer.Publish({9, 10});
+  buffer.Publish({11, 12});
+  ok1(buffer.Get()->a == 11 && buffer.Get().get() == address);
+  ok1(first->a == 1 && second->a == 3);
+
+  /* the producer may publish a version it keeps reading, like the
+     MergeThread does */
+  std::shared_ptr<const Value> own;
+  for (unsigned i = 0; i < 4; ++i) {
+    auto next = buffer.Allocate();
+    next->a = 13 + i;
+    next->b = 0;
+    own = next;
+    buffer.PublishAllocated(std::move(next));
+  }
+  ok1(own == buffer.Get() && own->a == 16);
+  ok1(buffer.Allocate().get() != own.get());
+
+  ok1(TestConcurrent());
+
+  return exit_status();
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Task/TaskIndex.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+static constexpr TaskIndex::Stamp stamp1{1700000000, 1234};
+static constexpr TaskIndex::Stamp stamp2{1700000100, 1234};
+
+static void
+TestLookup()
+{
+  TaskIndex index;
+  ok1(index.Find(Path("a.tsk"), stamp1) == nullptr);
+
+  index.Put(Path("a.tsk"), stamp1, {""});
+  ok1(index.IsModified());
+
+  const auto *tasks = index.Find(Path("a.tsk"), stamp1);
+  ok1(tasks != nullptr && tasks->size() == 1);
+
+  /* the file was modified */
+  ok1(index.Find(Path("a.tsk"), stamp2) == nullptr);
+
+  index.PutSummary(Path("a.tsk"), 0,
+                   {TaskFactoryType::RACING, 300000, {"Start", "Finish"}});
+  const auto *summary = index.GetSummary(Path("a.tsk"), 0);
+  ok1(summary != nullptr && summary->type == TaskFactoryType::RACING);
+
+  /* replacing the file discards the summary */
+  index.Put(Path("a.tsk"), stamp2, {"x", "y"});
+  ok1(index.GetSummary(Path("a.tsk"), 0) == nullptr);
+  ok1(index.Find(Path("a.tsk"), stamp2)->size() == 2);
+}
+
+static void
+TestSaveLoad()
+{
+  const Path path("output/test/task_index");
+
+  TaskIndex index;
+  index.Put(Path("a.tsk"), stamp1, {""});
+  index.PutSummary(Path("a.tsk"), 0,
+                   {TaskFactoryType::AAT, 123456,
+                    {"Start", "Name\twith tab", "Finish"}});
+  index.Put(Path("b.cup"), stamp2, {"Task 1", "Task 2", "Task 3"});
+  index.PutSummary(Path("b.cup"), 2,
+                   {TaskFactoryType::FAI_TRIANGLE, 0, {}});
+  index.Save(path);
+  ok1(!index.IsModified());
+
+  TaskIndex loaded;
+  loaded.Load(path);
+  ok1(loaded.size() == 2);
+
+  const auto *a = loaded.Find(Path("a.tsk"), stamp1);
+  ok1(a != nullptr && a->size() == 1 && a->front().name.empty());
+
+  const auto *summary = loaded.GetSummary(Path("a.tsk"), 0);
+  ok1(summary != nullptr &&
+      summary->type == TaskFactoryType::AAT &&
+      summary->distance == 123456 &&
+      summary->turnpoints.size() == 3 &&
+      summary->turnpoints[1] == "Name with tab");
+
+  const auto *b = loaded.Find(Path("b.cup"), stamp2);
+  ok1(b != nullptr && b->size() == 3 && (*b)[1].name == "Task 2");
+  ok1(loaded.GetSummary(Path("b.cup"), 0) == nullptr);
+
+  summary = loaded.GetSummary(Path("b.cup"), 2);
+  ok1(summary != nullptr && summary->turnpoints.empty());
+
+  /* "a.tsk" was looked up, "c.tsk" was added; "b.cup" was not seen
+     and gets removed */
+  loaded.Prune();
+  ok1(loaded.Find(Path("a.tsk"), stamp1) != nullptr);
+  loaded.Put(Path("c.tsk"), stamp1, {""});
+  loaded.Prune();
+  ok1(loaded.size() == 2);
+  ok1(loaded.Find(Path("b.cup"), stamp2) == nullptr);
+  ok1(loaded.IsModified());
+}
+
+static void
+TestMalformed()
+{
+  TaskIndex index;
+  index.Load(Path("output/test/does_not_exist"));
+  ok1(index.size() == 0);
+
+  index.Load(Path("test/data/01lz1hq1.igc"));
+  ok1(index.size() == 0);
+}
+
+int main()
+{
+  plan_tests(7 + 11 + 2);
+
+  TestLookup();
+  TestSaveLoad();
+  TestMalformed();
+
+  return exit_status();
+}
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Computer/ThermalMap/ThermalMap.hpp"
+#include "Geo/GeoVector.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static constexpr GeoPoint
+MakeGeoPoint(double longitude, double latitude) noexcept
+{
+  return {Angle::Degrees(longitude), Angle::Degrees(latitude)};
+}
+
+static unsigned
+Count(const ThermalMap &map, const GeoPoint &location, double range,
+      const ThermalMap::Filter &filter={})
+{
+  unsigned n = 0;
+  map.VisitWithinRange(location, range, filter,
+                       [&n](const ThermalMapRecord &){ ++n; });
+  return n;
+}
+
+/**
+ * Compare the indexed query with a brute force scan over a ring of
+ * climbs around the given location.
+ */
+static void
+TestRing(const GeoPoint &center)
+{
+  ThermalMap map;
+
+  for (unsigned i = 0; i < 36; ++i)
+    for (unsigned distance = 1000; distance <= 40000; distance += 3000)
+      map.Add(GeoVector(distance, Angle::Degrees(i * 10)).EndPoint(center),
+              hours{12}, 1500, SpeedVector::Zero(), 1.5);
+
+  ok1(map.size() == 36 * 14);
+
+  /* the ring with the radius 19000 m is the 7th ring */
+  ok1(Count(map, center, 19500) == 36 * 7);
+  ok1(Count(map, center, 40500) == 36 * 14);
+  ok1(Count(map, center, 500) == 0);
+}
+
+static void
+TestFilter()
+{
+  ThermalMap map;
+  const GeoPoint location = MakeGeoPoint(7.7, 51.05);
+
+  map.Add(location, hours{11}, 1500, SpeedVector::Zero(), 1.5);
+  map.Add(location, hours{14}, 1800,
+          SpeedVector(Angle::Degrees(270), 10), 2.5);
+  map.Add(location, minutes{23 * 60 + 50}, 1000, SpeedVector::Zero(), 0.5);
+
+  const ThermalMapRecord *record = nullptr;
+  map.VisitWithinRange(location, 100, {}, [&](const ThermalMapRecord &r){
+    if (ThermalMap::GetTimeOfDay(r) == hours{14})
+      record = &r;
+  });
+
+  ok1(record != nullptr);
+  if (record != nullptr) {
+    ok1(equals(ThermalMap::GetLift(*record), 2.5));
+    ok1(uint16_t(record->top_altitude) == 1800);
+    ok1(equals(ThermalMap::GetWind(*record).norm, 10));
+    ok1(equals(ThermalMap::GetWind(*record).bearing, Angle::Degrees(270)));
+    ok1(ThermalMap::GetLocation(*record).Distance(location) < 1);
+  } else
+    skip(5, 0, "not found");
+
+  ThermalMap::Filter filter;
+  filter.time_of_day = hours{12};
+  filter.time_window = hours{1};
+  ok1(Count(map, location, 100, filter) == 1);
+
+  /* wrap around midnight */
+  filter.time_of_day = minutes{10};
+  filter.time_window = minutes{30};
+  ok1(Count(map, location, 100, filter) == 1);
+
+  filter.time_window = minutes{-1};
+  filter.wind = SpeedVector(Angle::Degrees(260), 9);
+  filter.max_wind_difference = 3;
+  ok1(Count(map, location, 100, filter) == 1);
+}
+
+static void
+TestSaveLoad()
+{
+  const Path path("output/test/thermals.tmap");
+
+  ThermalMap map;
+  map.Add(MakeGeoPoint(7.7, 51.05), hours{12}, 1500, SpeedVector::Zero(), 1.5);
+  map.Add(MakeGeoPoint(-120.3, 36.2), hours{13}, 2500, SpeedVector::Zero(), 3);
+  map.Save(path);
+
+  ThermalMap loaded;
+  loaded.Load(path);
+  ok1(loaded.size() == 2);
+
+  loaded.Add(MakeGeoPoint(7.71, 51.05), hours{14}, 1500,
+             SpeedVector::Zero(), 1.5);
+  ok1(Count(loaded, MakeGeoPoint(7.7, 51.05), 5000) == 2);
+  ok1(Count(loaded, MakeGeoPoint(-120.3, 36.2), 5000) == 1);
+
+  /* merge the added record into the file */
+  loaded.Save(path);
+  map.Load(path);
+  ok1(map.size() == 3);
+  ok1(Count(map, MakeGeoPoint(7.7, 51.05), 5000) == 2);
+}
+
+static void
+TestCellLimit()
+{
+  const Path path("output/test/thermals.tmap");
+  const GeoPoint location = MakeGeoPoint(7.7, 51.05);
+
+  ThermalMap map;
+  for (unsigned i = 0; i < ThermalMap::MAX_RECORDS_PER_CELL + 8; ++i)
+    map.Add(location, minutes{i}, 1500, SpeedVector::Zero(), 1.5);
+  map.Add(MakeGeoPoint(8.7, 51.05), hours{12}, 1500, SpeedVector::Zero(), 1.5);
+  map.Save(path);
+
+  ThermalMap loaded;
+  loaded.Load(path);
+  ok1(loaded.size() == ThermalMap::MAX_RECORDS_PER_CELL + 1);
+
+  /* the oldest records have been dropped */
+  bool oldest_found = false;
+  loaded.VisitWithinRange(location, 100, {}, [&](const ThermalMapRecord &r){
+    if (ThermalMap::GetTimeOfDay(r) < minutes{8})
+      oldest_found = true;
+  });
+  ok1(!oldest_found);
+}
+
+int main()
+{
+  plan_tests(4 * 4 + 9 + 5 + 2);
+
+  TestRing(MakeGeoPoint(7.7, 51.05));
+  TestRing(MakeGeoPoint(179.9, -45));
+  TestRing(MakeGeoPoint(-179.9, 12));
+  TestRing(MakeGeoPoint(18.9, 69.6));
+
+  TestFilter();
+  TestSaveLoad();
+  TestCellLimit();
+
+  return exit_status();
+}
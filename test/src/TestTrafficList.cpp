@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned n) noexcept
+{
+  char buffer[16];
+  sprintf(buffer, "%X", 0xDD0000 + n * 7);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static constexpr TimeStamp
+MakeTime(double seconds) noexcept
+{
+  return TimeStamp{FloatDuration{seconds}};
+}
+
+static FlarmTraffic &
+Add(TrafficList &list, unsigned n, TimeStamp time) noexcept
+{
+  FlarmTraffic &traffic = *list.AllocateTraffic(MakeId(n));
+  traffic.valid.Update(time);
+  traffic.alarm_level = FlarmTraffic::AlarmType::NONE;
+  traffic.distance = 5000. + (n * 37) % 1000 * 10.;
+  return traffic;
+}
+
+static bool
+AllFound(const TrafficList &list, unsigned begin, unsigned end,
+         unsigned step = 1) noexcept
+{
+  for (unsigned n = begin; n < end; n += step) {
+    const FlarmTraffic *traffic = list.FindTraffic(MakeId(n));
+    if (traffic == nullptr || traffic->id != MakeId(n))
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestLookup()
+{
+  TrafficList list;
+  list.Clear();
+  ok1(list.FindTraffic(MakeId(0)) == nullptr);
+
+  for (unsigned n = 0; n < TrafficList::MAX_COUNT; ++n)
+    Add(list, n, MakeTime(10));
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(AllFound(list, 0, TrafficList::MAX_COUNT));
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+  ok1(list.AllocateTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+
+  /* let every other target expire; quick_remove() reorders the
+     list, so this checks that the index gets rebuilt */
+  for (unsigned n = 0; n < TrafficList::MAX_COUNT; n += 2)
+    list.FindTraffic(MakeId(n))->valid.Update(MakeTime(12));
+
+  list.Expire(MakeTime(13));
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+  ok1(AllFound(list, 0, TrafficList::MAX_COUNT, 2));
+
+  bool none_found = true;
+  for (unsigned n = 1; n < TrafficList::MAX_COUNT; n += 2)
+    if (list.FindTraffic(MakeId(n)) != nullptr)
+      none_found = false;
+  ok1(none_found);
+
+  /* the freed slots can be reused */
+  for (unsigned n = 1; n < TrafficList::MAX_COUNT; n += 2)
+    Add(list, n, MakeTime(13));
+  ok1(AllFound(list, 0, TrafficList::MAX_COUNT));
+}
+
+static void
+TestComplement()
+{
+  TrafficList a, b, merged;
+  a.Clear();
+  b.Clear();
+  merged.Clear();
+
+  for (unsigned n = 0; n < 30; ++n)
+    Add(a, n, MakeTime(1));
+
+  for (unsigned n = 15; n < 45; ++n)
+    Add(b, n, MakeTime(1));
+
+  merged.Complement(a);
+  ok1(AllFound(merged, 0, 30));
+
+  merged.Complement(b);
+  ok1(merged.GetActiveTrafficCount() == 45);
+  ok1(AllFound(merged, 0, 45));
+}
+
+static void
+TestUninitialised()
+{
+  /* a zero-initialised table is empty */
+  TrafficList list{};
+  ok1(list.FindTraffic(MakeId(0)) == nullptr);
+
+  Add(list, 0, MakeTime(1));
+  ok1(AllFound(list, 0, 1));
+
+  /* a lookup in a table without empty slots terminates */
+  list.Clear();
+  std::fill_n(list.id_table, TrafficList::ID_TABLE_SIZE, 1);
+  ok1(list.FindTraffic(MakeId(0)) == nullptr);
+}
+
+static const FlarmTraffic *
+BruteForceMaximumAlert(const TrafficList &list) noexcept
+{
+  const FlarmTraffic *alert = nullptr;
+  for (const auto &traffic : list.list)
+    if (traffic.HasAlarm() &&
+        (alert == nullptr ||
+         traffic.alarm_level > alert->alarm_level ||
+         (traffic.alarm_level == alert->alarm_level &&
+          traffic.distance < alert->distance)))
+      alert = &traffic;
+  return alert;
+}
+
+static void
+TestRank()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned n = 0; n < 40; ++n) {
+    auto &traffic = Add(list, n, MakeTime(1));
+    if (n % 9 == 0)
+      traffic.alarm_level = FlarmTraffic::AlarmType::LOW;
+    else if (n % 23 == 0)
+      traffic.alarm_level = FlarmTraffic::AlarmType::IMPORTANT;
+  }
+
+  const FlarmTraffic *expected = BruteForceMaximumAlert(list);
+  ok1(expected != nullptr);
+  ok1(list.FindMaximumAlert() == expected);
+  ok1(!list.InCloseRange());
+
+  list.Rank();
+  ok1(list.FindMaximumAlert() == expected);
+  ok1(!list.InCloseRange());
+
+  RoughDistance previous = 0.;
+  unsigned count = 0;
+  bool sorted = true;
+  list.ForEachByDistance([&](const FlarmTraffic &traffic){
+    if (traffic.distance < previous)
+      sorted = false;
+    previous = traffic.distance;
+    ++count;
+  });
+  ok1(sorted);
+  ok1(count == 40);
+
+  /* structural modifications invalidate the ranking */
+  Add(list, 40, MakeTime(1)).distance = 50.;
+  ok1(list.InCloseRange());
+
+  list.Rank();
+  ok1(list.InCloseRange());
+  ok1(&list.list[list.by_distance[0]] == list.FindTraffic(MakeId(40)));
+
+  list.Clear();
+  list.Rank();
+  ok1(list.FindMaximumAlert() == nullptr);
+  ok1(!list.InCloseRange());
+}
+
+int main()
+{
+  plan_tests(9 + 3 + 3 + 12);
+
+  TestLookup();
+  TestComplement();
+  TestUninitialised();
+  TestRank();
+
+  return exit_status();
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Renderer/TrailCache.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+static unsigned n_added = 0;
+
+/**
+ * Append a point of a flight which alternates between circling and
+ * straight glides.
+ */
+static void
+AddPoint(Trace &trace)
+{
+  static GeoPoint location(Angle::Degrees(7.7), Angle::Degrees(51.05));
+  static Angle bearing = Angle::Zero();
+
+  const unsigned i = n_added++;
+  const bool circling = (i / 40) % 2 == 0;
+  if (circling)
+    bearing = (bearing + Angle::Degrees(20)).AsBearing();
+
+  location = GeoVector(circling ? 60 : 100, bearing).EndPoint(location);
+
+  trace.push_back(TracePoint(location, std::chrono::seconds{4 * i + 100},
+                             1000. + i, circling ? 2. : -1., 0));
+}
+
+static std::vector<uint32_t>
+GetLevel(const TrailCache &cache, unsigned level, std::size_t first = 0)
+{
+  std::vector<uint32_t> result;
+  cache.ForEach(level, first, [&result](uint32_t i){
+    result.push_back(i);
+  });
+  return result;
+}
+
+static double
+SquareSegmentDistance(const FlatPoint p, const FlatPoint a, const FlatPoint b)
+{
+  const double dx = b.x - a.x, dy = b.y - a.y;
+  double px = p.x - a.x, py = p.y - a.y;
+
+  const double length2 = dx * dx + dy * dy;
+  if (length2 > 0) {
+    const double t = std::clamp((px * dx + py * dy) / length2, 0., 1.);
+    px -= t * dx;
+    py -= t * dy;
+  }
+
+  return px * px + py * py;
+}
+
+/**
+ * Check that each level is a subset of the points in chronological
+ * order, which deviates from the trace by no more than its
+ * tolerance.
+ */
+static bool
+CheckLevels(const TrailCache &cache)
+{
+  const auto &points = cache.GetFlatPoints();
+  std::size_t previous_size = points.size() + 1;
+
+  for (unsigned level = 0; level < TrailCache::N_LEVELS; ++level) {
+    const auto indices = GetLevel(cache, level);
+    if (indices.empty() || indices.front() != 0 ||
+        indices.back() != points.size() - 1 ||
+        indices.size() > previous_size)
+      return false;
+
+    previous_size = indices.size();
+
+    const double tolerance = TrailCache::GetTolerance(level);
+    for (std::size_t j = 1; j < indices.size(); ++j) {
+      if (indices[j] <= indices[j - 1])
+        return false;
+
+      const auto a = points[indices[j - 1]];
+      const auto b = points[indices[j]];
+      for (uint32_t i = indices[j - 1] + 1; i < indices[j]; ++i)
+        if (SquareSegmentDistance(points[i], a, b) >
+            tolerance * tolerance)
+          return false;
+    }
+  }
+
+  return true;
+}
+
+static bool
+Equals(const TrailCache &a, const TrailCache &b)
+{
+  if (a.GetPoints().size() != b.GetPoints().size())
+    return false;
+
+  for (unsigned level = 0; level < TrailCache::N_LEVELS; ++level)
+    if (GetLevel(a, level) != GetLevel(b, level))
+      return false;
+
+  return true;
+}
+
+int main()
+{
+  plan_tests(16);
+
+  Trace trace;
+  TrailCache cache;
+
+  cache.Sync(trace);
+  ok1(cache.empty());
+
+  for (unsigned i = 0; i < 300; ++i)
+    AddPoint(trace);
+
+  ok1(cache.Sync(trace));
+  ok1(!cache.Sync(trace));
+  ok1(cache.GetPoints().size() == 300);
+  ok1(CheckLevels(cache));
+
+  /* straight glides collapse even on the finest level, circles only
+     on the coarse levels */
+  printf("# level sizes:");
+  for (unsigned level = 0; level < TrailCache::N_LEVELS; ++level)
+    printf(" %zu", GetLevel(cache, level).size());
+  printf("\n");
+  ok1(GetLevel(cache, 0).size() < 200);
+  ok1(GetLevel(cache, TrailCache::N_LEVELS - 1).size() < 10);
+
+  /* incremental updates give the same result as a rebuild */
+  for (unsigned i = 0; i < 300; ++i) {
+    AddPoint(trace);
+    cache.Sync(trace);
+  }
+
+  TrailCache rebuilt;
+  rebuilt.Sync(trace);
+  ok1(cache.GetPoints().size() == 600);
+  ok1(Equals(cache, rebuilt));
+  ok1(CheckLevels(cache));
+
+  /* time filter */
+  const std::size_t first = cache.FindTime(std::chrono::seconds{4 * 500 + 100});
+  ok1(first == 500);
+  const auto recent = GetLevel(cache, 3, first);
+  ok1(!recent.empty() && recent.front() >= 500 &&
+      recent.back() == 599);
+
+  /* level selection */
+  ok1(cache.FindLevel(0) == 0);
+  ok1(cache.FindLevel(1e9) == TrailCache::N_LEVELS - 1);
+
+  /* thinning invalidates the cache */
+  Trace small({}, Trace::null_time, 128);
+  for (unsigned i = 0; i < 400; ++i)
+    AddPoint(small);
+
+  TrailCache thinned;
+  for (unsigned i = 0; i < 100; ++i) {
+    AddPoint(small);
+    thinned.Sync(small);
+  }
+
+  ok1(thinned.GetPoints().size() == small.size() && CheckLevels(thinned));
+
+  trace.clear();
+  cache.Sync(trace);
+  ok1(cache.empty());
+
+  return exit_status();
+}
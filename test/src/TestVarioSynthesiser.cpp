@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+static constexpr unsigned SAMPLE_RATE = 44100;
+
+/**
+ * Count the rising zero crossings of the given PCM buffer.
+ */
+static unsigned
+CountCycles(const int16_t *buffer, size_t n)
+{
+  unsigned cycles = 0;
+  for (size_t i = 1; i < n; ++i)
+    if (buffer[i - 1] < 0 && buffer[i] >= 0)
+      ++cycles;
+  return cycles;
+}
+
+static bool
+IsSilent(const int16_t *buffer, size_t n)
+{
+  return std::all_of(buffer, buffer + n, [](int16_t i){ return i == 0; });
+}
+
+/**
+ * Count the sample values which are far from zero.
+ */
+static size_t
+CountLoud(const int16_t *buffer, size_t n)
+{
+  return std::count_if(buffer, buffer + n,
+                       [](int16_t i){ return std::abs(i) > 1000; });
+}
+
+static void
+TestSilence()
+{
+  VarioSynthesiser synthesiser(SAMPLE_RATE);
+
+  int16_t buffer[1024];
+  std::fill_n(buffer, 1024, 1);
+  synthesiser.Synthesise(buffer, 1024);
+  ok1(IsSilent(buffer, 1024));
+}
+
+static void
+TestSinking()
+{
+  VarioSynthesiser synthesiser(SAMPLE_RATE);
+  synthesiser.SetFrequencies(200, 500, 1500);
+  synthesiser.SetVario(0);
+
+  /* one second of a continuous 500 Hz tone */
+  static int16_t buffer[SAMPLE_RATE];
+  synthesiser.Synthesise(buffer, SAMPLE_RATE);
+  const unsigned cycles = CountCycles(buffer, SAMPLE_RATE);
+  ok1(cycles >= 499 && cycles <= 501);
+  ok1(CountLoud(buffer, SAMPLE_RATE) > SAMPLE_RATE / 2);
+
+  /* the new frequency is applied at the next buffer */
+  synthesiser.SetVario(-5);
+  synthesiser.Synthesise(buffer, SAMPLE_RATE);
+  const unsigned low_cycles = CountCycles(buffer, SAMPLE_RATE);
+  ok1(low_cycles < cycles);
+  ok1(low_cycles >= 195 && low_cycles <= 205);
+}
+
+static void
+TestClimbing()
+{
+  VarioSynthesiser synthesiser(SAMPLE_RATE);
+  synthesiser.SetVario(2);
+
+  static int16_t buffer[SAMPLE_RATE];
+  synthesiser.Synthesise(buffer, SAMPLE_RATE);
+
+  /* roughly one third of each period is silent */
+  const size_t loud = CountLoud(buffer, SAMPLE_RATE);
+  ok1(loud > SAMPLE_RATE / 3);
+  ok1(loud < SAMPLE_RATE * 3 / 4);
+
+  size_t longest_silence = 0, silence = 0;
+  for (unsigned i = 0; i < SAMPLE_RATE; ++i) {
+    if (buffer[i] == 0) {
+      ++silence;
+      longest_silence = std::max(longest_silence, silence);
+    } else
+      silence = 0;
+  }
+
+  ok1(longest_silence > SAMPLE_RATE / 100);
+}
+
+static void
+TestSetSilence()
+{
+  VarioSynthesiser synthesiser(SAMPLE_RATE);
+  synthesiser.SetVario(-1);
+
+  int16_t buffer[4096];
+  synthesiser.Synthesise(buffer, 4096);
+  ok1(!IsSilent(buffer, 4096));
+
+  /* the current sine wave is finished, then it becomes silent */
+  synthesiser.SetSilence();
+  synthesiser.Synthesise(buffer, 4096);
+  ok1(IsSilent(buffer + 1024, 4096 - 1024));
+}
+
+int
+main()
+{
+  plan_tests(10);
+
+  TestSilence();
+  TestSinking();
+  TestClimbing();
+  TestSetSilence();
+
+  return exit_status();
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/NameIndex.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <vector>
+
+static WaypointPtr
+Add(Waypoints &waypoints, const char *name, const char *shortname = "")
+{
+  Waypoint waypoint{GeoPoint(Angle::Degrees(7), Angle::Degrees(51))};
+  waypoint.name = name;
+  waypoint.shortname = shortname;
+  return waypoints.Append(std::move(waypoint));
+}
+
+static std::vector<std::string>
+Search(WaypointNameSearch &search, const char *query)
+{
+  std::vector<std::string> result;
+  for (const auto &match : search.Update(query))
+    result.emplace_back(match.waypoint->name);
+  return result;
+}
+
+static std::vector<std::string>
+Search(const Waypoints &waypoints, const char *query)
+{
+  WaypointNameSearch search(waypoints.GetNameIndex());
+  return Search(search, query);
+}
+
+using Names = std::vector<std::string>;
+
+int main()
+{
+  plan_tests(18);
+
+  Waypoints waypoints;
+  Add(waypoints, "Aachen Merzbrueck", "EDKA");
+  Add(waypoints, "Achmer");
+  Add(waypoints, "Bad Sobernheim");
+  Add(waypoints, "Sobernheim Domberg");
+  Add(waypoints, "Marl Loemuehle");
+  const auto unterwoessen = Add(waypoints, "Unterwoessen");
+  waypoints.Optimise();
+
+  /* prefix matches rank before substring matches */
+  ok1((Search(waypoints, "ach") == Names{"Achmer", "Aachen Merzbrueck"}));
+  ok1((Search(waypoints, "Sobern") ==
+       Names{"Sobernheim Domberg", "Bad Sobernheim"}));
+
+  /* whitespace and case are ignored */
+  ok1((Search(waypoints, "bad sob") == Names{"Bad Sobernheim"}));
+
+  /* short names */
+  ok1((Search(waypoints, "edka") == Names{"Aachen Merzbrueck"}));
+
+  /* short queries must match exactly */
+  ok1(Search(waypoints, "xyz").empty());
+  ok1(Search(waypoints, "").empty());
+
+  /* typos: transposed letters are two edits, allowed from 8
+     characters */
+  ok1((Search(waypoints, "Sobernhiem") ==
+       Names{"Bad Sobernheim", "Sobernheim Domberg"}));
+  ok1((Search(waypoints, "Loemuhle") == Names{"Marl Loemuehle"}));
+  ok1((Search(waypoints, "Unterwosen") == Names{"Unterwoessen"}));
+  ok1(Search(waypoints, "Unterxxxen").empty());
+
+  /* too few distinct bigrams for two errors */
+  ok1(Search(waypoints, "aaaaaaaa").empty());
+
+  /* narrowing down while typing gives the same result as a new
+     search */
+  WaypointNameSearch search(waypoints.GetNameIndex());
+  ok1(Search(search, "a").size() == 4);
+  ok1((Search(search, "ac") == Names{"Achmer", "Aachen Merzbrueck"}));
+  ok1((Search(search, "ach") == Names{"Achmer", "Aachen Merzbrueck"}));
+  ok1((Search(search, "achm") == Names{"Achmer", "Aachen Merzbrueck"}));
+
+  /* modifications invalidate the cached matches */
+  Add(waypoints, "Achern");
+  waypoints.Erase(WaypointPtr{unterwoessen});
+  waypoints.Optimise();
+  ok1((Search(search, "achm") ==
+       Names{"Achmer", "Achern", "Aachen Merzbrueck"}));
+  ok1((Search(search, "ache") ==
+       Names{"Achern", "Aachen Merzbrueck", "Achmer"}));
+  ok1(Search(search, "Unterwoessen").empty());
+
+  return exit_status();
+}
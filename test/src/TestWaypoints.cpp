@@ -5,7 +5,9 @@
 #include "Geo/GeoVector.hpp"
 #include "test_debug.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <stdio.h>
 extern "C" {
@@ -216,6 +218,36 @@ TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
   ok1(waypoint->original_id == 6);
 }
 
+static bool
+IsLandable(const Waypoint &waypoint)
+{
+  return waypoint.IsLandable();
+}
+
+static void
+TestVisitNearest(const Waypoints &waypoints, const GeoPoint &center)
+{
+  std::vector<unsigned> ids;
+  const auto collect = [&ids](unsigned limit){
+    return [&ids, limit](const WaypointPtr &wp){
+      ids.push_back(wp->original_id);
+      return ids.size() < limit;
+    };
+  };
+
+  waypoints.VisitNearest(center, 1000000, collect(10));
+  ok1((ids == std::vector<unsigned>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  ids.clear();
+  waypoints.VisitNearest(center, 1000000, IsLandable, collect(6));
+  ok1((ids == std::vector<unsigned>{0, 3, 6, 7, 9, 12}));
+
+  ids.clear();
+  waypoints.VisitNearest(center, 10500, collect(1000));
+  ok1(ids.size() == 11);
+  ok1(std::is_sorted(ids.begin(), ids.end()));
+}
+
 static void
 TestIterator(const Waypoints &waypoints)
 {
@@ -283,7 +315,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(56);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -299,6 +331,7 @@ main(int argc, char** argv)
   TestNamePrefixVisitor(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestVisitNearest(waypoints, center);
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "XML/PullParser.hpp"
+#include "XML/Document.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using Event = XML::PullParser::Event;
+
+static void
+TestPullParser()
+{
+  XML::PullParser parser{
+    "<?xml version=\"1.0\"?>\n"
+    "<!-- a <comment> -->\n"
+    "<Task type='AAT' x = 1>\n"
+    "  <Point/>\n"
+    "  <Name>  Foo &amp; Bar </Name>\n"
+    "  <Code><![CDATA[ <a> & b>c ]]></Code>\n"
+    "</task>\n"
+  };
+
+  ok1(parser.Next() == Event::START_ELEMENT &&
+      parser.GetName() == "Task" && parser.GetDepth() == 1);
+
+  const auto attributes = parser.GetAttributes();
+  ok1(attributes.size() == 2 &&
+      attributes[0].name == "type" && attributes[0].value == "AAT" &&
+      attributes[1].name == "x" && attributes[1].value == "1");
+
+  ok1(parser.Next() == Event::START_ELEMENT && parser.GetName() == "Point" &&
+      parser.GetAttributes().empty());
+  ok1(parser.Next() == Event::END_ELEMENT && parser.GetName() == "Point");
+
+  ok1(parser.Next() == Event::START_ELEMENT && parser.GetName() == "Name");
+  ok1(parser.Next() == Event::TEXT && parser.GetText() == "Foo &amp; Bar");
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  /* CDATA sections end at "]]>", not at the first '>' */
+  ok1(parser.Next() == Event::START_ELEMENT && parser.GetName() == "Code");
+  ok1(parser.Next() == Event::CDATA && parser.GetText() == " <a> & b>c ");
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  /* end tags are case insensitive */
+  ok1(parser.Next() == Event::END_ELEMENT && parser.GetDepth() == 0);
+  ok1(parser.Next() == Event::END);
+}
+
+static bool
+IsMalformed(const char *xml)
+{
+  try {
+    XML::PullParser parser{xml};
+    while (parser.Next() != Event::END) {}
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+static std::string
+Decode(std::string_view src)
+{
+  std::string result(src);
+  result.resize(XML::DecodeEntities(src, result.data()));
+  return result;
+}
+
+static void
+TestDecodeEntities()
+{
+  ok1(Decode("a &lt;b&gt; &quot;c&quot; &apos;d&apos;") == "a <b> \"c\" 'd'");
+  ok1(Decode("&#65;&#x42;&#xe9;") == "AB\xc3\xa9");
+  ok1(Decode("&AMP; &Lt;") == "& <");
+
+  bool thrown = false;
+  try {
+    Decode("&foo;");
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  ok1(thrown);
+}
+
+static void
+TestDocument()
+{
+  const auto document = XML::Document::Parse(
+    "<Task type=\"RT\" name=\"A &amp; B\">"
+    "<Point type=\"Start\"><Waypoint id=\"1\"/></Point>"
+    "text"
+    "<Point type=\"Finish\"><Waypoint id=\"2\"/></Point>"
+    " more text "
+    "<![CDATA[&amp;]]>"
+    "<Empty flag/>"
+    "</Task>");
+
+  const auto &root = document.GetRoot();
+  ok1(StringIsEqual(root.GetName(), "Task"));
+  ok1(StringIsEqual(root.GetAttribute("NAME"), "A & B"));
+  ok1(root.GetAttribute("foo") == nullptr);
+
+  /* all text nodes are concatenated */
+  ok1(StringIsEqual(root.GetText(), "textmore text&amp;"));
+
+  const auto children = root.GetChildren();
+  ok1(children.size() == 3);
+
+  /* the children are stored in one array */
+  ok1(&children[1] == &children[0] + 1);
+
+  ok1(StringIsEqual(children[1].GetAttribute("type"), "Finish"));
+
+  const auto *waypoint = children[1].GetChildNode("waypoint");
+  ok1(waypoint != nullptr && StringIsEqual(waypoint->GetAttribute("id"), "2"));
+  ok1(*waypoint->GetText() == '\0');
+
+  const auto *empty = root.GetChildNode("Empty");
+  ok1(empty != nullptr && StringIsEqual(empty->GetAttribute("flag"), ""));
+
+  bool thrown = false;
+  try {
+    XML::Document::Parse("<!-- nothing -->");
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  ok1(thrown);
+}
+
+int main()
+{
+  plan_tests(12 + 6 + 4 + 11);
+
+  TestPullParser();
+
+  ok1(IsMalformed("<a><b></a>"));
+  ok1(IsMalformed("<a>"));
+  ok1(IsMalformed("<a b=\"c></a>"));
+  ok1(!IsMalformed("<a b=c/>"));
+  ok1(IsMalformed("</a>"));
+  ok1(IsMalformed("<a><![CDATA[x></a>"));
+
+  TestDecodeEntities();
+  TestDocument();
+
+  return exit_status();
+}